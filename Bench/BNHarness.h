@@ -0,0 +1,249 @@
+#ifndef BN_HARNESS_H
+#define BN_HARNESS_H
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+/* Count every heap allocation made by the process, this lets a bench case report how many allocations it performed per
+ * iteration
+*/
+namespace Bench {
+    std::atomic <uint64_t> g_allocationCount {0};
+}   // namespace Bench
+
+void* operator new (size_t size) {
+    Bench::g_allocationCount.fetch_add (1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc (size == 0 ? 1: size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+/* The deletes are kept out of line, once inlined gcc sees free being called on a pointer returned by operator new and
+ * warns about a mismatched allocation (-Wmismatched-new-delete)
+*/
+[[gnu::noinline]] void operator delete (void* ptr) noexcept {
+    std::free (ptr);
+}
+
+[[gnu::noinline]] void operator delete (void* ptr, size_t) noexcept {
+    std::free (ptr);
+}
+
+/* Over aligned types (alignas greater than that of malloc) are allocated through the align_val_t overloads, they are
+ * counted as well and freed with the matching deletes. The array forms fall back to these
+*/
+void* operator new (size_t size, std::align_val_t alignment) {
+    Bench::g_allocationCount.fetch_add (1, std::memory_order_relaxed);
+    size_t align = static_cast <size_t> (alignment);
+    /* The size passed to aligned_alloc needs to be a multiple of the alignment
+    */
+    size_t alignedSize = ((size == 0 ? 1: size) + align - 1) & ~(align - 1);
+    if (void* ptr = std::aligned_alloc (align, alignedSize))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete (void* ptr, std::align_val_t) noexcept {
+    std::free (ptr);
+}
+
+[[gnu::noinline]] void operator delete (void* ptr, size_t, std::align_val_t) noexcept {
+    std::free (ptr);
+}
+
+namespace Bench {
+    struct Result {
+        std::string group;
+        std::string name;
+        uint64_t iterations;
+        double seconds;
+        uint64_t allocations;
+        /* Optional, set by the bench case when it produces output (file size for example)
+        */
+        uint64_t bytes;
+        /* Percentiles of the time per iteration in ns, see runCase
+        */
+        double p50;
+        double p90;
+        double p99;
+    };
+
+    class BNHarness {
+        private:
+            std::vector <Result> m_results;
+
+            /* Iterations are timed in batches rather than one by one, so that the clock reads do not dominate cheap
+             * bodies. Each batch contributes one sample (its time per iteration) to the percentiles, which means that
+             * for cases with fewer iterations than the sample limit every iteration is a sample of its own
+            */
+            const uint64_t m_maxSamples = 1000;
+
+            static double getPercentile (std::vector <double>& samples, double percentile) {
+                if (samples.empty())
+                    return 0.0;
+
+                size_t idx = static_cast <size_t> (percentile * (samples.size() - 1) + 0.5);
+                std::nth_element (samples.begin(), samples.begin() + idx, samples.end());
+                return samples[idx];
+            }
+
+            static void setPercentiles (Result& result, std::vector <double>& samples) {
+                result.p50 = getPercentile (samples, 0.50);
+                result.p90 = getPercentile (samples, 0.90);
+                result.p99 = getPercentile (samples, 0.99);
+            }
+
+        public:
+            /* Run body for the given number of iterations and record the elapsed time and allocation count. The body
+             * is passed the iteration index so that it can vary its input
+            */
+            template <typename T>
+            Result& runCase (const char* group, const char* name, uint64_t iterations, T body) {
+                uint64_t batchSize        = std::max <uint64_t> (1, iterations / m_maxSamples);
+                std::vector <double> samples;
+                samples.reserve (iterations / batchSize + 1);
+
+                uint64_t allocationsBegin = g_allocationCount.load (std::memory_order_relaxed);
+                auto timeBegin            = std::chrono::steady_clock::now();
+                auto batchBegin           = timeBegin;
+
+                for (uint64_t i = 0; i < iterations; i++) {
+                    body (i);
+
+                    if ((i + 1) % batchSize == 0 || i + 1 == iterations) {
+                        auto batchEnd     = std::chrono::steady_clock::now();
+                        uint64_t count    = (i % batchSize) + 1;
+                        samples.push_back (std::chrono::duration <double, std::nano> (batchEnd - batchBegin).count() /
+                                           count);
+                        batchBegin        = batchEnd;
+                    }
+                }
+
+                auto timeEnd              = std::chrono::steady_clock::now();
+                uint64_t allocationsEnd   = g_allocationCount.load (std::memory_order_relaxed);
+
+                Result result;
+                result.group              = group;
+                result.name               = name;
+                result.iterations         = iterations;
+                result.seconds            = std::chrono::duration <double> (timeEnd - timeBegin).count();
+                result.allocations        = allocationsEnd - allocationsBegin;
+                result.bytes              = 0;
+                setPercentiles (result, samples);
+
+                m_results.push_back (result);
+                return m_results.back();
+            }
+
+            /* Run body on the given number of threads at once, each thread running its own iterations. The body is passed
+             * the thread index and the iteration index, and the result counts the iterations of all threads. Each thread
+             * contributes one sample (its own time per iteration) to the percentiles
+            */
+            template <typename T>
+            Result& runParallelCase (const char* group,
+                                     const char* name,
+                                     uint32_t threadCount,
+                                     uint64_t iterationsPerThread,
+                                     T body) {
+
+                std::vector <double> samples (threadCount, 0.0);
+                auto& result = runCase (group, name, 1, [&](uint64_t) {
+                    std::vector <std::thread> threads;
+                    for (uint32_t t = 0; t < threadCount; t++) {
+                        threads.emplace_back ([&, t]() {
+                            auto threadBegin = std::chrono::steady_clock::now();
+                            for (uint64_t i = 0; i < iterationsPerThread; i++)
+                                body (t, i);
+                            auto threadEnd   = std::chrono::steady_clock::now();
+                            samples[t]       = std::chrono::duration <double, std::nano> (threadEnd - threadBegin).count() /
+                                               iterationsPerThread;
+                        });
+                    }
+                    for (auto& thread: threads)
+                        thread.join();
+                });
+                result.iterations = threadCount * iterationsPerThread;
+                setPercentiles (result, samples);
+                return result;
+            }
+
+            void printResults (std::ostream& ost) {
+                ost << std::left
+                    << std::setw (16) << "group"
+                    << std::setw (32) << "case"
+                    << std::right
+                    << std::setw (16) << "ops/s"
+                    << std::setw (16) << "ns/op"
+                    << std::setw (16) << "allocs/op"
+                    << std::setw (16) << "bytes/op"
+                    << std::setw (16) << "p50 ns"
+                    << std::setw (16) << "p99 ns"
+                    << "\n";
+
+                for (auto const& result: m_results) {
+                    double opsPerSecond = result.iterations / result.seconds;
+                    double nsPerOp      = result.seconds * 1e9 / result.iterations;
+                    double allocsPerOp  = static_cast <double> (result.allocations) / result.iterations;
+                    double bytesPerOp   = static_cast <double> (result.bytes)       / result.iterations;
+
+                    ost << std::left
+                        << std::setw (16) << result.group
+                        << std::setw (32) << result.name
+                        << std::right << std::fixed
+                        << std::setw (16) << std::setprecision (0) << opsPerSecond
+                        << std::setw (16) << std::setprecision (1) << nsPerOp
+                        << std::setw (16) << std::setprecision (2) << allocsPerOp
+                        << std::setw (16) << std::setprecision (1) << bytesPerOp
+                        << std::setw (16) << std::setprecision (1) << result.p50
+                        << std::setw (16) << std::setprecision (1) << result.p99
+                        << "\n";
+                }
+            }
+
+            /* Machine readable copy of the results, one object per case. Group and case names are plain identifiers
+             * chosen by the bench cases, so they need no escaping
+            */
+            bool writeResultsJson (const char* filePath) {
+                std::ofstream file (filePath);
+                if (!file.is_open())
+                    return false;
+
+                file << std::fixed << "{\n    \"results\": [\n";
+                for (size_t i = 0; i < m_results.size(); i++) {
+                    auto const& result = m_results[i];
+                    double nsPerOp     = result.seconds * 1e9 / result.iterations;
+
+                    file << "        {"
+                         << "\"group\": \""          << result.group            << "\", "
+                         << "\"case\": \""           << result.name             << "\", "
+                         << "\"iterations\": "       << result.iterations       << ", "
+                         << std::setprecision (1)
+                         << "\"nsPerOp\": "          << nsPerOp                 << ", "
+                         << "\"opsPerSecond\": "     << 1e9 / nsPerOp           << ", "
+                         << std::setprecision (3)
+                         << "\"allocationsPerOp\": " << static_cast <double> (result.allocations) / result.iterations
+                                                                                  << ", "
+                         << "\"bytesPerOp\": "       << static_cast <double> (result.bytes)       / result.iterations
+                                                                                  << ", "
+                         << std::setprecision (1)
+                         << "\"p50Ns\": "            << result.p50              << ", "
+                         << "\"p90Ns\": "            << result.p90              << ", "
+                         << "\"p99Ns\": "            << result.p99
+                         << "}"
+                         << (i + 1 == m_results.size() ? "\n": ",\n");
+                }
+                file << "    ]\n}\n";
+                return true;
+            }
+    };
+}   // namespace Bench
+#endif  // BN_HARNESS_H
\ No newline at end of file
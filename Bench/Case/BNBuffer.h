@@ -0,0 +1,96 @@
+#ifndef BN_BUFFER_H
+#define BN_BUFFER_H
+
+#include "../BNHarness.h"
+#include "../../Collection/Buffer/Buffer.h"
+
+namespace Bench {
+    using namespace Collection;
+
+    /* Element shaped like a log entry or an event handed between threads, large enough that copies show up in the
+     * timings but still trivially copyable
+    */
+    struct BufferElement {
+        uint64_t timestamp;
+        uint32_t id;
+        uint32_t flags;
+        float values[4];
+    };
+
+    void runBufferCases (BNHarness& harness, uint64_t iterations) {
+        const size_t capacity  = 1024;
+        const size_t batchSize = 256;
+        std::vector <BufferElement> batch (batchSize);
+        uint64_t sink          = 0;
+        /* |--------------------------------------------------------------------------------------------------------|
+         * | BUFFER IMPL                                                                                            |
+         * |--------------------------------------------------------------------------------------------------------|
+        */
+        auto buffer = BUFFER_INIT (0, Buffer::WITH_OVERFLOW, BufferElement, capacity);
+        harness.runCase ("buffer", "push", iterations, [&](uint64_t i) {
+            buffer->BUFFER_PUSH ((BufferElement {i, 0, 0, {}}));
+        });
+        harness.runCase ("buffer", "push_pop_first", iterations, [&](uint64_t i) {
+            buffer->BUFFER_PUSH ((BufferElement {i, 0, 0, {}}));
+            sink += buffer->BUFFER_POP_FIRST->timestamp;
+        });
+        harness.runCase ("buffer", "push_n_pop_n_256", iterations / batchSize, [&](uint64_t) {
+            buffer->pushN (std::span <const BufferElement> (batch));
+            sink += buffer->popN (std::span <BufferElement> (batch));
+        });
+        BUFFER_CLOSE (0);
+
+        auto mirrored = BUFFER_INIT_MIRRORED (0, Buffer::WITH_OVERFLOW, BufferElement, capacity);
+        harness.runCase ("buffer", "push_n_pop_n_256_mirrored", iterations / batchSize, [&](uint64_t) {
+            mirrored->pushN (std::span <const BufferElement> (batch));
+            sink += mirrored->popN (std::span <BufferElement> (batch));
+        });
+        BUFFER_CLOSE (0);
+        /* |--------------------------------------------------------------------------------------------------------|
+         * | LOCK FREE                                                                                              |
+         * |--------------------------------------------------------------------------------------------------------|
+        */
+        auto spscBuffer = BUFFER_INIT (1, Buffer::SPSC_LOCK_FREE, BufferElement, capacity);
+        auto mpmcBuffer = BUFFER_INIT (2, Buffer::MPMC_LOCK_FREE, BufferElement, capacity);
+        BufferElement element {};
+
+        harness.runCase ("buffer", "spsc_push_pop_first", iterations, [&](uint64_t i) {
+            spscBuffer->BUFFER_PUSH ((BufferElement {i, 0, 0, {}}));
+            spscBuffer->tryPop (element);
+            sink += element.timestamp;
+        });
+        harness.runCase ("buffer", "mpmc_push_pop_first", iterations, [&](uint64_t i) {
+            mpmcBuffer->BUFFER_PUSH ((BufferElement {i, 0, 0, {}}));
+            mpmcBuffer->tryPop (element);
+            sink += element.timestamp;
+        });
+        /* Hand off between threads, the first half of the threads push and the second half pop, so an op is either a
+         * push or a pop. A thread that finds the buffer full (or empty) yields, so that the cases complete on machines
+         * with fewer cores than threads
+        */
+        harness.runParallelCase ("buffer", "spsc_handoff", 2, iterations, [&](uint32_t t, uint64_t i) {
+            BufferElement popped;
+            if (t == 0)
+                while (!spscBuffer->BUFFER_PUSH ((BufferElement {i, 0, 0, {}})))
+                    std::this_thread::yield();
+            else
+                while (!spscBuffer->tryPop (popped))
+                    std::this_thread::yield();
+        });
+        harness.runParallelCase ("buffer", "mpmc_handoff", 4, iterations, [&](uint32_t t, uint64_t i) {
+            BufferElement popped;
+            if (t < 2)
+                while (!mpmcBuffer->BUFFER_PUSH ((BufferElement {i, t, 0, {}})))
+                    std::this_thread::yield();
+            else
+                while (!mpmcBuffer->tryPop (popped))
+                    std::this_thread::yield();
+        });
+        BUFFER_CLOSE (1);
+        BUFFER_CLOSE (2);
+
+        if (sink == 0)
+            std::cerr << "[WARNING] buffer cases produced no output" << std::endl;
+    }
+}   // namespace Bench
+#endif  // BN_BUFFER_H
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef BN_LOG_HEADER_H
+#define BN_LOG_HEADER_H
+
+#include <sstream>
+#include "../BNHarness.h"
+#include "../../Collection/Log/Log.h"
+
+namespace Bench {
+    using namespace Collection;
+
+    /* Header formatting as it was before the reusable header buffer and cached timestamp, kept here as the baseline for
+     * the comparison
+    */
+    std::string legacyGetLocalTimestamp (void) {
+        std::stringstream stream;
+
+        auto now = std::chrono::system_clock::now();
+        auto t_c = std::chrono::system_clock::to_time_t (now);
+        stream << std::put_time (std::localtime (&t_c), "%F %T");
+        return stream.str();
+    }
+
+    std::string legacyGetHeader (uint32_t instanceId,
+                                 const char* levelString,
+                                 const char* callingFunction,
+                                 uint32_t line) {
+
+        std::string instanceIdString = std::to_string (instanceId);
+        if (instanceId < 10)
+            instanceIdString.insert (0, 1, '0');
+
+        std::string header = "[" + instanceIdString + "]" +
+                             " " +
+                             legacyGetLocalTimestamp() +
+                             " " +
+                             "[" + levelString + "]"
+                             + " " +
+                             callingFunction +
+                             " " +
+                             std::to_string (line) +
+                             " ";
+        return header;
+    }
+
+    void runLogHeaderCases (BNHarness& harness, const char* saveDir, uint64_t iterations) {
+        /* |--------------------------------------------------------------------------------------------------------|
+         * | HEADER ONLY                                                                                            |
+         * |--------------------------------------------------------------------------------------------------------|
+        */
+        size_t sink = 0;
+        harness.runCase ("log_header", "legacy", iterations, [&](uint64_t i) {
+            sink += legacyGetHeader (1, "INFO", __FUNCTION__, static_cast <uint32_t> (i)).size();
+        });
+
+        auto benchLog = LOG_INIT (1, saveDir);
+        harness.runCase ("log_header", "cached", iterations, [&](uint64_t i) {
+            sink += strlen (benchLog->getHeader (Log::INFO, __FUNCTION__, static_cast <uint32_t> (i), true));
+        });
+        /* |--------------------------------------------------------------------------------------------------------|
+         * | FULL LINE TO FILE                                                                                      |
+         * |--------------------------------------------------------------------------------------------------------|
+        */
+        std::string legacyFilePath = std::string (saveDir) + "i_0_BNLogHeaderLegacy.txt";
+        std::fstream legacyFile (legacyFilePath, std::ios_base::out);
+        harness.runCase ("log_line_file", "legacy", iterations, [&](uint64_t i) {
+            legacyFile << legacyGetHeader (1, "INFO", __FUNCTION__, __LINE__)
+                       << "vertex " << i << " " << 0.5f
+                       << std::endl;
+        });
+        legacyFile.close();
+        remove (legacyFilePath.c_str());
+
+        LOG_ADD_CONFIG (1, Log::INFO, Log::TO_FILE_IMMEDIATE);
+        harness.runCase ("log_line_file", "cached", iterations, [&](uint64_t i) {
+            LOG_INFO (benchLog) << "vertex " << i << " " << 0.5f
+                                << std::endl;
+        });
+        LOG_CLEAR_CONFIG (1);
+        remove ((std::string (saveDir) + "i_1_BNLogHeader.txt").c_str());
+        LOG_CLOSE (1);
+
+        if (sink == 0)
+            std::cout << "\n";
+    }
+}   // namespace Bench
+#endif  // BN_LOG_HEADER_H
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef BN_LOG_SINK_H
+#define BN_LOG_SINK_H
+
+#include <filesystem>
+#include "../BNHarness.h"
+#include "../../Collection/Log/Log.h"
+
+namespace Bench {
+    using namespace Collection;
+
+    /* Log a line shaped like the per vertex parsed data dump through the given sink, and report the size of the file
+     * written per line (not meaningful for the mapped and buffered sinks, which keep only the latest entries)
+    */
+    void runLogSinkCase (BNHarness& harness,
+                         const char* name,
+                         Log::e_sink sink,
+                         const std::string& filePath,
+                         uint64_t iterations,
+                         bool measureBytes     = true,
+                         size_t bufferCapacity = 0) {
+
+        auto benchLog = LOG_INIT (2, filePath.substr (0, filePath.find_last_of ('/') + 1), bufferCapacity);
+        LOG_ADD_CONFIG (2, Log::INFO, sink);
+
+        float position[3] = {1.25f, -0.5f, 8.0f};
+        float texCoord[2] = {0.5f, 0.75f};
+        auto& result      = harness.runCase ("log_sink", name, iterations, [&](uint64_t i) {
+            LOG_INFO (benchLog) << "vertex "   << i
+                                << " pos "     << position[0] << " " << position[1] << " " << position[2]
+                                << " uv "      << texCoord[0] << " " << texCoord[1]
+                                << " texId "   << static_cast <uint32_t> (i & 7)
+                                << std::endl;
+        });
+        /* Keep the file around to measure its size
+        */
+        LOG_CLEAR_CONFIG (2);
+        LOG_CLOSE (2);
+
+        if (measureBytes)
+            result.bytes = std::filesystem::file_size (filePath);
+        remove (filePath.c_str());
+    }
+
+    void runLogSinkCases (BNHarness& harness, const char* saveDir, uint64_t iterations) {
+        runLogSinkCase (harness, "file_immediate", Log::TO_FILE_IMMEDIATE,
+                        std::string (saveDir) + "i_2_BNLogSink.txt", iterations);
+        runLogSinkCase (harness, "file_async",     Log::TO_FILE_ASYNC,
+                        std::string (saveDir) + "a_2_BNLogSink.txt", iterations);
+        runLogSinkCase (harness, "file_buffered",  Log::TO_FILE_BUFFER_CIRCULAR,
+                        std::string (saveDir) + "b_2_BNLogSink.txt", iterations, false, 1024);
+        runLogSinkCase (harness, "file_binary",    Log::TO_FILE_BINARY,
+                        std::string (saveDir) + "d_2_BNLogSink.bin", iterations);
+        runLogSinkCase (harness, "file_mapped",    Log::TO_FILE_MAPPED_CIRCULAR,
+                        std::string (saveDir) + "m_2_BNLogSink.ring", iterations, false);
+    }
+}   // namespace Bench
+#endif  // BN_LOG_SINK_H
\ No newline at end of file
@@ -0,0 +1,119 @@
+#ifndef BN_LOG_STRESS_H
+#define BN_LOG_STRESS_H
+
+#include <fstream>
+#include <cstdio>
+#include <cinttypes>
+#include "../BNHarness.h"
+#include "../../Collection/Log/Log.h"
+
+namespace Bench {
+    using namespace Collection;
+
+    /* Every line written by the stress case carries its thread index and sequence number, and ends with a marker. A line
+     * is whole if it holds exactly one payload, which either follows a header or starts the line (lightweight entries),
+     * and ends with the marker. The file is intact if every line is whole and every thread's lines are all present.
+     * Returns false (and reports why) if the file is corrupt
+    */
+    bool validateLogStressFile (const std::string& filePath, uint32_t threadCount, uint64_t linesPerThread) {
+        std::ifstream file (filePath);
+        if (!file.is_open()) {
+            std::cerr << "[FAIL] " << filePath << " missing" << std::endl;
+            return false;
+        }
+
+        std::vector <std::vector <bool>> seen (threadCount, std::vector <bool> (linesPerThread, false));
+        std::string line;
+        uint64_t lineCount = 0;
+        while (std::getline (file, line)) {
+            lineCount++;
+            size_t payloadBegin = line.find ("stress t=");
+            bool isWhole        = payloadBegin != std::string::npos                                 &&
+                                  line.find ("stress t=", payloadBegin + 1) == std::string::npos  &&
+                                  (payloadBegin == 0 || line.compare (0, 5, "[03] ") == 0)         &&
+                                  line.size() >= 4 && line.compare (line.size() - 4, 4, " end") == 0;
+
+            uint32_t t = 0;
+            uint64_t n = 0;
+            if (isWhole && sscanf (line.c_str() + payloadBegin, "stress t=%" SCNu32 " n=%" SCNu64, &t, &n) == 2 &&
+                t < threadCount && n < linesPerThread && !seen[t][n]) {
+                seen[t][n] = true;
+                continue;
+            }
+
+            std::cerr << "[FAIL] " << filePath << " corrupt line " << lineCount << ": " << line << std::endl;
+            return false;
+        }
+
+        if (lineCount != threadCount * linesPerThread) {
+            std::cerr << "[FAIL] " << filePath << " has "  << lineCount
+                      << " lines, expected "               << threadCount * linesPerThread << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /* Log from many threads to the same record at once and check that no entry was torn or lost. Statements of
+     * different levels, header modes and argument types are mixed so that entries from different call sites interleave
+    */
+    bool runLogStressCase (BNHarness& harness,
+                           const char* name,
+                           Log::e_sink sink,
+                           const char* saveDir,
+                           uint32_t threadCount,
+                           uint64_t linesPerThread) {
+
+        auto stressLog = LOG_INIT (3, saveDir);
+        LOG_ADD_CONFIG (3, Log::INFO,    sink);
+        LOG_ADD_CONFIG (3, Log::WARNING, sink);
+
+        const char* filler = "abcdefghijklmnopqrstuvwxyz";
+        harness.runParallelCase ("log_stress", name, threadCount, linesPerThread, [&](uint32_t t, uint64_t i) {
+            if (i % 3 == 0)
+                LOG_LITE (stressLog)    << "stress t=" << t << " n=" << i
+                                        << " "         << filler
+                                        << " end"      << std::endl;
+            else if (i % 3 == 1)
+                LOG_WARNING (stressLog) << "stress t=" << t << " n=" << i
+                                        << " "         << static_cast <float> (i) * 0.5f
+                                        << " end"      << std::endl;
+            else
+                LOG_INFO (stressLog)    << "stress t=" << t << " n=" << i
+                                        << " "         << (i & 1) << ' ' << filler + (i % 26)
+                                        << " end"      << std::endl;
+        });
+        LOG_CLEAR_CONFIG (3);
+        LOG_CLOSE (3);
+
+        bool isIntact = true;
+        for (auto const& [textSink, fileName]: {std::make_pair (Log::TO_FILE_IMMEDIATE, "i_3_BNLogStress.txt"),
+                                                std::make_pair (Log::TO_FILE_ASYNC,     "a_3_BNLogStress.txt")}) {
+            if ((sink & textSink) == 0)
+                continue;
+
+            std::string filePath = std::string (saveDir) + fileName;
+            isIntact             = validateLogStressFile (filePath, threadCount, linesPerThread) && isIntact;
+            remove (filePath.c_str());
+        }
+        /* The binary and mapped sinks are checked offline with the decoder and reader tools
+        */
+        for (auto const& fileName: {"d_3_BNLogStress.bin", "m_3_BNLogStress.ring"})
+            remove ((std::string (saveDir) + fileName).c_str());
+        return isIntact;
+    }
+
+    bool runLogStressCases (BNHarness& harness, const char* saveDir, uint32_t threadCount, uint64_t linesPerThread) {
+        bool isIntact = true;
+        isIntact = runLogStressCase (harness, "file_immediate", Log::TO_FILE_IMMEDIATE,
+                                     saveDir, threadCount, linesPerThread) && isIntact;
+        isIntact = runLogStressCase (harness, "file_async",     Log::TO_FILE_ASYNC,
+                                     saveDir, threadCount, linesPerThread) && isIntact;
+        isIntact = runLogStressCase (harness, "file_all",       Log::TO_FILE_IMMEDIATE       |
+                                                                Log::TO_FILE_ASYNC           |
+                                                                Log::TO_FILE_BINARY          |
+                                                                Log::TO_FILE_MAPPED_CIRCULAR,
+                                     saveDir, threadCount, linesPerThread) && isIntact;
+        return isIntact;
+    }
+}   // namespace Bench
+#endif  // BN_LOG_STRESS_H
\ No newline at end of file
@@ -0,0 +1,1073 @@
+#ifndef BN_MODEL_H
+#define BN_MODEL_H
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <cfloat>
+#include "../BNHarness.h"
+#include "../../Core/Model/VKInstanceData.h"
+
+namespace Bench {
+    /* The model import and instance methods are protected members of the Core classes, this exposes them to the bench
+     * cases without the rest of the engine (no window, no device)
+    */
+    class BNModelMgr: protected Core::VKInstanceData {
+        public:
+            using Core::VKModelMgr::readyModelInfo;
+            using Core::VKModelMgr::importOBJModel;
+            using Core::VKModelMgr::importOBJModels;
+            using Core::VKModelMgr::readyInstanceArena;
+            using Core::VKModelMgr::getInstanceArenaSize;
+            using Core::VKModelMgr::writeInstances;
+            using Core::VKModelMgr::InstanceSlotTracker;
+            using Core::VKModelMgr::writeStaticInstances;
+            using Core::VKModelMgr::setStaticInstanceDirty;
+#if ENABLE_MESH_LOD
+            using Core::VKModelMgr::orderInstancesByLOD;
+#endif  // ENABLE_MESH_LOD
+#if ENABLE_MESHLET_CULLING
+            using Core::VKModelMgr::cullMeshlets;
+            using Core::VKModelMgr::MeshletDraw;
+#endif  // ENABLE_MESHLET_CULLING
+            using Core::VKModelMgr::getModelInfo;
+            using Core::VKModelMgr::cleanUp;
+            using Core::VKModelMatrix::createModelMatrix;
+            using Core::VKModelMatrix::createModelMatrices;
+            using Core::VKInstanceData::importInstanceData;
+    };
+
+    struct BNModelAsset {
+        std::string name;
+        std::string modelPath;
+        std::string mtlFileDirPath;
+        std::string instanceDataPath;
+        uint64_t fileSize;
+    };
+
+    /* Every model under the asset directory, along with its material directory and instance data file (which follow the
+     * naming used in SandBox/ENConfig.h)
+    */
+    std::vector <BNModelAsset> getModelAssets (const char* assetDir) {
+        std::vector <BNModelAsset> assets;
+        for (auto const& entry: std::filesystem::recursive_directory_iterator (assetDir)) {
+            if (entry.path().extension() != ".obj")
+                continue;
+
+            BNModelAsset asset;
+            asset.name             = entry.path().stem().string();
+            asset.modelPath        = entry.path().string();
+            asset.mtlFileDirPath   = entry.path().parent_path().string() + "/";
+            asset.instanceDataPath = asset.mtlFileDirPath + asset.name + "_Instances.json";
+            asset.fileSize         = entry.file_size();
+            assets.push_back (asset);
+        }
+        std::sort (assets.begin(), assets.end(), [](const BNModelAsset& a, const BNModelAsset& b) {
+            return a.modelPath < b.modelPath;
+        });
+        return assets;
+    }
+
+    /* Instance data file with the given number of instances spread over a grid, in the format read by importInstanceData
+    */
+    void writeInstanceDataFile (const std::string& filePath, uint32_t instancesCount) {
+        std::ofstream file (filePath);
+        file << "{\n    \"instancesCount\": " << instancesCount << ",\n    \"instances\": [\n";
+        for (uint32_t i = 0; i < instancesCount; i++) {
+            file << "        {"
+                 << "\"id\": "             << i                                             << ", "
+                 << "\"position\": ["      << (i % 64) * 4.0f << ", 0.0, " << (i / 64) * 4.0f << "], "
+                 << "\"rotateAxis\": [0.0, 1.0, 0.0], "
+                 << "\"scale\": [1.0, 1.0, 1.0], "
+                 << "\"rotateAngleDeg\": " << (i * 15) % 360
+                 << "}"
+                 << (i + 1 == instancesCount ? "\n": ",\n");
+        }
+        file << "    ]\n}\n";
+    }
+
+    /* Instance data file with the given records, in the binary instance data format
+    */
+    void writeInstanceDataBinaryFile (const std::string& filePath,
+                                      const std::vector <Core::InstanceDataFormat::Record>& records) {
+        Core::InstanceDataFormat::FileHeader fileHeader {};
+        memcpy (fileHeader.magic, Core::InstanceDataFormat::MAGIC, sizeof (Core::InstanceDataFormat::MAGIC));
+        fileHeader.version        = Core::InstanceDataFormat::VERSION;
+        fileHeader.recordSize     = sizeof (Core::InstanceDataFormat::Record);
+        fileHeader.instancesCount = static_cast <uint32_t> (records.size());
+        fileHeader.recordsOffset  = Core::InstanceDataFormat::FILE_HEADER_SIZE;
+        fileHeader.fileSize       = Core::InstanceDataFormat::FILE_HEADER_SIZE +
+                                    records.size() * sizeof (Core::InstanceDataFormat::Record);
+
+        char header[Core::InstanceDataFormat::FILE_HEADER_SIZE] = {};
+        memcpy (header, &fileHeader, sizeof (fileHeader));
+
+        std::ofstream file (filePath, std::ios_base::out | std::ios_base::binary);
+        file.write (header, sizeof (header));
+        file.write (reinterpret_cast <const char*> (records.data()),
+                    records.size() * sizeof (Core::InstanceDataFormat::Record));
+    }
+
+    /* Same instances as writeInstanceDataFile, in the binary instance data format
+    */
+    void writeInstanceDataBinaryFile (const std::string& filePath, uint32_t instancesCount) {
+        std::vector <Core::InstanceDataFormat::Record> records;
+        records.reserve (instancesCount);
+        for (uint32_t i = 0; i < instancesCount; i++) {
+            records.push_back ({
+                {(i % 64) * 4.0f, 0.0f, (i / 64) * 4.0f},
+                {0.0f, 1.0f, 0.0f},
+                {1.0f, 1.0f, 1.0f},
+                static_cast <float> ((i * 15) % 360)
+            });
+        }
+        writeInstanceDataBinaryFile (filePath, records);
+    }
+
+    /* Model file (and its .mtl file) of a grid with gridSize x gridSize quads, a stand in for a high polygon asset
+    */
+    void writeGridModelFile (const std::string& dirPath, const std::string& name, uint32_t gridSize) {
+        std::ofstream mtlFile (dirPath + name + ".mtl");
+        mtlFile << "newmtl Grid\nmap_Kd " << name << ".png\n";
+
+        std::ofstream file (dirPath + name + ".obj");
+        file << "mtllib " << name << ".mtl\no " << name << "\n";
+        for (uint32_t z = 0; z <= gridSize; z++) {
+            for (uint32_t x = 0; x <= gridSize; x++) {
+                file << "v "  << x * 0.25f << " " << 0.01f * ((x * 7 + z * 13) % 17) << " " << z * 0.25f << "\n";
+                file << "vt " << static_cast <float> (x) / gridSize << " " << static_cast <float> (z) / gridSize << "\n";
+            }
+        }
+        file << "vn 0.0 1.0 0.0\nusemtl Grid\n";
+        for (uint32_t z = 0; z < gridSize; z++) {
+            for (uint32_t x = 0; x < gridSize; x++) {
+                uint32_t i0 = z * (gridSize + 1) + x + 1;
+                uint32_t i1 = i0 + gridSize + 1;
+                file << "f " << i0     << "/" << i0     << "/1 " << i1     << "/" << i1     << "/1 "
+                             << i1 + 1 << "/" << i1 + 1 << "/1 " << i0 + 1 << "/" << i0 + 1 << "/1\n";
+            }
+        }
+    }
+
+    /* Model file (and its .mtl file) of concave polygons with more than 4 corners, which are ear clipped on import.
+     * Split into a textured shape and one that uses the default texture, with faces in both windings and planes
+    */
+    void writePolygonModelFile (const std::string& dirPath, const std::string& name) {
+        std::ofstream mtlFile (dirPath + name + ".mtl");
+        mtlFile << "newmtl Polygon\nmap_Kd " << name << ".png\n";
+
+        std::ofstream file (dirPath + name + ".obj");
+        file << "mtllib " << name << ".mtl\n"
+             /* Pentagon with a notch at its top (xy plane, counter clockwise)
+             */
+             << "v 0 0 0\nv 4 0 0\nv 4 4 0\nv 2 1 0\nv 0 4 0\n"
+             /* Hexagon with a notch at its top (xy plane, counter clockwise)
+             */
+             << "v 0 0 1\nv 6 0 1\nv 6 3 1\nv 4 1 1\nv 2 3 1\nv 0 3 1\n"
+             /* L shaped hexagon (xz plane, clockwise)
+             */
+             << "v 0 2 0\nv 0 2 2\nv 1 2 2\nv 1 2 1\nv 2 2 1\nv 2 2 0\n"
+             << "vt 0 0\nvt 1 0\nvt 1 1\nvt 0.5 0.25\nvt 0 1\n"
+             << "vn 0 0 1\nvn 0 1 0\n"
+             << "o " << name << "_Textured\nusemtl Polygon\n"
+             << "f 1/1/1 2/2/1 3/3/1 4/4/1 5/5/1\n"
+             << "f 6/1/1 7/2/1 8/3/1 9/4/1 10/5/1 11/1/1\n"
+             << "o " << name << "_Default\nusemtl None\n"
+             << "f 12//2 13//2 14//2 15//2 16//2 17//2\n"
+             << "f -17//2 -16//2 -15//2 -14//2 -13//2\n";
+    }
+
+    /* Face vertex stream of a grid with gridSize x gridSize quads (2 triangles each), as it would be read from a model
+     * file before deduplication. Every interior vertex shows up 6 times
+    */
+    std::vector <Core::Vertex> getGridVertexStream (uint32_t gridSize) {
+        std::vector <Core::Vertex> vertexStream;
+        vertexStream.reserve (static_cast <size_t> (gridSize) * gridSize * 6);
+
+        auto getVertex = [&](uint32_t x, uint32_t z) {
+            Core::Vertex vertex {};
+            vertex.pos      = {static_cast <float> (x), 0.0f, static_cast <float> (z)};
+            vertex.texCoord = {static_cast <float> (x) / gridSize, static_cast <float> (z) / gridSize};
+            vertex.normal   = {0.0f, 1.0f, 0.0f};
+            vertex.texId    = 1;
+            return vertex;
+        };
+        for (uint32_t z = 0; z < gridSize; z++) {
+            for (uint32_t x = 0; x < gridSize; x++) {
+                vertexStream.push_back (getVertex (x,     z));
+                vertexStream.push_back (getVertex (x,     z + 1));
+                vertexStream.push_back (getVertex (x + 1, z));
+                vertexStream.push_back (getVertex (x + 1, z));
+                vertexStream.push_back (getVertex (x,     z + 1));
+                vertexStream.push_back (getVertex (x + 1, z + 1));
+            }
+        }
+        return vertexStream;
+    }
+
+    /* Vertices and indices of the grid of getGridVertexStream, deduplicated the way importOBJModel does it
+    */
+    void getGridMesh (uint32_t gridSize, std::vector <Core::Vertex>& vertices, std::vector <uint32_t>& indices) {
+        auto vertexStream = getGridVertexStream (gridSize);
+        Core::VKVertexDedup uniqueVertices;
+        uniqueVertices.reset (vertexStream.size());
+        indices.reserve      (vertexStream.size());
+        for (auto const& vertex: vertexStream)
+            indices.push_back (uniqueVertices.getIndex (vertex, vertices));
+    }
+
+    void runVertexDedupCases (BNHarness& harness, uint32_t gridSize, uint64_t iterations) {
+        auto vertexStream = getGridVertexStream (gridSize);
+        uint64_t bytes    = vertexStream.size() * sizeof (Core::Vertex) * iterations;
+        size_t sink       = 0;
+        /* Baseline, the map with two lookups per vertex that was used by importOBJModel
+        */
+        std::string name  = "vertex_dedup_map_" + std::to_string (gridSize);
+        auto& mapResult   = harness.runCase ("model", name.c_str(), iterations, [&](uint64_t) {
+            std::unordered_map <Core::Vertex, uint32_t> uniqueVertices;
+            std::vector <Core::Vertex> vertices;
+            std::vector <uint32_t> indices;
+            for (auto const& vertex: vertexStream) {
+                if (uniqueVertices.count (vertex) == 0) {
+                    uniqueVertices[vertex] = static_cast <uint32_t> (vertices.size());
+                    vertices.push_back (vertex);
+                }
+                indices.push_back (uniqueVertices[vertex]);
+            }
+            sink += vertices.size() + indices.size();
+        });
+        mapResult.bytes   = bytes;
+
+        name              = "vertex_dedup_flat_" + std::to_string (gridSize);
+        auto& flatResult  = harness.runCase ("model", name.c_str(), iterations, [&](uint64_t) {
+            Core::VKVertexDedup uniqueVertices;
+            std::vector <Core::Vertex> vertices;
+            std::vector <uint32_t> indices;
+            uniqueVertices.reset (vertexStream.size());
+            indices.reserve      (vertexStream.size());
+            for (auto const& vertex: vertexStream)
+                indices.push_back (uniqueVertices.getIndex (vertex, vertices));
+            sink += vertices.size() + indices.size();
+        });
+        flatResult.bytes  = bytes;
+
+        if (sink == 0)
+            std::cerr << "[WARNING] vertex dedup cases produced no output" << std::endl;
+    }
+
+    /* Reorder of a grid whose triangles were shuffled, the worst case for the vertex cache
+    */
+    void runMeshOptimizerCases (BNHarness& harness, uint32_t gridSize, uint64_t iterations) {
+        std::vector <Core::Vertex> vertices;
+        std::vector <uint32_t> indices;
+        getGridMesh (gridSize, vertices, indices);
+
+        std::vector <uint32_t> triangleOrder (indices.size() / 3);
+        for (size_t i = 0; i < triangleOrder.size(); i++)
+            triangleOrder[i] = static_cast <uint32_t> (i);
+        std::shuffle (triangleOrder.begin(), triangleOrder.end(), std::mt19937 (1));
+
+        std::vector <uint32_t> shuffledIndices;
+        for (auto const& triangleIdx: triangleOrder)
+            for (size_t i = 0; i < 3; i++)
+                shuffledIndices.push_back (indices[triangleIdx * 3 + i]);
+
+        size_t sink        = 0;
+        std::string name   = "mesh_optimize_" + std::to_string (gridSize);
+        auto& result       = harness.runCase ("model", name.c_str(), iterations, [&](uint64_t) {
+            auto optimizedVertices = vertices;
+            auto optimizedIndices  = shuffledIndices;
+            Core::VKMeshOptimizer::optimizeVertexCache (optimizedIndices, optimizedVertices.size());
+            Core::VKMeshOptimizer::optimizeVertexFetch (optimizedVertices, optimizedIndices);
+            sink += optimizedVertices.size();
+        });
+        result.bytes       = shuffledIndices.size() * sizeof (uint32_t) * iterations;
+
+        auto statsBefore   = Core::VKMeshOptimizer::getCacheStats (shuffledIndices, vertices.size());
+        Core::VKMeshOptimizer::optimizeVertexCache (shuffledIndices, vertices.size());
+        auto statsAfter    = Core::VKMeshOptimizer::getCacheStats (shuffledIndices, vertices.size());
+        std::cout << "[INFO] " << name << " ACMR " << statsBefore.acmr << " -> " << statsAfter.acmr
+                  << ", ATVR " << statsBefore.atvr << " -> " << statsAfter.atvr << std::endl;
+
+        if (sink == 0)
+            std::cerr << "[WARNING] mesh optimizer cases produced no output" << std::endl;
+    }
+
+    /* Encode a grid into the compact vertex format. Returns false (and reports why) if a decoded position is off by
+     * more than one quantization step (scale / 65535) along an axis, or a decoded normal by more than the angle an 8 bit
+     * octahedral encoding can be off by. A component of the octahedron is off by at most half a step (1 / 254), which
+     * moves the unnormalized normal (at least 1 / sqrt (3) long) by at most sqrt (6) / 254
+    */
+    bool runCompactVertexCases (BNHarness& harness, uint32_t gridSize, uint64_t iterations) {
+        std::vector <Core::Vertex> vertices;
+        std::vector <uint32_t> indices;
+        getGridMesh (gridSize, vertices, indices);
+        /* Normals pointing all around the sphere, to cover both halves of the octahedral encoding
+        */
+        for (auto& vertex: vertices)
+            vertex.normal  = glm::normalize (glm::vec3 {std::cos (vertex.pos.x * 0.37f) + 0.01f,
+                                                        std::sin (vertex.pos.z * 0.23f),
+                                                        std::cos (vertex.pos.x * 0.19f + vertex.pos.z * 0.11f)});
+        auto bounds        = Core::VKVertexCompact::getBoundingBox (vertices);
+
+        std::vector <Core::CompactVertex> compactVertices;
+        std::vector <uint8_t> indexBytes;
+        std::string name   = "compact_vertex_encode_" + std::to_string (gridSize);
+        auto& result       = harness.runCase ("model", name.c_str(), iterations, [&](uint64_t) {
+            compactVertices.clear();
+            indexBytes.clear();
+            Core::VKVertexCompact::appendVertices (vertices, bounds, compactVertices);
+            Core::VKVertexCompact::appendIndices  ({indices}, vertices.size(), indexBytes);
+        });
+        result.bytes       = vertices.size() * sizeof (Core::Vertex) * iterations;
+
+        glm::vec3 positionBound = Core::VKVertexCompact::getPositionScale (bounds) / 65535.0f;
+        float normalBound       = glm::degrees (std::asin (std::sqrt (6.0f) * std::sqrt (3.0f) / 254.0f));
+        bool isWithinBounds     = true;
+        float maxPositionError  = 0.0f;
+        float minNormalCosine   = 1.0f;
+        for (size_t i = 0; i < vertices.size(); i++) {
+            auto decoded        = Core::VKVertexCompact::decodeVertex (compactVertices[i], bounds);
+            maxPositionError    = std::max (maxPositionError, glm::distance (decoded.pos, vertices[i].pos));
+            minNormalCosine     = std::min (minNormalCosine,  glm::dot      (decoded.normal, vertices[i].normal));
+            for (int axis = 0; axis < 3; axis++) {
+                if (std::fabs (decoded.pos[axis] - vertices[i].pos[axis]) <= positionBound[axis])
+                    continue;
+                std::cerr << "[FAIL] " << name << " vertex " << i << " position is off by more than a step"
+                          << std::endl;
+                isWithinBounds  = false;
+                break;
+            }
+        }
+        float maxNormalError    = glm::degrees (std::acos (std::min (minNormalCosine, 1.0f)));
+        if (maxNormalError > normalBound) {
+            std::cerr << "[FAIL] " << name << " normal is off by " << maxNormalError << " deg, over the "
+                      << normalBound << " deg bound" << std::endl;
+            isWithinBounds      = false;
+        }
+        std::cout << "[INFO] " << name
+                  << " vertex bytes " << vertices.size() * sizeof (Core::Vertex)
+                  << " -> "           << compactVertices.size() * sizeof (Core::CompactVertex)
+                  << ", index bytes " << indices.size() * sizeof (uint32_t)
+                  << " -> "           << indexBytes.size()
+                  << ", max position error " << maxPositionError
+                  << ", max normal error "   << maxNormalError << " deg"
+                  << std::endl;
+        return isWithinBounds;
+    }
+
+    /* Simplify a grid to half its triangles. Returns false (and reports why) if the result,
+     * (1) Has more indices than the target, unless lifting maxError lets the simplifier go further (so that it stopped
+     *     only on the error)
+     * (2) Has an index out of range of the vertices, or a triangle with two corners at the same position
+     * (3) Was reached with an error over maxError
+    */
+    bool runMeshSimplifierCases (BNHarness& harness, uint32_t gridSize, uint64_t iterations) {
+        std::vector <Core::Vertex> vertices;
+        std::vector <uint32_t> indices;
+        getGridMesh (gridSize, vertices, indices);
+        size_t targetIndicesCount = indices.size() / 2 / 3 * 3;
+        float maxError            = Core::g_coreSettings.lodMaxError;
+
+        std::vector <uint32_t> lodIndices;
+        float error       = 0.0f;
+        std::string name  = "simplify_grid_" + std::to_string (gridSize);
+        auto& result      = harness.runCase ("model", name.c_str(), iterations, [&](uint64_t) {
+            lodIndices = Core::VKMeshSimplifier::simplify (vertices,
+                                                           indices,
+                                                           targetIndicesCount,
+                                                           maxError,
+                                                           &error);
+        });
+        result.bytes      = indices.size() * sizeof (uint32_t) * iterations;
+
+        std::cout << "[INFO] " << name
+                  << " indices " << indices.size()
+                  << " -> "      << lodIndices.size()
+                  << ", error "  << error
+                  << std::endl;
+
+        bool isValid      = true;
+        if (lodIndices.size() > targetIndicesCount) {
+            auto unboundedIndices = Core::VKMeshSimplifier::simplify (vertices,
+                                                                      indices,
+                                                                      targetIndicesCount,
+                                                                      FLT_MAX);
+            if (unboundedIndices.size() >= lodIndices.size()) {
+                std::cerr << "[FAIL] " << name << " stopped over the target index count " << targetIndicesCount
+                          << " before reaching maxError" << std::endl;
+                isValid   = false;
+            }
+        }
+        for (size_t i = 0; i < lodIndices.size(); i += 3) {
+            if (lodIndices[i + 0] >= vertices.size() ||
+                lodIndices[i + 1] >= vertices.size() ||
+                lodIndices[i + 2] >= vertices.size()) {
+                std::cerr << "[FAIL] " << name << " triangle " << i / 3 << " has an index out of range" << std::endl;
+                isValid   = false;
+                break;
+            }
+            auto const& posA = vertices[lodIndices[i + 0]].pos;
+            auto const& posB = vertices[lodIndices[i + 1]].pos;
+            auto const& posC = vertices[lodIndices[i + 2]].pos;
+            if (posA == posB || posB == posC || posC == posA) {
+                std::cerr << "[FAIL] " << name << " triangle " << i / 3 << " is degenerate" << std::endl;
+                isValid   = false;
+                break;
+            }
+        }
+        if (error > maxError) {
+            std::cerr << "[FAIL] " << name << " error " << error << " is over maxError " << maxError << std::endl;
+            isValid       = false;
+        }
+        return isValid;
+    }
+
+    /* Build the meshlets of a grid. Returns false (and reports why) if a meshlet goes over the vertex or triangle limit,
+     * if the meshlets do not tile the index data (one after the other, whole triangles, no gaps), or if a vertex of a
+     * meshlet is outside its bounding sphere
+    */
+    bool runMeshletCases (BNHarness& harness, uint32_t gridSize, uint64_t iterations) {
+        std::vector <Core::Vertex> vertices;
+        std::vector <uint32_t> indices;
+        getGridMesh (gridSize, vertices, indices);
+        Core::VKMeshOptimizer::optimizeVertexCache (indices, vertices.size());
+        uint32_t maxVerticesCount  = Core::g_coreSettings.maxMeshletVerticesCount;
+        uint32_t maxTrianglesCount = Core::g_coreSettings.maxMeshletTrianglesCount;
+
+        std::vector <Core::Meshlet> meshlets;
+        std::string name  = "build_meshlets_" + std::to_string (gridSize);
+        auto& result      = harness.runCase ("model", name.c_str(), iterations, [&](uint64_t) {
+            meshlets = Core::VKMeshlet::buildMeshlets (vertices,
+                                                       indices,
+                                                       maxVerticesCount,
+                                                       maxTrianglesCount,
+                                                       true);
+        });
+        result.bytes      = indices.size() * sizeof (uint32_t) * iterations;
+
+        float averageRadius = 0.0f;
+        for (auto const& meshlet: meshlets)
+            averageRadius += meshlet.radius / meshlets.size();
+        std::cout << "[INFO] " << name
+                  << " meshlets "        << meshlets.size()
+                  << ", average radius " << averageRadius
+                  << std::endl;
+
+        bool isValid        = true;
+        size_t nextIndex    = 0;
+        /* Id of the last meshlet a vertex was counted in, to count the unique vertices of a meshlet
+        */
+        std::vector <uint32_t> meshletIds (vertices.size(), UINT32_MAX);
+        for (uint32_t meshletId = 0; meshletId < meshlets.size() && isValid; meshletId++) {
+            auto const& meshlet = meshlets[meshletId];
+            if (meshlet.firstIndex != nextIndex || meshlet.indicesCount == 0 || meshlet.indicesCount % 3 != 0 ||
+                meshlet.firstIndex + meshlet.indicesCount > indices.size()) {
+                std::cerr << "[FAIL] " << name << " meshlet " << meshletId << " does not follow on from the previous"
+                          << " one with whole triangles" << std::endl;
+                isValid     = false;
+                break;
+            }
+            nextIndex       = meshlet.firstIndex + meshlet.indicesCount;
+
+            uint32_t verticesCount = 0;
+            for (uint32_t i = meshlet.firstIndex; i < nextIndex; i++) {
+                uint32_t index = indices[i];
+                if (meshletIds[index] != meshletId) {
+                    meshletIds[index] = meshletId;
+                    verticesCount++;
+                }
+                if (glm::distance (vertices[index].pos, meshlet.center) > meshlet.radius) {
+                    std::cerr << "[FAIL] " << name << " meshlet " << meshletId << " vertex " << index
+                              << " is outside its bounding sphere" << std::endl;
+                    isValid = false;
+                    break;
+                }
+            }
+            if (verticesCount > maxVerticesCount || meshlet.indicesCount / 3 > maxTrianglesCount) {
+                std::cerr << "[FAIL] " << name << " meshlet " << meshletId << " has " << verticesCount
+                          << " vertices and " << meshlet.indicesCount / 3 << " triangles, over the limits"
+                          << std::endl;
+                isValid     = false;
+            }
+        }
+        if (isValid && nextIndex != indices.size()) {
+            std::cerr << "[FAIL] " << name << " meshlets end at index " << nextIndex << " of " << indices.size()
+                      << std::endl;
+            isValid         = false;
+        }
+        return isValid;
+    }
+
+    /* Vertices and indices of a model, built from a parser's output the way VKModelMgr::buildOBJModel does (before
+     * the mesh is optimized). Texture ids stand in for the texture image info ids, 0 being the default texture
+    */
+    class BNOBJModelBuilder {
+        private:
+            std::vector <uint32_t> m_texIds;
+            uint32_t m_quadIndex;
+            Core::VKVertexDedup m_uniqueVertices;
+
+        public:
+            std::vector <Core::Vertex> vertices;
+            std::vector <uint32_t> indices;
+
+            BNOBJModelBuilder (const std::vector <tinyobj::material_t>& materials, size_t indicesCount) {
+                std::unordered_map <std::string, uint32_t> texIdPool = {
+                    {Core::g_coreSettings.defaultDiffuseTexturePath, 0}
+                };
+                m_texIds.push_back (0);
+                for (auto const& material: materials) {
+                    if (material.diffuse_texname.empty())
+                        continue;
+                    auto texId = static_cast <uint32_t> (texIdPool.size());
+                    m_texIds.push_back (texIdPool.emplace (material.diffuse_texname, texId).first->second);
+                }
+                m_quadIndex = 0;
+                m_uniqueVertices.reset (indicesCount);
+                indices.reserve (indicesCount);
+            }
+
+            /* The default texture's uv mapping starts over with every shape
+            */
+            void beginShape (void) {
+                m_quadIndex = 0;
+            }
+
+            void addVertex (Core::Vertex& vertex, int32_t materialId) {
+                const glm::vec2 defaultTexCoords[] = {
+                    {0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 0.0f},
+                    {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}
+                };
+                uint32_t localTexId = static_cast <uint32_t> (materialId + 1);
+                vertex.texId        = localTexId < m_texIds.size() ? m_texIds[localTexId]: 0;
+                if (vertex.texId == 0) {
+                    vertex.texCoord = defaultTexCoords[m_quadIndex];
+                    m_quadIndex     = (m_quadIndex + 1) % 6;
+                }
+                indices.push_back (m_uniqueVertices.getIndex (vertex, vertices));
+            }
+    };
+
+    /* Read the model file with both the engine's parser and tinyobjloader, and check that they build the same vertices
+     * and indices (which covers the flipped texture coordinates, the default texture's uv mapping and triangulation).
+     * Returns false (and reports why) if they differ
+    */
+    bool checkOBJParser (const std::string& modelPath, const std::string& mtlFileDirPath) {
+        std::string warn, err;
+        Core::OBJParsedData parsedData;
+        if (!Core::VKOBJParser::loadOBJ (modelPath.c_str(), mtlFileDirPath.c_str(), parsedData, warn, err)) {
+            std::cerr << "[FAIL] " << modelPath << " native parser failed: " << err << std::endl;
+            return false;
+        }
+        std::vector <tinyobj::material_t> nativeMaterials;
+        for (auto const& parsedMaterial: parsedData.materials) {
+            tinyobj::material_t material;
+            material.name            = parsedMaterial.name;
+            material.diffuse_texname = parsedMaterial.diffuseTexturePath;
+            nativeMaterials.push_back (material);
+        }
+        BNOBJModelBuilder nativeModel (nativeMaterials, parsedData.corners.size());
+        size_t shapeIdx = 0;
+        for (size_t triangleIdx = 0; triangleIdx < parsedData.materialIds.size(); triangleIdx++) {
+            if (shapeIdx < parsedData.shapeFirstTriangles.size() &&
+                parsedData.shapeFirstTriangles[shapeIdx] == triangleIdx) {
+                nativeModel.beginShape();
+                shapeIdx++;
+            }
+            for (size_t i = 0; i < 3; i++) {
+                auto const& corner = parsedData.corners[triangleIdx * 3 + i];
+                Core::Vertex vertex {};
+                vertex.pos = {
+                                parsedData.positions[3 * corner.positionIdx + 0],
+                                parsedData.positions[3 * corner.positionIdx + 1],
+                                parsedData.positions[3 * corner.positionIdx + 2]
+                             };
+                if (corner.texCoordIdx >= 0)
+                    vertex.texCoord = {
+                                               parsedData.texCoords[2 * corner.texCoordIdx + 0],
+                                        1.0f - parsedData.texCoords[2 * corner.texCoordIdx + 1]
+                                      };
+                if (corner.normalIdx >= 0)
+                    vertex.normal   = {
+                                        parsedData.normals[3 * corner.normalIdx + 0],
+                                        parsedData.normals[3 * corner.normalIdx + 1],
+                                        parsedData.normals[3 * corner.normalIdx + 2]
+                                      };
+                nativeModel.addVertex (vertex, parsedData.materialIds[triangleIdx]);
+            }
+        }
+
+        tinyobj::attrib_t attrib;
+        std::vector <tinyobj::shape_t> shapes;
+        std::vector <tinyobj::material_t> materials;
+        if (!tinyobj::LoadObj (&attrib, &shapes, &materials, &warn, &err,
+                               modelPath.c_str(), mtlFileDirPath.c_str())) {
+            std::cerr << "[FAIL] " << modelPath << " tinyobjloader failed: " << err << std::endl;
+            return false;
+        }
+        size_t indicesCount = 0;
+        for (auto const& shape: shapes)
+            indicesCount += shape.mesh.indices.size();
+        BNOBJModelBuilder tinyobjModel (materials, indicesCount);
+        for (auto const& shape: shapes) {
+            tinyobjModel.beginShape();
+            for (size_t i = 0; i < shape.mesh.indices.size(); i++) {
+                auto const& index = shape.mesh.indices[i];
+                Core::Vertex vertex {};
+                vertex.pos = {
+                                attrib.vertices[3 * index.vertex_index + 0],
+                                attrib.vertices[3 * index.vertex_index + 1],
+                                attrib.vertices[3 * index.vertex_index + 2]
+                             };
+                if (index.texcoord_index >= 0)
+                    vertex.texCoord = {
+                                               attrib.texcoords[2 * index.texcoord_index + 0],
+                                        1.0f - attrib.texcoords[2 * index.texcoord_index + 1]
+                                      };
+                if (index.normal_index >= 0)
+                    vertex.normal   = {
+                                        attrib.normals[3 * index.normal_index + 0],
+                                        attrib.normals[3 * index.normal_index + 1],
+                                        attrib.normals[3 * index.normal_index + 2]
+                                      };
+                tinyobjModel.addVertex (vertex, shape.mesh.material_ids[i / 3]);
+            }
+        }
+
+        if (nativeModel.vertices.size() != tinyobjModel.vertices.size() ||
+            nativeModel.indices.size()  != tinyobjModel.indices.size()) {
+            std::cerr << "[FAIL] " << modelPath << " native parser built "
+                      << nativeModel.vertices.size()  << " vertices, " << nativeModel.indices.size()  << " indices, "
+                      << "tinyobjloader built "
+                      << tinyobjModel.vertices.size() << " vertices, " << tinyobjModel.indices.size() << " indices"
+                      << std::endl;
+            return false;
+        }
+        for (size_t i = 0; i < nativeModel.vertices.size(); i++) {
+            if (!(nativeModel.vertices[i] == tinyobjModel.vertices[i])) {
+                std::cerr << "[FAIL] " << modelPath << " vertex " << i << " differs" << std::endl;
+                return false;
+            }
+        }
+        if (nativeModel.indices != tinyobjModel.indices) {
+            std::cerr << "[FAIL] " << modelPath << " indices differ" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /* Every asset, the generated grid of import_obj_grid_256 and the concave polygons of writePolygonModelFile
+    */
+    bool runOBJParserChecks (const char* assetDir, const char* saveDir) {
+        bool isEquivalent = true;
+        for (auto const& asset: getModelAssets (assetDir))
+            isEquivalent = checkOBJParser (asset.modelPath, asset.mtlFileDirPath) && isEquivalent;
+
+        for (auto const& name: {"BNModel_Grid", "BNModel_Polygon"}) {
+            std::string modelPath = std::string (saveDir) + name + ".obj";
+            if (name == std::string ("BNModel_Grid"))
+                writeGridModelFile    (saveDir, name, 256);
+            else
+                writePolygonModelFile (saveDir, name);
+            isEquivalent          = checkOBJParser (modelPath, saveDir) && isEquivalent;
+
+            remove (modelPath.c_str());
+            remove ((std::string (saveDir) + name + ".mtl").c_str());
+        }
+        return isEquivalent;
+    }
+
+    /* Check that the model matrices of createModelMatrices (batched, SIMD) and of VKModelMatrixBatch::getModelMatrix
+     * (one instance, scalar) are the same as glm::translate * glm::rotate * glm::scale, for random instances. Elements
+     * are compared with ==, which leaves out the sign of zero elements. Returns false (and reports why) if any of them
+     * differ
+    */
+    bool runModelMatrixChecks (const char* assetDir, const char* saveDir, uint32_t instancesCount) {
+        std::mt19937 generator (7);
+        std::uniform_real_distribution <float> positionDist (-1000.0f, 1000.0f);
+        std::uniform_real_distribution <float> axisDist     (-1.0f,    1.0f);
+        std::uniform_real_distribution <float> scaleDist    (0.01f,    100.0f);
+        std::uniform_real_distribution <float> angleDist    (-720.0f,  720.0f);
+        /* Every few instances rotate about a coordinate axis by a multiple of 90 degrees, where most of the rotation
+         * elements are zero
+        */
+        const glm::vec3 coordinateAxes[] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+
+        std::vector <Core::InstanceDataFormat::Record> records (instancesCount);
+        for (uint32_t i = 0; i < instancesCount; i++) {
+            auto& record = records[i];
+            for (int k = 0; k < 3; k++) {
+                record.position[k]   = positionDist (generator);
+                record.rotateAxis[k] = axisDist     (generator);
+                record.scale[k]      = scaleDist    (generator);
+            }
+            record.rotateAngleDeg    = angleDist    (generator);
+            if (i % 4 == 0) {
+                glm::vec3 axis       = coordinateAxes[(i / 4) % 3];
+                for (int k = 0; k < 3; k++)
+                    record.rotateAxis[k] = axis[k];
+                record.rotateAngleDeg    = static_cast <float> ((i / 12) % 8) * 90.0f;
+            }
+        }
+        std::string instanceDataPath = std::string (saveDir) + "BNModel_Matrix_Instances.bin";
+        writeInstanceDataBinaryFile (instanceDataPath, records);
+        /* Logs of the model manager go under the bench directory, like in runModelCases
+        */
+        const char* defaultLogSaveDirPath         = Core::g_collectionSettings.logSaveDirPath;
+        std::string logSaveDirPath                = std::string (saveDir) + "Core/";
+        std::filesystem::create_directories (logSaveDirPath);
+        Core::g_collectionSettings.logSaveDirPath = logSaveDirPath.c_str();
+
+        bool isIdentical = true;
+        {
+            BNModelMgr modelMgr;
+            auto assets = getModelAssets (assetDir);
+            modelMgr.readyModelInfo     (0, assets[0].modelPath.c_str(), assets[0].mtlFileDirPath.c_str());
+            modelMgr.importInstanceData (0, instanceDataPath.c_str());
+            auto modelInfo = modelMgr.getModelInfo (0);
+
+            auto isSame = [](const glm::mat4& a, const glm::mat4& b) {
+                for (int i = 0; i < 4; i++) {
+                    for (int j = 0; j < 4; j++) {
+                        if (!(a[i][j] == b[i][j]))
+                            return false;
+                    }
+                }
+                return true;
+            };
+            for (uint32_t i = 0; i < instancesCount && isIdentical; i++) {
+                auto const& instanceData = modelInfo->meta.instanceDatas[i];
+                glm::mat4 expected       = glm::translate (glm::mat4 (1.0f), instanceData.position) *
+                                           glm::rotate    (glm::mat4 (1.0f),
+                                                           glm::radians (instanceData.rotateAngleDeg),
+                                                           instanceData.rotateAxis) *
+                                           glm::scale     (glm::mat4 (1.0f), instanceData.scale);
+
+                if (!isSame (modelInfo->meta.modelMatrices[i], expected)) {
+                    std::cerr << "[FAIL] createModelMatrices differs from glm at instance " << i << std::endl;
+                    isIdentical = false;
+                }
+                glm::mat4 modelMatrix    = Core::VKModelMatrixBatch::getModelMatrix (instanceData.position,
+                                                                                     instanceData.rotateAxis,
+                                                                                     instanceData.scale,
+                                                                                     instanceData.rotateAngleDeg);
+                if (!isSame (modelMatrix, expected)) {
+                    std::cerr << "[FAIL] getModelMatrix differs from glm at instance " << i << std::endl;
+                    isIdentical = false;
+                }
+            }
+            modelMgr.cleanUp (0);
+        }
+        remove (instanceDataPath.c_str());
+        std::filesystem::remove_all (logSaveDirPath);
+        Core::g_collectionSettings.logSaveDirPath = defaultLogSaveDirPath;
+        return isIdentical;
+    }
+
+    void runModelCases (BNHarness& harness,
+                        const char* assetDir,
+                        const char* saveDir,
+                        uint64_t importIterations,
+                        uint32_t instancesCount) {
+
+        /* The parsed data logs of every import are written under the bench directory, and removed once done
+        */
+        const char* defaultLogSaveDirPath         = Core::g_collectionSettings.logSaveDirPath;
+        std::string logSaveDirPath                = std::string (saveDir) + "Core/";
+        std::filesystem::create_directories (logSaveDirPath);
+        Core::g_collectionSettings.logSaveDirPath = logSaveDirPath.c_str();
+        /* Model cache files go to their own directory, which is cleared ahead of every cold import so that those cases
+         * measure the full parse (and the cache write)
+        */
+        const char* defaultModelCacheDirPath   = Core::g_coreSettings.modelCacheDirPath;
+        std::string modelCacheDirPath          = std::string (saveDir) + "Cache/";
+        std::filesystem::create_directories (modelCacheDirPath);
+        Core::g_coreSettings.modelCacheDirPath = modelCacheDirPath.c_str();
+        auto clearModelCache = [&]() {
+            std::filesystem::remove_all         (modelCacheDirPath);
+            std::filesystem::create_directories  (modelCacheDirPath);
+        };
+
+        auto assets = getModelAssets (assetDir);
+        {
+            BNModelMgr modelMgr;
+            /* |----------------------------------------------------------------------------------------------------|
+             * | IMPORT OBJ MODEL                                                                                   |
+             * |----------------------------------------------------------------------------------------------------|
+            */
+            uint32_t modelInfoId = 0;
+            for (auto const& asset: assets) {
+                std::string name = "import_obj_" + asset.name;
+                auto& result     = harness.runCase ("model", name.c_str(), importIterations, [&](uint64_t) {
+                    clearModelCache();
+                    modelMgr.readyModelInfo (modelInfoId, asset.modelPath.c_str(), asset.mtlFileDirPath.c_str());
+                    modelMgr.importOBJModel (modelInfoId);
+                    modelMgr.cleanUp        (modelInfoId);
+                });
+                /* Bytes per op is the size of the model file read
+                */
+                result.bytes = asset.fileSize * importIterations;
+            }
+            /* High polygon model, generated since the assets are all fairly small
+            */
+            {
+                std::string name      = "BNModel_Grid";
+                std::string modelPath = std::string (saveDir) + name + ".obj";
+                writeGridModelFile (saveDir, name, 256);
+
+                auto& result          = harness.runCase ("model", "import_obj_grid_256", importIterations, [&](uint64_t) {
+                    clearModelCache();
+                    modelMgr.readyModelInfo (modelInfoId, modelPath.c_str(), saveDir);
+                    modelMgr.importOBJModel (modelInfoId);
+                    modelMgr.cleanUp        (modelInfoId);
+                });
+                result.bytes          = std::filesystem::file_size (modelPath) * importIterations;
+
+                remove (modelPath.c_str());
+                remove ((std::string (saveDir) + name + ".mtl").c_str());
+            }
+            /* All models at once, one after the other and on the worker pool
+            */
+            std::vector <uint32_t> modelInfoIds (assets.size());
+            uint64_t assetsFileSize = 0;
+            for (size_t i = 0; i < assets.size(); i++) {
+                modelInfoIds[i]  = modelInfoId + static_cast <uint32_t> (i);
+                assetsFileSize  += assets[i].fileSize;
+            }
+            auto readyModelInfos = [&]() {
+                for (size_t i = 0; i < assets.size(); i++)
+                    modelMgr.readyModelInfo (modelInfoIds[i],
+                                             assets[i].modelPath.c_str(),
+                                             assets[i].mtlFileDirPath.c_str());
+            };
+            auto cleanUpModelInfos = [&]() {
+                for (auto const& infoId: modelInfoIds)
+                    modelMgr.cleanUp (infoId);
+            };
+
+            auto& serialResult   = harness.runCase ("model", "import_obj_all", importIterations, [&](uint64_t) {
+                clearModelCache();
+                readyModelInfos();
+                for (auto const& infoId: modelInfoIds)
+                    modelMgr.importOBJModel (infoId);
+                cleanUpModelInfos();
+            });
+            serialResult.bytes   = assetsFileSize * importIterations;
+
+            auto& parallelResult = harness.runCase ("model", "import_obj_all_parallel", importIterations, [&](uint64_t) {
+                clearModelCache();
+                readyModelInfos();
+                modelMgr.importOBJModels (modelInfoIds);
+                cleanUpModelInfos();
+            });
+            parallelResult.bytes = assetsFileSize * importIterations;
+            /* Warm cache, the last parallel import above has left a cache file behind for every model
+            */
+            auto& cachedResult   = harness.runCase ("model", "import_obj_all_cached", importIterations, [&](uint64_t) {
+                readyModelInfos();
+                modelMgr.importOBJModels (modelInfoIds);
+                cleanUpModelInfos();
+            });
+            cachedResult.bytes   = assetsFileSize * importIterations;
+            /* Keep one copy of every model around for the instance cases
+            */
+            readyModelInfos();
+            modelMgr.importOBJModels (modelInfoIds);
+            modelInfoId += static_cast <uint32_t> (assets.size());
+            /* |----------------------------------------------------------------------------------------------------|
+             * | IMPORT INSTANCE DATA                                                                               |
+             * |----------------------------------------------------------------------------------------------------|
+            */
+            harness.runCase ("model", "import_instance_data", importIterations * assets.size(), [&](uint64_t i) {
+                size_t assetIdx = i % assets.size();
+                modelMgr.importInstanceData (modelInfoIds[assetIdx], assets[assetIdx].instanceDataPath.c_str());
+            });
+            /* Model with a large number of instances, sharing the first asset's model file (its vertices are not
+             * needed)
+            */
+            std::string instanceDataPath = std::string (saveDir) + "BNModel_Instances.json";
+            writeInstanceDataFile (instanceDataPath, instancesCount);
+
+            uint32_t largeModelInfoId = modelInfoId++;
+            modelMgr.readyModelInfo (largeModelInfoId, assets[0].modelPath.c_str(), assets[0].mtlFileDirPath.c_str());
+            auto& jsonResult   = harness.runCase ("model", "import_instance_data_large", importIterations, [&](uint64_t) {
+                modelMgr.importInstanceData (largeModelInfoId, instanceDataPath.c_str());
+            });
+            jsonResult.bytes   = std::filesystem::file_size (instanceDataPath) * importIterations;
+
+            std::string binaryInstanceDataPath = std::string (saveDir) + "BNModel_Instances.bin";
+            writeInstanceDataBinaryFile (binaryInstanceDataPath, instancesCount);
+
+            auto& binaryResult = harness.runCase ("model", "import_instance_data_large_binary", importIterations,
+                                                  [&](uint64_t) {
+                modelMgr.importInstanceData (largeModelInfoId, binaryInstanceDataPath.c_str());
+            });
+            binaryResult.bytes = std::filesystem::file_size (binaryInstanceDataPath) * importIterations;
+            /* Scene scale instance counts (tens of thousands of track and scenery pieces), on a model of their own so
+             * that the cases below are not affected
+            */
+            std::string hugeInstanceDataPath       = std::string (saveDir) + "BNModel_Huge_Instances.json";
+            std::string hugeBinaryInstanceDataPath = std::string (saveDir) + "BNModel_Huge_Instances.bin";
+            uint32_t hugeInstancesCount            = instancesCount * 32;
+            writeInstanceDataFile       (hugeInstanceDataPath,       hugeInstancesCount);
+            writeInstanceDataBinaryFile (hugeBinaryInstanceDataPath, hugeInstancesCount);
+
+            uint32_t hugeModelInfoId = modelInfoId++;
+            modelMgr.readyModelInfo (hugeModelInfoId, assets[0].modelPath.c_str(), assets[0].mtlFileDirPath.c_str());
+            auto& hugeJsonResult   = harness.runCase ("model", "import_instance_data_huge", importIterations,
+                                                      [&](uint64_t) {
+                modelMgr.importInstanceData (hugeModelInfoId, hugeInstanceDataPath.c_str());
+            });
+            hugeJsonResult.bytes   = std::filesystem::file_size (hugeInstanceDataPath) * importIterations;
+
+            auto& hugeBinaryResult = harness.runCase ("model", "import_instance_data_huge_binary", importIterations,
+                                                      [&](uint64_t) {
+                modelMgr.importInstanceData (hugeModelInfoId, hugeBinaryInstanceDataPath.c_str());
+            });
+            hugeBinaryResult.bytes = std::filesystem::file_size (hugeBinaryInstanceDataPath) * importIterations;
+            modelMgr.cleanUp (hugeModelInfoId);
+            modelInfoIds.push_back (largeModelInfoId);
+            /* |----------------------------------------------------------------------------------------------------|
+             * | MODEL MATRIX                                                                                       |
+             * |----------------------------------------------------------------------------------------------------|
+            */
+            harness.runCase ("model", "create_model_matrix", instancesCount * 100, [&](uint64_t i) {
+                modelMgr.createModelMatrix (largeModelInfoId, static_cast <uint32_t> (i % instancesCount));
+            });
+            harness.runCase ("model", "create_model_matrices", 100, [&](uint64_t) {
+                modelMgr.createModelMatrices (largeModelInfoId);
+            });
+            /* |----------------------------------------------------------------------------------------------------|
+             * | PER FRAME INSTANCE WRITES                                                                          |
+             * |----------------------------------------------------------------------------------------------------|
+            */
+            /* A vector stands in for the mapped storage buffer. Bytes per op is what is written to it
+            */
+            modelMgr.readyInstanceArena (modelInfoIds);
+            std::vector <Core::InstanceDataSSBO> mappedBuffer (modelMgr.getInstanceArenaSize());
+            size_t sink = 0;
+            uint64_t writeBytes = 0;
+            auto& writeResult   = harness.runCase ("model", "write_instances", 1000, [&](uint64_t) {
+                writeBytes += modelMgr.writeInstances (modelInfoIds, mappedBuffer.data());
+            });
+            writeResult.bytes   = writeBytes;
+#if ENABLE_MESH_LOD
+            /* Camera placed at the edge of the instance grid, so that the instances spread over all the levels
+            */
+            harness.runCase ("model", "order_instances_lod", 1000, [&](uint64_t) {
+                modelMgr.orderInstancesByLOD (modelInfoIds, glm::vec3 (0.0f, 10.0f, 0.0f));
+                sink += modelMgr.getModelInfo (largeModelInfoId)->meta.lodInstancesCounts[0];
+            });
+#endif  // ENABLE_MESH_LOD
+            /* Per frame storage buffer writes with one instance moving every frame (a vehicle)
+            */
+            {
+                auto write = [&](BNModelMgr::InstanceSlotTracker* tracker) {
+#if ENABLE_MESH_LOD
+                    modelMgr.orderInstancesByLOD (modelInfoIds, glm::vec3 (0.0f, 10.0f, 0.0f));
+#endif  // ENABLE_MESH_LOD
+                    return modelMgr.writeInstances (modelInfoIds, mappedBuffer.data(), tracker);
+                };
+
+                uint64_t fullBytes = 0;
+                auto& fullResult   = harness.runCase ("model", "upload_instances_full", 1000, [&](uint64_t) {
+                    modelMgr.createModelMatrix (largeModelInfoId, 0);
+                    fullBytes += write (nullptr);
+                });
+                fullResult.bytes   = fullBytes;
+
+                std::vector <std::vector <uint64_t>> slotKeys (Core::g_coreSettings.maxFramesInFlight);
+                uint64_t dirtyBytes = 0;
+                auto& dirtyResult   = harness.runCase ("model", "upload_instances_dirty", 1000, [&](uint64_t i) {
+                    BNModelMgr::InstanceSlotTracker tracker;
+                    tracker.frameInFlight = static_cast <uint32_t> (i % Core::g_coreSettings.maxFramesInFlight);
+                    tracker.slotKeys      = &slotKeys[tracker.frameInFlight];
+
+                    modelMgr.createModelMatrix (largeModelInfoId, 0);
+                    dirtyBytes += write (&tracker);
+                });
+                dirtyResult.bytes   = dirtyBytes;
+            }
+            /* Static instance data writes to the staging buffer with one instance changing its textures every frame.
+             * The first write holds every instance's static data
+            */
+            {
+                std::vector <Core::StaticInstanceDataSSBO> stagingBuffer (modelMgr.getInstanceArenaSize());
+                std::vector <VkBufferCopy> copyRegions;
+                uint64_t initialBytes = modelMgr.writeStaticInstances (modelInfoIds, stagingBuffer.data(), copyRegions);
+
+                auto modelInfo       = modelMgr.getModelInfo (largeModelInfoId);
+                uint64_t staticBytes = 0;
+                auto& staticResult   = harness.runCase ("model", "upload_static_instances", 1000, [&](uint64_t i) {
+                    uint32_t modelInstanceId = static_cast <uint32_t> (i % modelInfo->meta.instancesCount);
+                    modelInfo->meta.staticInstances[modelInstanceId].texIdLUT[0] ^= 1;
+                    BNModelMgr::setStaticInstanceDirty (modelInfo, modelInstanceId);
+
+                    copyRegions.clear();
+                    staticBytes += modelMgr.writeStaticInstances (modelInfoIds, stagingBuffer.data(), copyRegions);
+                    sink        += copyRegions.size();
+                });
+                staticResult.bytes   = staticBytes;
+
+                std::cout << "[INFO] upload_static_instances initial bytes " << initialBytes
+                          << std::endl;
+            }
+#if ENABLE_MESHLET_CULLING
+            /* Every instance at full detail, seen from above one corner of the instance grid. Bytes per op is the index
+             * data drawn after culling
+            */
+            {
+                glm::vec3 cameraPosition = glm::vec3 (-20.0f, 30.0f, -20.0f);
+                glm::mat4 projection     = glm::perspective (glm::radians (45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+                projection[1][1]        *= -1;
+                auto frustum             = Core::VKMeshlet::getFrustum (projection *
+                                                                        glm::lookAt (cameraPosition,
+                                                                                     glm::vec3 (60.0f, 0.0f, 60.0f),
+                                                                                     glm::vec3 (0.0f, 1.0f, 0.0f)));
+                std::vector <BNModelMgr::MeshletDraw> draws;
+                uint64_t totalIndicesCount = 0;
+                uint64_t drawnIndicesCount = 0;
+                auto& result = harness.runCase ("model", "cull_meshlets", 1000, [&](uint64_t) {
+                    drawnIndicesCount = 0;
+                    totalIndicesCount = 0;
+                    for (auto const& infoId: modelInfoIds) {
+                        auto modelInfo = modelMgr.getModelInfo (infoId);
+                        draws.clear();
+                        modelMgr.cullMeshlets (infoId,
+                                               modelInfo->meta.instancesCount,
+                                               frustum,
+                                               cameraPosition,
+                                               draws);
+                        for (auto const& draw: draws)
+                            drawnIndicesCount += static_cast <uint64_t> (draw.indicesCount) * draw.instancesCount;
+                        totalIndicesCount     += static_cast <uint64_t> (modelInfo->meta.indicesCount) *
+                                                                         modelInfo->meta.instancesCount;
+                        sink                  += draws.size();
+                    }
+                });
+                result.bytes = drawnIndicesCount * sizeof (uint32_t) * 1000;
+
+                std::cout << "[INFO] cull_meshlets indices " << totalIndicesCount
+                          << " -> "                          << drawnIndicesCount
+                          << std::endl;
+            }
+#endif  // ENABLE_MESHLET_CULLING
+
+            for (auto const& infoId: modelInfoIds)
+                modelMgr.cleanUp (infoId);
+            remove (instanceDataPath.c_str());
+            remove (binaryInstanceDataPath.c_str());
+            remove (hugeInstanceDataPath.c_str());
+            remove (hugeBinaryInstanceDataPath.c_str());
+
+            if (sink == 0)
+                std::cerr << "[WARNING] model cases produced no output" << std::endl;
+        }
+        std::filesystem::remove_all (logSaveDirPath);
+        std::filesystem::remove_all (modelCacheDirPath);
+        Core::g_collectionSettings.logSaveDirPath = defaultLogSaveDirPath;
+        Core::g_coreSettings.modelCacheDirPath    = defaultModelCacheDirPath;
+    }
+}   // namespace Bench
+#endif  // BN_MODEL_H
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "Case/BNBuffer.h"
+#include "Case/BNLogHeader.h"
+#include "Case/BNLogSink.h"
+#include "Case/BNLogStress.h"
+#include "Case/BNModel.h"
+
+int main (void) {
+    Bench::BNHarness harness;
+    Bench::runBufferCases        (harness, 1000000);
+    Bench::runLogHeaderCases     (harness, "Build/Log/Bench/", 200000);
+    Bench::runLogSinkCases       (harness, "Build/Log/Bench/", 200000);
+    bool isIntact =
+    Bench::runLogStressCases     (harness, "Build/Log/Bench/", 8, 20000);
+    isIntact = Bench::runOBJParserChecks ("Asset/Model/", "Build/Log/Bench/") && isIntact;
+    isIntact = Bench::runModelMatrixChecks ("Asset/Model/", "Build/Log/Bench/", 100000) && isIntact;
+    Bench::runModelCases         (harness, "Asset/Model/", "Build/Log/Bench/", 10, 4096);
+    Bench::runVertexDedupCases   (harness, 64,  100);
+    Bench::runVertexDedupCases   (harness, 512, 10);
+    Bench::runMeshOptimizerCases (harness, 256, 10);
+    isIntact = Bench::runCompactVertexCases (harness, 128, 100) && isIntact;
+    isIntact = Bench::runMeshSimplifierCases (harness, 256, 10) && isIntact;
+    isIntact = Bench::runMeshletCases (harness, 256, 10) && isIntact;
+
+    harness.printResults (std::cout);
+    if (!harness.writeResultsJson ("Build/Log/Bench/results.json"))
+        std::cerr << "[ERROR] Failed to write results json" << std::endl;
+    return isIntact ? 0: 1;
+}
\ No newline at end of file
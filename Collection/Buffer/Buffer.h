@@ -6,15 +6,29 @@
 #define BUFFER_INIT(id,                                                                                         \
                     type,                                                                                       \
                     dataType,                                                                                   \
-                    capacity)                   Buffer::g_bufferMgr.createBuffer <dataType> (id, type, capacity)
+                    capacity)                   Buffer::g_bufferMgr.createBuffer <type, dataType> (id, capacity)
+/* Buffer whose contents are always contiguous in memory, see e_bufferBacking
+*/
+#define BUFFER_INIT_MIRRORED(id,                                                                                \
+                             type,                                                                              \
+                             dataType,                                                                          \
+                             capacity)          Buffer::g_bufferMgr.createBuffer <type, dataType> (id,          \
+                                                                                                   capacity,    \
+                                                                                                   Buffer::MIRRORED)
 #define GET_BUFFER(id, dataType)                dynamic_cast <Buffer::BufferImpl <dataType> *>                  \
                                                 (Buffer::g_bufferMgr.getInstance (id))
+/* Lock free buffers (SPSC_LOCK_FREE, MPMC_LOCK_FREE) are fetched by type, since they are implemented by different
+ * classes
+*/
+#define GET_TYPED_BUFFER(id, type, dataType)    dynamic_cast <Buffer::BufferTypeImpl <type, dataType>::impl *>  \
+                                                (Buffer::g_bufferMgr.getInstance (id))
 #define BUFFER_CLOSE(id)                        Buffer::g_bufferMgr.closeInstance (id)
 #define BUFFER_CLOSE_ALL                        Buffer::g_bufferMgr.closeAllInstances()
 #define BUFFER_MGR_DUMP                         Buffer::g_bufferMgr.dump (std::cout)
 
 #define BUFFER_PUSH(data)                       push (data)
 #define BUFFER_POP_FIRST                        popFirst()
+#define BUFFER_TRY_POP(data)                    tryPop (data)
 #define BUFFER_POP_LAST                         popLast()
 #define BUFFER_FLUSH(stream)                    flush (stream)
 #define BUFFER_PEEK_FIRST                       getFirst()
@@ -1,131 +1,317 @@
 #ifndef BUFFER_IMPL_H
 #define BUFFER_IMPL_H
 
+#include <span>
+#include <memory>
+#include <new>
+#include <cstring>
+#include <string_view>
+#include <algorithm>
 #include "../InstanceMgr.h"
+#include "MirroredMemory.h"
 
 namespace Collection {
 namespace Buffer {
+    /* SPSC_LOCK_FREE and MPMC_LOCK_FREE buffers are safe to share between threads, see SPSCBufferImpl and
+     * MPMCBufferImpl
+    */
     typedef enum {
         WITH_OVERFLOW    = 0,
-        WITHOUT_OVERFLOW = 1
+        WITHOUT_OVERFLOW = 1,
+        SPSC_LOCK_FREE   = 2,
+        MPMC_LOCK_FREE   = 3
     } e_bufferType;
 
+    /* Storage of a BufferImpl, MIRRORED maps the storage twice back to back (see MirroredMemory) so that the contents
+     * are always one contiguous range. This is only available for trivially copyable data types, and the capacity is
+     * rounded up so that the storage fills whole pages
+    */
+    typedef enum {
+        HEAP             = 0,
+        MIRRORED         = 1
+    } e_bufferBacking;
+
     template <typename T>
     class BufferImpl: public Admin::NonTemplateBase {
         private:
             uint32_t m_instanceId;
             e_bufferType m_type;
             size_t m_capacity;
-            size_t m_numItems;
-
+            /* Storage is rounded up to a power of 2 so that a position maps to its slot with a mask. Head and tail are
+             * free running positions (not wrapped), the number of items is their difference and never exceeds the
+             * capacity asked for
+            */
+            size_t m_numSlots;
+            size_t m_mask;
+            size_t m_head;
+            size_t m_tail;
+            /* Storage is left uninitialized, slots are constructed the first time they are pushed to. Since the head
+             * only ever moves a slot at a time, the constructed slots are always the first m_numConstructed slots.
+             * Popped items are left alive in their slot (popFirst/popLast hand out a pointer to it), they are
+             * destroyed when the slot is overwritten or the buffer is destroyed
+            */
+            size_t m_numConstructed;
             T* m_buffer;
-            T* m_head;
-            T* m_tail;
-            T* m_end;
+            MirroredMemory m_mirroredMemory;
+            bool m_isMirrored;
+
+            static size_t roundUpToPowerOf2 (size_t value) {
+                size_t result = 1;
+                while (result < value)
+                    result <<= 1;
+                return result;
+            }
+
+            /* Smallest power of 2 slot count that holds the capacity and fills whole pages
+            */
+            static size_t getMirroredNumSlots (size_t capacity) {
+                size_t numSlots = roundUpToPowerOf2 (capacity);
+                while ((numSlots * sizeof (T)) % MirroredMemory::getPageSize() != 0)
+                    numSlots <<= 1;
+                return numSlots;
+            }
+
+            inline T* getSlot (size_t pos) {
+                return m_buffer + (pos & m_mask);
+            }
+
+            inline size_t getNumItems (void) {
+                return m_head - m_tail;
+            }
 
             inline bool isEmpty (void) {
-                return m_numItems == 0;
+                return m_head == m_tail;
             }
 
             inline bool isFull (void) {
-                return m_numItems == m_capacity;
+                return getNumItems() == m_capacity;
+            }
+
+            /* Slot at head is ready to be written to, either by assignment (constructed) or construction
+            */
+            template <typename... Args>
+            void writeSlot (Args&&... args) {
+                size_t slotIdx = m_head & m_mask;
+                if (slotIdx < m_numConstructed) {
+                    if constexpr (sizeof... (Args) == 1 && (std::is_same_v <std::remove_cvref_t <Args>, T> && ...))
+                        m_buffer[slotIdx] = (std::forward <Args> (args), ...);
+                    else
+                        m_buffer[slotIdx] = T (std::forward <Args> (args)...);
+                }
+                else {
+                    new (m_buffer + slotIdx) T (std::forward <Args> (args)...);
+                    m_numConstructed = slotIdx + 1;
+                }
+            }
+
+            /* Claim the slot at head, returns false if there is no room (only when overflow is disabled)
+            */
+            template <typename... Args>
+            bool pushImpl (Args&&... args) {
+                /* Always push when in overflow enabled mode
+                */
+                if (isFull() && m_type != WITH_OVERFLOW)
+                    return false;
+
+                writeSlot (std::forward <Args> (args)...);
+                m_head++;
+                /* If num items is greater than capacity, that means we have overflowed over the oldest element, so
+                 * we need to move the tail (pointing to the oldest element) forward
+                */
+                if (getNumItems() > m_capacity)
+                    m_tail++;
+                return true;
+            }
+
+            /* Copy count items into the slots starting at position pos, in at most 2 chunks. Only used for trivially
+             * copyable types, which are also trivially destructible, so the slots need not be tracked as constructed
+            */
+            void copyIn (size_t pos, const T* data, size_t count) {
+                size_t slotIdx   = pos & m_mask;
+                if (m_isMirrored) {
+                    memcpy (m_buffer + slotIdx, data, count * sizeof (T));
+                    return;
+                }
+                size_t firstPart = std::min (count, m_numSlots - slotIdx);
+                memcpy (m_buffer + slotIdx, data,             firstPart           * sizeof (T));
+                memcpy (m_buffer,           data + firstPart, (count - firstPart) * sizeof (T));
             }
 
         public:
-            BufferImpl (uint32_t instanceId, e_bufferType type, size_t capacity) {
-                m_instanceId = instanceId;
-                m_type       = type;
-                m_capacity   = capacity;
-                m_numItems   = 0;
-                m_buffer     = new T[capacity];
-                m_head       = m_buffer;
-                m_tail       = m_buffer;
-                m_end        = m_buffer + m_capacity - 1;
+            BufferImpl (uint32_t instanceId, e_bufferType type, size_t capacity, e_bufferBacking backing = HEAP) {
+                m_instanceId     = instanceId;
+                m_type           = type;
+                m_capacity       = capacity;
+                m_head           = 0;
+                m_tail           = 0;
+                m_numConstructed = 0;
+                m_isMirrored     = false;
+
+                if (backing == MIRRORED) {
+                    if (!std::is_trivially_copyable_v <T>)
+                        throw std::runtime_error ("Mirrored backing requires a trivially copyable data type");
+                    /* Fall back to heap storage if the pages could not be mapped
+                    */
+                    m_numSlots   = getMirroredNumSlots (capacity);
+                    m_isMirrored = m_mirroredMemory.map (m_numSlots * sizeof (T));
+                }
+
+                if (m_isMirrored)
+                    m_buffer     = static_cast <T*> (m_mirroredMemory.getBase());
+                else {
+                    m_numSlots   = roundUpToPowerOf2 (capacity);
+                    m_buffer     = static_cast <T*> (::operator new (m_numSlots * sizeof (T),
+                                                                     std::align_val_t (alignof (T))));
+                }
+                m_mask           = m_numSlots - 1;
             }
 
             ~BufferImpl (void) {
-                delete[] m_buffer;
+                std::destroy_n (m_buffer, m_numConstructed);
+                /* Mirrored storage is unmapped along with m_mirroredMemory
+                */
+                if (!m_isMirrored)
+                    ::operator delete (m_buffer, std::align_val_t (alignof (T)));
             }
 
+            BufferImpl (const BufferImpl&)             = delete;
+            BufferImpl& operator = (const BufferImpl&) = delete;
+
+            /* If push fails due to maximum capacity, do nothing
+            */
             void push (const T& data) {
-                /* Always push when in overflow enabled mode
-                */
-                if (!isFull() || m_type == WITH_OVERFLOW) {
-                    *m_head = data;
-                    m_numItems++;
-                    /* When head pointer is at the end of the buffer
-                    */
-                    m_head = m_head == m_end ? m_buffer: m_head + 1;
-                    /* If num items is greater than capacity, that means we have overflowed over the oldest element, so
-                     * we need to update the tail pointer (pointing to the oldest element) and correct num items
+                pushImpl (data);
+            }
+
+            void push (T&& data) {
+                pushImpl (std::move (data));
+            }
+
+            /* Construct the item in place from the passed in arguments, returns false if the buffer is full (only when
+             * overflow is disabled)
+            */
+            template <typename... Args>
+            bool emplace (Args&&... args) {
+                return pushImpl (std::forward <Args> (args)...);
+            }
+
+            /* Push items in order, as if each was pushed on its own. Returns the number of items pushed, which is less
+             * than the number passed in only when overflow is disabled and the buffer fills up. For trivially copyable
+             * types this is at most 2 memcpy calls
+            */
+            size_t pushN (std::span <const T> data) {
+                size_t count = data.size();
+                if (m_type != WITH_OVERFLOW)
+                    count = std::min (count, getAvailability());
+
+                if constexpr (std::is_trivially_copyable_v <T>) {
+                    /* When overflowing, only the last capacity items survive so the rest need not be copied
                     */
-                    if (m_type == WITH_OVERFLOW && m_numItems > m_capacity) {
-                        m_tail = m_tail == m_end ? m_buffer: m_tail + 1;
-                        /* Correct num items
-                        */
-                        m_numItems--;
-                    }
+                    size_t skipped = count > m_capacity ? count - m_capacity: 0;
+                    m_head        += skipped;
+                    copyIn (m_head, data.data() + skipped, count - skipped);
+                    m_head        += count - skipped;
+                    if (getNumItems() > m_capacity)
+                        m_tail = m_head - m_capacity;
                 }
-                /* If push fails due to maximum capacity, do nothing
-                */
-                else
-                    ;
+                else {
+                    for (size_t i = 0; i < count; i++)
+                        pushImpl (data[i]);
+                }
+                return count;
+            }
+
+            /* Pop the oldest items into the passed in span, returns the number of items popped. For trivially copyable
+             * types this is at most 2 memcpy calls
+            */
+            size_t popN (std::span <T> data) {
+                size_t count = std::min (data.size(), getNumItems());
+                if constexpr (std::is_trivially_copyable_v <T>) {
+                    size_t slotIdx   = m_tail & m_mask;
+                    size_t firstPart = m_isMirrored ? count: std::min (count, m_numSlots - slotIdx);
+                    memcpy (data.data(),             m_buffer + slotIdx, firstPart           * sizeof (T));
+                    memcpy (data.data() + firstPart, m_buffer,           (count - firstPart) * sizeof (T));
+                }
+                else {
+                    for (size_t i = 0; i < count; i++)
+                        data[i] = std::move (*getSlot (m_tail + i));
+                }
+                m_tail += count;
+                return count;
             }
 
             T* popFirst (void) {
                 T* data = nullptr;
 
-                if (!isEmpty()) {
-                    data = m_tail;
-                    m_numItems--;
-                    /* When tail pointer is at the end of the buffer
-                    */
-                    m_tail = m_tail == m_end ? m_buffer: m_tail + 1;
-                }
+                if (!isEmpty())
+                    data = getSlot (m_tail++);
                 return data;
             }
 
             T* popLast (void) {
                 T* data = nullptr;
 
-                if (!isEmpty()) {
-                    /* When head pointer is at the head of the buffer
-                    */
-                    m_head = m_head == m_buffer ? m_end: m_head - 1;
-
-                    data = m_head;
-                    m_numItems--;
-                }
+                if (!isEmpty())
+                    data = getSlot (--m_head);
                 return data;
             }
 
-            void flush (std::ostream& ost) {
-                while (!isEmpty())
-                    ost << *popFirst() << "\n";
+            /* Contents of the buffer, oldest first, as 2 contiguous spans (the second one is empty unless the contents
+             * wrap around the end of the storage, which never happens with mirrored storage). The spans are valid until
+             * the buffer is modified
+            */
+            std::pair <std::span <T>, std::span <T>> getSpans (void) {
+                size_t numItems  = getNumItems();
+                size_t slotIdx   = m_tail & m_mask;
+                size_t firstPart = m_isMirrored ? numItems: std::min (numItems, m_numSlots - slotIdx);
+                return {std::span <T> (m_buffer + slotIdx, firstPart),
+                        std::span <T> (m_buffer,           numItems - firstPart)};
+            }
 
+            /* Byte buffers (char) are written out as raw bytes, every other data type is written an item per line
+            */
+            void flush (std::ostream& ost) {
+                auto [first, second] = getSpans();
+                for (auto const& span: {first, second}) {
+                    if constexpr (std::is_same_v <T, char>) {
+                        ost.write (span.data(), static_cast <std::streamsize> (span.size()));
+                        continue;
+                    }
+                    for (auto const& data: span) {
+                        /* Strings are written as is, without going through the formatted output path
+                        */
+                        if constexpr (std::is_convertible_v <const T&, std::string_view>) {
+                            std::string_view view (data);
+                            ost.write (view.data(), static_cast <std::streamsize> (view.size()));
+                            ost.put ('\n');
+                        }
+                        else
+                            ost << data << "\n";
+                    }
+                }
+                m_tail = m_head;
                 ost.flush();
             }
 
             inline T* getFirst (void) {
-                return isEmpty() ? nullptr: m_tail;
+                return isEmpty() ? nullptr: getSlot (m_tail);
             }
 
             inline T* getLast (void) {
-                return isEmpty() ? nullptr:
-                /* Head pointer will be at the start either when the buffer is empty, or when an item has been inserted at
-                 * the end and wrap around is complete
-                */
-                m_head == m_buffer ? m_end: (m_head - 1);
+                return isEmpty() ? nullptr: getSlot (m_head - 1);
             }
 
             inline size_t getAvailability (void) {
-                return m_capacity - m_numItems;
+                return m_capacity - getNumItems();
+            }
+
+            inline bool isMirrored (void) {
+                return m_isMirrored;
             }
 
             void reset (void) {
-                m_numItems = 0;
-                m_head     = m_buffer;
-                m_tail     = m_buffer;
+                m_head = 0;
+                m_tail = 0;
             }
 
             /* Buffer is displayed in the following format
@@ -147,9 +333,6 @@ namespace Buffer {
                        void (*lambda) (T*, std::ostream&) = [](T* readPtr, std::ostream& ost) {
                                                                 ost << *readPtr;
                                                             }) {
-                T* readPtr = m_tail;
-                size_t numItems = m_numItems;
-
                 ost << "Buffer: " << "\n";
                 ost << OPEN_L1;
 
@@ -157,21 +340,22 @@ namespace Buffer {
                 ost << TAB_L2 << "Availability: "   << getAvailability()    << "\n";
 
                 ost << TAB_L2 << "First: ";
-                if (m_numItems != 0)            lambda (getFirst(), ost);
+                if (!isEmpty())                 lambda (getFirst(), ost);
                 else                            ost << "NULL";
                 ost << "\n";
 
                 ost << TAB_L2 << "Last: ";
-                if (m_numItems != 0)            lambda (getLast(), ost);
+                if (!isEmpty())                 lambda (getLast(), ost);
                 else                            ost << "NULL";
                 ost << "\n";
 
                 ost << TAB_L2 << "Data: "           << "\n";
                 ost << OPEN_L3;
-                while (numItems != 0) {
-                ost << TAB_L4;                  lambda (readPtr, ost);  ost << "\n";
-                numItems--;
-                readPtr = readPtr == m_end ? m_buffer: readPtr + 1;
+                auto [first, second] = getSpans();
+                for (auto const& span: {first, second}) {
+                    for (auto& data: span) {
+                ost << TAB_L4;                  lambda (&data, ost);    ost << "\n";
+                    }
                 }
                 ost << CLOSE_L3;
 
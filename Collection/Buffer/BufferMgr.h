@@ -1,18 +1,47 @@
 #ifndef BUFFER_MGR_H
 #define BUFFER_MGR_H
 
-#include "BufferImpl.h"
+#include "SPSCBufferImpl.h"
+#include "MPMCBufferImpl.h"
 
 namespace Collection {
 namespace Buffer {
+    /* Buffer class that implements a buffer type, the type is known at compile time wherever a buffer is created or
+     * fetched, so this is resolved without any runtime dispatch
+    */
+    template <e_bufferType type, typename T>
+    struct BufferTypeImpl {
+        using impl = BufferImpl <T>;
+    };
+
+    template <typename T>
+    struct BufferTypeImpl <SPSC_LOCK_FREE, T> {
+        using impl = SPSCBufferImpl <T>;
+    };
+
+    template <typename T>
+    struct BufferTypeImpl <MPMC_LOCK_FREE, T> {
+        using impl = MPMCBufferImpl <T>;
+    };
+
     class BufferMgr: public Admin::InstanceMgr {
         public:
-            template <typename T>
-            BufferImpl <T>* createBuffer (uint32_t instanceId, e_bufferType type, size_t capacity) {
+            template <e_bufferType type, typename T>
+            typename BufferTypeImpl <type, T>::impl* createBuffer (uint32_t instanceId,
+                                                                   size_t capacity,
+                                                                   e_bufferBacking backing = HEAP) {
+                using impl = typename BufferTypeImpl <type, T>::impl;
                 /* Create and add buffer object to pool
                 */
                 if (m_instancePool.find (instanceId) == m_instancePool.end()) {
-                    BufferImpl <T>* c_buffer = new BufferImpl <T> (instanceId, type, capacity);
+                    impl* c_buffer;
+                    if constexpr (std::is_same_v <impl, BufferImpl <T>>)
+                        c_buffer = new impl (instanceId, type, capacity, backing);
+                    else {
+                        if (backing != HEAP)
+                            throw std::runtime_error ("Buffer type does not support this backing");
+                        c_buffer = new impl (instanceId, type, capacity);
+                    }
                     /* Upcasting
                     */
                     Admin::NonTemplateBase* c_instance = c_buffer;
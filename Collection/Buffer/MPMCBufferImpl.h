@@ -0,0 +1,183 @@
+#ifndef MPMC_BUFFER_IMPL_H
+#define MPMC_BUFFER_IMPL_H
+
+#include <atomic>
+#include <utility>
+#include <cstdint>
+#include "BufferImpl.h"
+
+namespace Collection {
+namespace Buffer {
+    /* Bounded multi producer multi consumer queue. Each slot carries a sequence number which tells producers and
+     * consumers whether the slot is ready to be written to or read from, so neither side ever takes a lock. The capacity
+     * is rounded up to a power of 2 so that the slot index can be computed with a mask instead of a modulo,
+     * reference: https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+     *
+     * Unlike BufferImpl, the buffer never overflows (push fails when full) and only the first item can be popped. Items
+     * are popped with tryPop into storage owned by the caller, there is no popFirst handing out a pointer since any
+     * number of threads may be popping from the buffer
+    */
+    template <typename T>
+    class MPMCBufferImpl: public Admin::NonTemplateBase {
+        private:
+            struct Slot {
+                std::atomic <size_t> sequence;
+                T data;
+            };
+            /* Keep the producer and consumer positions on separate cache lines, otherwise every push would invalidate
+             * the line the consumers are popping from (false sharing)
+            */
+            static constexpr size_t CACHE_LINE_SIZE = 64;
+
+            uint32_t m_instanceId;
+            e_bufferType m_type;
+            Slot* m_buffer;
+            size_t m_mask;
+            alignas (CACHE_LINE_SIZE) std::atomic <size_t> m_enqueuePos;
+            alignas (CACHE_LINE_SIZE) std::atomic <size_t> m_dequeuePos;
+
+            static size_t roundUpToPowerOf2 (size_t value) {
+                size_t result = 2;
+                while (result < value)
+                    result <<= 1;
+                return result;
+            }
+
+            template <typename U>
+            bool pushImpl (U&& data) {
+                Slot* slot;
+                size_t pos = m_enqueuePos.load (std::memory_order_relaxed);
+                while (true) {
+                    slot          = &m_buffer[pos & m_mask];
+                    size_t seq    = slot->sequence.load (std::memory_order_acquire);
+                    intptr_t diff = static_cast <intptr_t> (seq) - static_cast <intptr_t> (pos);
+                    /* Slot is free for this position, try to claim it
+                    */
+                    if (diff == 0) {
+                        if (m_enqueuePos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    /* Slot still holds an item from the previous lap, which means the buffer is full
+                    */
+                    else if (diff < 0)
+                        return false;
+                    /* Another producer claimed this position, reload and try again
+                    */
+                    else
+                        pos = m_enqueuePos.load (std::memory_order_relaxed);
+                }
+                slot->data = std::forward <U> (data);
+                slot->sequence.store (pos + 1, std::memory_order_release);
+                return true;
+            }
+
+        public:
+            MPMCBufferImpl (uint32_t instanceId, e_bufferType type, size_t capacity) {
+                size_t capacityPow2 = roundUpToPowerOf2 (capacity);
+                m_instanceId        = instanceId;
+                m_type              = type;
+                m_buffer            = new Slot[capacityPow2];
+                m_mask              = capacityPow2 - 1;
+
+                for (size_t i = 0; i < capacityPow2; i++)
+                    m_buffer[i].sequence.store (i, std::memory_order_relaxed);
+
+                m_enqueuePos.store (0, std::memory_order_relaxed);
+                m_dequeuePos.store (0, std::memory_order_relaxed);
+            }
+
+            ~MPMCBufferImpl (void) {
+                delete[] m_buffer;
+            }
+
+            MPMCBufferImpl (const MPMCBufferImpl&)             = delete;
+            MPMCBufferImpl& operator = (const MPMCBufferImpl&) = delete;
+
+            /* Returns false if the buffer is full, the data is left untouched in that case so that the caller can retry
+             * with the same item
+            */
+            bool push (const T& data) {
+                return pushImpl (data);
+            }
+
+            bool push (T&& data) {
+                return pushImpl (std::move (data));
+            }
+
+            /* Returns false if the buffer is empty
+            */
+            bool tryPop (T& data) {
+                Slot* slot;
+                size_t pos = m_dequeuePos.load (std::memory_order_relaxed);
+                while (true) {
+                    slot          = &m_buffer[pos & m_mask];
+                    size_t seq    = slot->sequence.load (std::memory_order_acquire);
+                    intptr_t diff = static_cast <intptr_t> (seq) - static_cast <intptr_t> (pos + 1);
+
+                    if (diff == 0) {
+                        if (m_dequeuePos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if (diff < 0)
+                        return false;
+                    else
+                        pos = m_dequeuePos.load (std::memory_order_relaxed);
+                }
+                data = std::move (slot->data);
+                /* Mark the slot as free for the producer on the next lap
+                */
+                slot->sequence.store (pos + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+
+            void flush (std::ostream& ost) {
+                T data;
+                while (tryPop (data))
+                    ost << data << "\n";
+
+                ost.flush();
+            }
+
+            size_t getCapacity (void) {
+                return m_mask + 1;
+            }
+
+            /* Approximate, since both positions may move while we are reading them
+            */
+            inline size_t getAvailability (void) {
+                size_t enqueuePos = m_enqueuePos.load (std::memory_order_relaxed);
+                size_t dequeuePos = m_dequeuePos.load (std::memory_order_relaxed);
+                size_t numItems   = enqueuePos > dequeuePos ? enqueuePos - dequeuePos: 0;
+                return numItems < getCapacity() ? getCapacity() - numItems: 0;
+            }
+
+            /* Drops every item in the buffer
+            */
+            void reset (void) {
+                T data;
+                while (tryPop (data))
+                    ;
+            }
+
+            /* Items can't be walked while other threads may be pushing/popping, so only the buffer state is displayed
+             * Buffer:
+             *          {                               <L1>
+             *              Id: ?                       <L2>
+             *              Type: ?
+             *              Availability: ?
+             *          }                               <L1>
+            */
+            void dump (std::ostream& ost) {
+                ost << "Buffer: " << "\n";
+                ost << OPEN_L1;
+
+                ost << TAB_L2 << "Id: "             << m_instanceId         << "\n";
+                ost << TAB_L2 << "Type: "           << m_type               << "\n";
+                ost << TAB_L2 << "Availability: "   << getAvailability()    << "\n";
+
+                ost << CLOSE_L1;
+            }
+    };
+}   // namespace Buffer
+}   // namespace Collection
+#endif  // MPMC_BUFFER_IMPL_H
\ No newline at end of file
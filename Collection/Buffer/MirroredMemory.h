@@ -0,0 +1,115 @@
+#ifndef MIRRORED_MEMORY_H
+#define MIRRORED_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace Collection {
+namespace Buffer {
+    /* Maps the same physical pages twice, back to back, so that the byte at offset i and the byte at offset i + size are
+     * one and the same. A ring buffer placed in this memory can then read or write any window of up to size bytes as a
+     * single contiguous range, no matter where it starts. The pages come from an anonymous memfd on Linux, and from a
+     * shared memory object that is unlinked right away on other POSIX systems
+     *
+     * The address range for both views is reserved first, then the file is mapped over each half with MAP_FIXED, so
+     * no other mapping can land in between
+    */
+    class MirroredMemory {
+        private:
+            uint8_t* m_base;
+            size_t m_size;
+
+            static int createBackingFile (void) {
+#if defined (__linux__)
+                return memfd_create ("mirrored_buffer", MFD_CLOEXEC);
+#else
+                static std::atomic <uint32_t> counter {0};
+                std::string name = "/mirrored_buffer_" + std::to_string (getpid())  + "_" +
+                                                         std::to_string (counter++);
+                int fd = shm_open (name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+                if (fd >= 0)
+                    shm_unlink (name.c_str());
+                return fd;
+#endif  // __linux__
+            }
+
+        public:
+            MirroredMemory (void) {
+                m_base = nullptr;
+                m_size = 0;
+            }
+
+            ~MirroredMemory (void) {
+                unmap();
+            }
+
+            MirroredMemory (const MirroredMemory&)             = delete;
+            MirroredMemory& operator = (const MirroredMemory&) = delete;
+
+            static size_t getPageSize (void) {
+                return static_cast <size_t> (sysconf (_SC_PAGESIZE));
+            }
+
+            /* Size needs to be a multiple of the page size. Returns false if the mapping could not be set up, in which
+             * case nothing is left mapped
+            */
+            bool map (size_t size) {
+                if (size == 0 || size % getPageSize() != 0)
+                    return false;
+
+                int fd = createBackingFile();
+                if (fd < 0)
+                    return false;
+
+                if (ftruncate (fd, static_cast <off_t> (size)) != 0) {
+                    close (fd);
+                    return false;
+                }
+
+                void* reserved = mmap (nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (reserved == MAP_FAILED) {
+                    close (fd);
+                    return false;
+                }
+
+                uint8_t* base = static_cast <uint8_t*> (reserved);
+                void* first   = mmap (base,        size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+                void* second  = mmap (base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+                /* The mappings hold their own reference to the file
+                */
+                close (fd);
+
+                if (first != base || second != base + size) {
+                    munmap (base, 2 * size);
+                    return false;
+                }
+
+                m_base = base;
+                m_size = size;
+                return true;
+            }
+
+            void unmap (void) {
+                if (m_base != nullptr) {
+                    munmap (m_base, 2 * m_size);
+                    m_base = nullptr;
+                    m_size = 0;
+                }
+            }
+
+            inline void* getBase (void) {
+                return m_base;
+            }
+
+            inline size_t getSize (void) {
+                return m_size;
+            }
+    };
+}   // namespace Buffer
+}   // namespace Collection
+#endif  // MIRRORED_MEMORY_H
\ No newline at end of file
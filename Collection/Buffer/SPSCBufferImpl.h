@@ -0,0 +1,155 @@
+#ifndef SPSC_BUFFER_IMPL_H
+#define SPSC_BUFFER_IMPL_H
+
+#include <atomic>
+#include <utility>
+#include "BufferImpl.h"
+
+namespace Collection {
+namespace Buffer {
+    /* Wait free single producer single consumer ring buffer, meant for handing off data between exactly 2 threads (one
+     * thread pushing, the other popping). The producer only ever writes the head index and the consumer only ever writes
+     * the tail index, each side reads the other's index with acquire ordering to see the slot contents published with
+     * it. Both sides also keep a private copy of the other side's index and only reload it when the copy says the buffer
+     * is full (or empty), which keeps the shared cache lines from bouncing between the 2 cores on every operation
+     *
+     * Unlike BufferImpl, the buffer never overflows (push fails when full) and only the first item can be popped
+    */
+    template <typename T>
+    class SPSCBufferImpl: public Admin::NonTemplateBase {
+        private:
+            static constexpr size_t CACHE_LINE_SIZE = 64;
+
+            uint32_t m_instanceId;
+            e_bufferType m_type;
+            /* One slot is always left empty so that a full buffer can be told apart from an empty one
+            */
+            size_t m_capacity;
+            size_t m_numSlots;
+            T* m_buffer;
+            /* Popped item, handed out by popFirst to keep the signature of BufferImpl. Only touched by the consumer
+            */
+            T m_popped;
+
+            alignas (CACHE_LINE_SIZE) std::atomic <size_t> m_head;
+            size_t m_cachedTail;
+            alignas (CACHE_LINE_SIZE) std::atomic <size_t> m_tail;
+            size_t m_cachedHead;
+
+            inline size_t getNextIdx (size_t idx) {
+                return idx + 1 == m_numSlots ? 0: idx + 1;
+            }
+
+            template <typename U>
+            bool pushImpl (U&& data) {
+                size_t head     = m_head.load (std::memory_order_relaxed);
+                size_t nextHead = getNextIdx (head);
+                if (nextHead == m_cachedTail) {
+                    m_cachedTail = m_tail.load (std::memory_order_acquire);
+                    if (nextHead == m_cachedTail)
+                        return false;
+                }
+                m_buffer[head] = std::forward <U> (data);
+                m_head.store (nextHead, std::memory_order_release);
+                return true;
+            }
+
+        public:
+            SPSCBufferImpl (uint32_t instanceId, e_bufferType type, size_t capacity) {
+                m_instanceId = instanceId;
+                m_type       = type;
+                m_capacity   = capacity;
+                m_numSlots   = capacity + 1;
+                m_buffer     = new T[m_numSlots];
+                m_cachedTail = 0;
+                m_cachedHead = 0;
+
+                m_head.store (0, std::memory_order_relaxed);
+                m_tail.store (0, std::memory_order_relaxed);
+            }
+
+            ~SPSCBufferImpl (void) {
+                delete[] m_buffer;
+            }
+
+            SPSCBufferImpl (const SPSCBufferImpl&)             = delete;
+            SPSCBufferImpl& operator = (const SPSCBufferImpl&) = delete;
+
+            /* Producer side. Returns false if the buffer is full, the data is left untouched in that case
+            */
+            bool push (const T& data) {
+                return pushImpl (data);
+            }
+
+            bool push (T&& data) {
+                return pushImpl (std::move (data));
+            }
+
+            /* Consumer side. Returns false if the buffer is empty
+            */
+            bool tryPop (T& data) {
+                size_t tail = m_tail.load (std::memory_order_relaxed);
+                if (tail == m_cachedHead) {
+                    m_cachedHead = m_head.load (std::memory_order_acquire);
+                    if (tail == m_cachedHead)
+                        return false;
+                }
+                data = std::move (m_buffer[tail]);
+                m_tail.store (getNextIdx (tail), std::memory_order_release);
+                return true;
+            }
+
+            /* Consumer side. The returned pointer is valid until the next pop
+            */
+            T* popFirst (void) {
+                return tryPop (m_popped) ? &m_popped: nullptr;
+            }
+
+            /* Consumer side
+            */
+            void flush (std::ostream& ost) {
+                T data;
+                while (tryPop (data))
+                    ost << data << "\n";
+
+                ost.flush();
+            }
+
+            /* Exact when called from either side while the other is idle, otherwise a snapshot
+            */
+            inline size_t getAvailability (void) {
+                size_t head = m_head.load (std::memory_order_acquire);
+                size_t tail = m_tail.load (std::memory_order_acquire);
+                return m_capacity - (head >= tail ? head - tail: head + m_numSlots - tail);
+            }
+
+            /* Consumer side, drops every item in the buffer
+            */
+            void reset (void) {
+                T data;
+                while (tryPop (data))
+                    ;
+            }
+
+            /* Items can't be walked while the other side may be moving, so only the buffer state is displayed
+             * Buffer:
+             *          {                               <L1>
+             *              Id: ?                       <L2>
+             *              Type: ?
+             *              Availability: ?
+             *          }                               <L1>
+            */
+            void dump (std::ostream& ost) {
+                ost << "Buffer: " << "\n";
+                ost << OPEN_L1;
+
+                ost << TAB_L2 << "Id: "             << m_instanceId         << "\n";
+                ost << TAB_L2 << "Type: "           << m_type               << "\n";
+                ost << TAB_L2 << "Availability: "   << getAvailability()    << "\n";
+
+                ost << CLOSE_L1;
+            }
+    };
+}   // namespace Buffer
+}   // namespace Collection
+#endif  // SPSC_BUFFER_IMPL_H
\ No newline at end of file
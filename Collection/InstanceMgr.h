@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include "DumpFormatting.h"
 
 namespace Collection {
@@ -40,9 +41,12 @@ namespace Admin {
                 closeAllInstances();
             }
 
+            /* Lookup only (no operator[]), so that instances can be fetched from several threads at once
+            */
             NonTemplateBase* getInstance (uint32_t instanceId) {
-                if (m_instancePool.find (instanceId) != m_instancePool.end())
-                    return m_instancePool[instanceId];
+                auto it = m_instancePool.find (instanceId);
+                if (it != m_instancePool.end())
+                    return it->second;
                 else
                     throw std::runtime_error ("Failed to find instance id");
             }
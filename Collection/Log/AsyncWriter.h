@@ -0,0 +1,271 @@
+#ifndef ASYNC_WRITER_H
+#define ASYNC_WRITER_H
+
+#include <fstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <chrono>
+#include "../Buffer/MPMCBufferImpl.h"
+
+namespace Collection {
+namespace Log {
+    /* What to do when a calling thread finds the async queue full
+     * BLOCK          Wait (yielding) for the writer thread to make room, no entries are lost
+     * DROP_OLDEST    Discard the oldest queued entry to make room for the new one
+     * DROP_NEWEST    Discard the new entry
+     * Entries discarded by either drop policy are counted and reported when the sink is closed
+    */
+    typedef enum {
+        BLOCK       = 0,
+        DROP_OLDEST = 1,
+        DROP_NEWEST = 2
+    } e_backpressure;
+
+    /* An async sink is the per record state shared between the calling threads (producers) and the writer thread
+     * (consumer). The file is only ever touched by the writer thread once the sink is registered
+    */
+    class AsyncSink {
+        private:
+            Buffer::MPMCBufferImpl <std::string> m_queue;
+            e_backpressure m_policy;
+            std::atomic <uint64_t> m_droppedCount;
+            std::ofstream m_file;
+            /* Larger than the default stream buffer so that a batch of entries reaches the disk in few write calls
+            */
+            std::vector <char> m_fileBuffer;
+
+        public:
+            AsyncSink (uint32_t instanceId, size_t capacity, e_backpressure policy):
+                m_queue (instanceId, Buffer::MPMC_LOCK_FREE, capacity) {
+                m_policy = policy;
+                m_droppedCount.store (0, std::memory_order_relaxed);
+                m_fileBuffer.resize (64 * 1024);
+            }
+
+            bool open (const std::string& filePath) {
+                /* pubsetbuf needs to be called before the file is opened to take effect
+                */
+                m_file.rdbuf()->pubsetbuf (m_fileBuffer.data(), static_cast <std::streamsize> (m_fileBuffer.size()));
+                m_file.open (filePath, std::ios_base::app | std::ios_base::out);
+                return m_file.is_open();
+            }
+
+            void close (void) {
+                uint64_t droppedCount = m_droppedCount.load (std::memory_order_relaxed);
+                if (droppedCount != 0 && m_file.is_open())
+                    m_file << "[ASYNC] " << droppedCount << " entries dropped" << "\n";
+                m_file.close();
+            }
+
+            Buffer::MPMCBufferImpl <std::string>& getQueue (void) {
+                return m_queue;
+            }
+
+            e_backpressure getPolicy (void) {
+                return m_policy;
+            }
+
+            std::ofstream& getFile (void) {
+                return m_file;
+            }
+
+            void addDropped (void) {
+                m_droppedCount.fetch_add (1, std::memory_order_relaxed);
+            }
+
+            uint64_t getDroppedCount (void) {
+                return m_droppedCount.load (std::memory_order_relaxed);
+            }
+    };
+
+    /* The writer owns a single background thread which drains every registered async sink in batches, the file stream
+     * is flushed once per batch instead of once per entry (which is what std::endl does for the immediate sink). The
+     * thread is started lazily when the first sink is registered
+    */
+    class AsyncWriter {
+        private:
+            std::thread m_thread;
+            std::mutex m_mutex;
+            std::condition_variable m_wakeCondition;
+            std::condition_variable m_flushCondition;
+            std::vector <AsyncSink*> m_sinks;
+
+            bool m_running;
+            /* Set by the writer thread just before it goes to sleep, producers only need to notify the writer when this
+             * is set which keeps the notify call off the hot path
+            */
+            std::atomic <bool> m_sleeping;
+            /* Flush requests are tracked as tickets, a flush call is complete once the writer has finished a full pass
+             * over all sinks which started after the ticket was taken
+            */
+            uint64_t m_flushRequested;
+            uint64_t m_flushCompleted;
+
+            /* Max entries written from a sink before moving on to the next one, so that one busy sink cannot starve the
+             * others
+            */
+            static constexpr size_t BATCH_SIZE = 256;
+            /* The writer wakes up periodically even if no one notified it, this bounds how long an entry can sit in
+             * the queue when the producer skipped the notify (race with m_sleeping)
+            */
+            static constexpr std::chrono::milliseconds IDLE_TIMEOUT {10};
+
+            /* Returns the number of entries written, the caller is expected to hold m_mutex
+            */
+            size_t drainSink (AsyncSink* sink) {
+                std::string entry;
+                size_t writeCount = 0;
+                auto& queue       = sink->getQueue();
+                auto& file        = sink->getFile();
+
+                while (writeCount < BATCH_SIZE && queue.tryPop (entry)) {
+                    file.write (entry.data(), static_cast <std::streamsize> (entry.size()));
+                    writeCount++;
+                }
+                if (writeCount != 0)
+                    file.flush();
+
+                return writeCount;
+            }
+
+            void run (void) {
+                std::unique_lock <std::mutex> lock (m_mutex);
+                while (true) {
+                    uint64_t flushTicket = m_flushRequested;
+                    size_t writeCount    = 0;
+                    /* Keep making passes until every queue is seen empty, only then is it safe to mark the flush ticket
+                     * as complete
+                    */
+                    size_t passCount;
+                    do {
+                        passCount = 0;
+                        for (auto const& sink: m_sinks)
+                            passCount += drainSink (sink);
+                        writeCount += passCount;
+                    } while (passCount != 0);
+
+                    if (m_flushCompleted != flushTicket) {
+                        m_flushCompleted = flushTicket;
+                        m_flushCondition.notify_all();
+                    }
+
+                    if (!m_running)
+                        break;
+                    /* Sleep only if there was nothing to write and there is no pending flush request
+                    */
+                    if (writeCount == 0 && m_flushRequested == m_flushCompleted) {
+                        m_sleeping.store (true, std::memory_order_release);
+                        m_wakeCondition.wait_for (lock, IDLE_TIMEOUT);
+                        m_sleeping.store (false, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            void wake (void) {
+                if (m_sleeping.load (std::memory_order_acquire))
+                    m_wakeCondition.notify_one();
+            }
+
+        public:
+            AsyncWriter (void) {
+                m_running        = false;
+                m_flushRequested = 0;
+                m_flushCompleted = 0;
+                m_sleeping.store (false, std::memory_order_relaxed);
+            }
+
+            ~AsyncWriter (void) {
+                shutdown();
+            }
+
+            void registerSink (AsyncSink* sink) {
+                std::lock_guard <std::mutex> lock (m_mutex);
+                m_sinks.push_back (sink);
+
+                if (!m_running) {
+                    m_running = true;
+                    m_thread  = std::thread (&AsyncWriter::run, this);
+                }
+            }
+
+            /* Drains the sink one last time before removing it, once this returns the sink is no longer referenced by
+             * the writer thread and can be closed/deleted by the caller
+            */
+            void unregisterSink (AsyncSink* sink) {
+                std::lock_guard <std::mutex> lock (m_mutex);
+                while (drainSink (sink) != 0)
+                    ;
+                m_sinks.erase (std::remove (m_sinks.begin(), m_sinks.end(), sink), m_sinks.end());
+            }
+
+            /* Push an entry into the sink's queue, applying the sink's backpressure policy if the queue is full
+            */
+            void push (AsyncSink* sink, std::string&& entry) {
+                auto& queue = sink->getQueue();
+                if (queue.push (std::move (entry))) {
+                    wake();
+                    return;
+                }
+
+                switch (sink->getPolicy()) {
+                    case BLOCK:
+                        do {
+                            m_wakeCondition.notify_one();
+                            std::this_thread::yield();
+                        } while (!queue.push (std::move (entry)));
+                        break;
+
+                    case DROP_OLDEST: {
+                        std::string discarded;
+                        do {
+                            if (queue.tryPop (discarded))
+                                sink->addDropped();
+                        } while (!queue.push (std::move (entry)));
+                        break;
+                    }
+
+                    case DROP_NEWEST:
+                        sink->addDropped();
+                        break;
+                }
+                wake();
+            }
+
+            /* Blocks until every entry pushed before this call has been written out to its file
+            */
+            void flush (void) {
+                std::unique_lock <std::mutex> lock (m_mutex);
+                if (!m_running)
+                    return;
+
+                uint64_t flushTicket = ++m_flushRequested;
+                m_wakeCondition.notify_one();
+                m_flushCondition.wait (lock, [&]() {
+                    return m_flushCompleted >= flushTicket;
+                });
+            }
+
+            /* Stops the writer thread after a final drain of all registered sinks, the writer is restarted if another
+             * sink is registered afterwards
+            */
+            void shutdown (void) {
+                {
+                    std::lock_guard <std::mutex> lock (m_mutex);
+                    if (!m_running)
+                        return;
+                    m_running = false;
+                }
+                m_wakeCondition.notify_one();
+                m_thread.join();
+            }
+    };
+    /* Defined ahead of the record manager, so that it is destroyed after all records (and their async sinks) are
+    */
+    AsyncWriter g_asyncWriter;
+}   // namespace Log
+}   // namespace Collection
+#endif  // ASYNC_WRITER_H
\ No newline at end of file
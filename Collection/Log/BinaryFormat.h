@@ -0,0 +1,115 @@
+#ifndef BINARY_FORMAT_H
+#define BINARY_FORMAT_H
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <mutex>
+
+namespace Collection {
+namespace Log {
+    /* Layout of the binary sink file, shared between the record (writer) and the offline decoder (reader). Fixed size
+     * values are written in host byte order, ids/lengths/integers are written as LEB128 varints (signed integers zig zag
+     * encoded first), and strings are written as a varint length followed by the characters (no null terminator)
+     *
+     * File header
+     *      char magic[4]           "ENBL"
+     *      uint32_t version
+     *      uint32_t instanceId
+     *
+     * Followed by a sequence of blocks, each starting with a 8 bit block tag
+     *      CALL_SITE               varint callSiteId, uint8_t level, varint line, string file, string function
+     *                              written once per file, ahead of the first entry from the call site
+     *      STRING                  varint stringId, string text
+     *                              an interned string literal, written ahead of the first entry that uses it
+     *      SHAPE                   varint callSiteId, string shape
+     *                              the shape is uint8_t enHeader followed by one 8 bit arg tag per argument, string
+     *                              refs carry their varint stringId in the shape. Since the literals and argument types
+     *                              of a statement rarely change between calls, it is written only when it differs from
+     *                              the previous shape of the call site
+     *      ENTRY                   varint callSiteId, varint timestamp delta (zig zag, ns since the previous entry),
+     *                              followed by the argument values as laid out by the current shape of the call site
+    */
+    namespace BinaryFormat {
+        const char     MAGIC[4] = {'E', 'N', 'B', 'L'};
+        const uint32_t VERSION  = 1;
+
+        typedef enum {
+            BLOCK_CALL_SITE = 1,
+            BLOCK_STRING    = 2,
+            BLOCK_SHAPE     = 3,
+            BLOCK_ENTRY     = 4
+        } e_blockTag;
+
+        /* Value layout in an entry
+         * BOOL, CHAR           uint8_t
+         * INT64                zig zag varint
+         * UINT64               varint
+         * FLOAT, DOUBLE        raw
+         * STRING_REF           nothing, the string id is part of the shape
+         * STRING               string
+        */
+        typedef enum {
+            ARG_BOOL        = 1,
+            ARG_CHAR        = 2,
+            ARG_INT64       = 3,
+            ARG_UINT64      = 4,
+            ARG_FLOAT       = 5,
+            ARG_DOUBLE      = 6,
+            ARG_STRING_REF  = 7,
+            ARG_STRING      = 8
+        } e_argTag;
+
+        /* The holder is either a std::string or a ByteHolder (see Staging.h)
+        */
+        template <typename T>
+        inline void appendVarint (T& holder, uint64_t value) {
+            while (value >= 0x80) {
+                holder.push_back (static_cast <char> (value | 0x80));
+                value >>= 7;
+            }
+            holder.push_back (static_cast <char> (value));
+        }
+
+        inline uint64_t encodeZigZag (int64_t value) {
+            return (static_cast <uint64_t> (value) << 1) ^ static_cast <uint64_t> (value >> 63);
+        }
+
+        inline int64_t decodeZigZag (uint64_t value) {
+            return static_cast <int64_t> (value >> 1) ^ -static_cast <int64_t> (value & 1);
+        }
+    }   // namespace BinaryFormat
+
+    /* Every LOG statement gets a process wide call site id the first time it is executed (the id is held in a static
+     * local variable at the call site), the binary sink then only needs to write the id with each entry instead of the
+     * file, function and line
+    */
+    class CallSiteRegistry {
+        public:
+            struct CallSite {
+                uint8_t level;
+                uint32_t line;
+                const char* file;
+                const char* function;
+            };
+
+        private:
+            std::mutex m_mutex;
+            std::vector <CallSite> m_callSites;
+
+        public:
+            uint32_t registerCallSite (uint8_t level, const char* file, const char* function, uint32_t line) {
+                std::lock_guard <std::mutex> lock (m_mutex);
+                m_callSites.push_back ({level, line, file, function});
+                return static_cast <uint32_t> (m_callSites.size() - 1);
+            }
+
+            CallSite getCallSite (uint32_t callSiteId) {
+                std::lock_guard <std::mutex> lock (m_mutex);
+                return m_callSites[callSiteId];
+            }
+    };
+    CallSiteRegistry g_callSiteRegistry;
+}   // namespace Log
+}   // namespace Collection
+#endif  // BINARY_FORMAT_H
\ No newline at end of file
@@ -2,6 +2,14 @@
 #define LOG_H
 
 #include "RecordMgr.h"
+/* Compile time minimum level, statements below this level are discarded by the compiler (the level passed to the LOG
+ * macro is a constant, so the check folds away along with the statement). For example, building with
+ * -DLOG_MIN_LEVEL=4 keeps only error logs, and -DLOG_MIN_LEVEL=8 removes all logging
+*/
+#ifndef LOG_MIN_LEVEL
+    #define LOG_MIN_LEVEL                       (1)
+#endif  // LOG_MIN_LEVEL
+#define LOG_COMPILED_LEVELS                     (~(LOG_MIN_LEVEL - 1) & Log::VERBOSE)
 
 /* Macro overloading
 */
@@ -24,6 +32,11 @@
                                                 GET_LOG(id)->addConfig (level, sink, nameExt);
 #define LOG_ADD_CONFIG_B(id, level, sink)       GET_LOG(id)->addConfig (level, sink);
 
+#define LOG_ASYNC_CONFIG(id, capacity, policy)  GET_LOG(id)->setAsyncConfig (capacity, policy);
+#define LOG_MAPPED_CONFIG(id, slotCount, slotSize)                                                                      \
+                                                GET_LOG(id)->setMappedConfig (slotCount, slotSize);
+#define LOG_FLUSH_ALL                           Log::g_recordMgr.flushAllRecords();
+
 #define LOG_CLEAR_CONFIG(id)                    GET_LOG(id)->clearConfig();
 #define LOG_CLEAR_ALL_CONFIGS                   Log::g_recordMgr.clearAllConfigs();
 
@@ -37,6 +50,8 @@
                                                 static_cast <Log::Record*> (val);                                       \
                                                 ost << TAB_L4   << "level : "   << c_record->getLevel()    << "\n";     \
                                                 ost << TAB_L4   << "sink : "    << c_record->getSink()     << "\n";     \
+                                                ost << TAB_L4   << "dropped : "                                         \
+                                                                << c_record->getAsyncDroppedCount()        << "\n";     \
                                                 })
 
 /* Logging methods
@@ -54,11 +69,24 @@
 #define LOG_GET_FILE                            __FILE__
 #define LOG_GET_FUNCTION                        __FUNCTION__
 #define LOG_GET_LINE                            __LINE__
-#define LOG(c_record, level, header)            if (!c_record->isSinkPresent (level)) { ; }                             \
+#define LOG(c_record, level, header)            if (!((level) & LOG_COMPILED_LEVELS) ||                                 \
+                                                    !c_record->isSinkPresent (level)) { ; }                             \
                                                 else                                                                    \
-                                                    c_record->getReference() <<                                         \
-                                                    c_record->getHeader (level,                                         \
-                                                                         LOG_GET_FUNCTION,                              \
-                                                                         LOG_GET_LINE,                                  \
-                                                                         header)
+                                                    c_record->beginEntry (level,                                        \
+                                                                          LOG_GET_FUNCTION,                             \
+                                                                          LOG_GET_LINE,                                 \
+                                                                          header,                                       \
+                                                                          LOG_GET_CALL_SITE (level))
+/* Each expansion of this lambda is a distinct type, so the static local variable inside it is unique to the call site.
+ * The id is registered the first time the call site logs to a binary sink
+*/
+#define LOG_GET_CALL_SITE(level)                [] (const char* callingFunction) {                                      \
+                                                    static const uint32_t callSiteId =                                  \
+                                                    Log::g_callSiteRegistry.registerCallSite (                          \
+                                                        static_cast <uint8_t> (level),                                  \
+                                                        LOG_GET_FILE,                                                   \
+                                                        callingFunction,                                                \
+                                                        LOG_GET_LINE);                                                  \
+                                                    return callSiteId;                                                  \
+                                                }
 #endif  // LOG_H
\ No newline at end of file
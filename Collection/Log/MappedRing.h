@@ -0,0 +1,177 @@
+#ifndef MAPPED_RING_H
+#define MAPPED_RING_H
+
+#include <atomic>
+#include <new>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace Collection {
+namespace Log {
+    /* Layout of the mapped ring file, shared between the record (writer) and the offline reader
+     *
+     * File header (FILE_HEADER_SIZE bytes)
+     *      char magic[4]           "ENFR"
+     *      uint32_t version
+     *      uint32_t instanceId
+     *      uint32_t slotSize       size of a slot including its header, a multiple of 8
+     *      uint32_t slotCount
+     *
+     * Followed by slotCount fixed size slots
+     *      uint64_t sequence       0 if the slot is empty or being written, otherwise the sequence number of the entry
+     *      uint32_t length         length of the text
+     *      uint32_t reserved
+     *      char text[]             entry text, truncated to fit the slot (no null terminator)
+    */
+    namespace MappedRingFormat {
+        const char     MAGIC[4]         = {'E', 'N', 'F', 'R'};
+        const uint32_t VERSION          = 1;
+        const size_t   FILE_HEADER_SIZE = 64;
+
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint32_t instanceId;
+            uint32_t slotSize;
+            uint32_t slotCount;
+        };
+
+        struct SlotHeader {
+            std::atomic <uint64_t> sequence;
+            uint32_t length;
+            uint32_t reserved;
+        };
+        static_assert (sizeof (FileHeader) <= FILE_HEADER_SIZE);
+        static_assert (sizeof (SlotHeader) == 16);
+        static_assert (FILE_HEADER_SIZE % alignof (SlotHeader) == 0);
+    }   // namespace MappedRingFormat
+
+    /* Circular log sink backed by a memory mapped file. Entries are written with plain memory stores into fixed size
+     * slots, the kernel owns the dirty pages of a shared file mapping, so whatever was stored survives the process
+     * crashing or being killed (but not the machine losing power). The slot sequence number is cleared before the text
+     * is written and set only once the text is complete, so the reader can always tell a complete entry from one that
+     * was cut short
+    */
+    class MappedRing {
+        private:
+            int m_fd;
+            uint8_t* m_base;
+            size_t m_mappedSize;
+            uint32_t m_slotSize;
+            uint32_t m_slotCount;
+            /* Sequence number of the next entry, starts at 1 since 0 marks an empty slot
+            */
+            std::atomic <uint64_t> m_nextSequence;
+
+            MappedRingFormat::SlotHeader* getSlot (uint64_t sequence) {
+                size_t slotIdx = static_cast <size_t> (sequence % m_slotCount);
+                return reinterpret_cast <MappedRingFormat::SlotHeader*> (m_base + MappedRingFormat::FILE_HEADER_SIZE +
+                                                                         slotIdx * m_slotSize);
+            }
+
+        public:
+            MappedRing (void) {
+                m_fd           = -1;
+                m_base         = nullptr;
+                m_mappedSize   = 0;
+                m_slotSize     = 0;
+                m_slotCount    = 0;
+                m_nextSequence = 1;
+            }
+
+            ~MappedRing (void) {
+                close();
+            }
+
+            bool open (const std::string& filePath, uint32_t instanceId, uint32_t slotCount, uint32_t slotSize) {
+                /* The ring from the previous run is kept around, since it may hold the last moments before a crash
+                */
+                std::string previousFilePath = filePath + ".prev";
+                rename (filePath.c_str(), previousFilePath.c_str());
+
+                m_slotSize   = slotSize;
+                m_slotCount  = slotCount;
+                m_mappedSize = MappedRingFormat::FILE_HEADER_SIZE + static_cast <size_t> (slotCount) * slotSize;
+
+                m_fd = ::open (filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+                if (m_fd < 0)
+                    return false;
+                /* Size the file up front, the pages read back as zero which marks every slot as empty
+                */
+                if (ftruncate (m_fd, static_cast <off_t> (m_mappedSize)) != 0) {
+                    close();
+                    return false;
+                }
+
+                void* base = mmap (nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+                if (base == MAP_FAILED) {
+                    close();
+                    return false;
+                }
+                m_base = static_cast <uint8_t*> (base);
+
+                auto fileHeader = reinterpret_cast <MappedRingFormat::FileHeader*> (m_base);
+                memcpy (fileHeader->magic, MappedRingFormat::MAGIC, sizeof (MappedRingFormat::MAGIC));
+                fileHeader->version    = MappedRingFormat::VERSION;
+                fileHeader->instanceId = instanceId;
+                fileHeader->slotSize   = slotSize;
+                fileHeader->slotCount  = slotCount;
+
+                for (uint32_t i = 0; i < slotCount; i++)
+                    new (getSlot (i)) MappedRingFormat::SlotHeader {{0}, 0, 0};
+
+                m_nextSequence = 1;
+                return true;
+            }
+
+            void close (void) {
+                if (m_base != nullptr) {
+                    munmap (m_base, m_mappedSize);
+                    m_base = nullptr;
+                }
+                if (m_fd >= 0) {
+                    ::close (m_fd);
+                    m_fd = -1;
+                }
+            }
+
+            bool isOpen (void) {
+                return m_base != nullptr;
+            }
+
+            bool isEmpty (void) {
+                return m_nextSequence.load (std::memory_order_relaxed) == 1;
+            }
+
+            /* Entries may be written from several threads at once, each claims its own sequence number (and with it a
+             * slot) so no lock is needed. Two writers only share a slot if one of them is a full lap of the ring behind
+             * the other, which needs more threads in the middle of a write than there are slots
+            */
+            void write (const char* data, size_t length) {
+                uint64_t sequence = m_nextSequence.fetch_add (1, std::memory_order_relaxed);
+                auto slot         = getSlot (sequence);
+                char* slotText    = reinterpret_cast <char*> (slot) + sizeof (MappedRingFormat::SlotHeader);
+
+                slot->sequence.store (0, std::memory_order_relaxed);
+                /* The slot needs to be marked as empty before its text is overwritten, a fence is enough here since we
+                 * only need to stop the compiler from moving the text stores ahead of this store
+                */
+                std::atomic_signal_fence (std::memory_order_seq_cst);
+
+                size_t available = m_slotSize - sizeof (MappedRingFormat::SlotHeader);
+                if (length > available)
+                    length = available;
+
+                memcpy (slotText, data, length);
+                slot->length = static_cast <uint32_t> (length);
+                slot->sequence.store (sequence, std::memory_order_release);
+            }
+    };
+}   // namespace Log
+}   // namespace Collection
+#endif  // MAPPED_RING_H
\ No newline at end of file
@@ -3,7 +3,16 @@
 
 #include <fstream>
 #include <sstream>
+#include <mutex>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+#include <charconv>
 #include "../Buffer/Buffer.h"
+#include "AsyncWriter.h"
+#include "BinaryFormat.h"
+#include "MappedRing.h"
+#include "Staging.h"
 
 namespace Collection {
 namespace Log {
@@ -19,7 +28,10 @@ namespace Log {
         TO_NONE                 = 0,
         TO_FILE_IMMEDIATE       = 1,
         TO_CONSOLE              = 2,
-        TO_FILE_BUFFER_CIRCULAR = 4
+        TO_FILE_BUFFER_CIRCULAR = 4,
+        TO_FILE_ASYNC           = 8,
+        TO_FILE_BINARY          = 16,
+        TO_FILE_MAPPED_CIRCULAR = 32
     } e_sink;
 
     inline e_level operator | (e_level a, e_level b) {
@@ -30,6 +42,10 @@ namespace Log {
         return static_cast <e_sink> (static_cast <int> (a) | static_cast <int> (b));
     }
 
+    /* Console is shared by every record, so entries are written to it under a single lock
+    */
+    std::mutex g_consoleMutex;
+
     class Record: public Admin::NonTemplateBase {
         private:
             uint32_t m_instanceId;
@@ -38,24 +54,62 @@ namespace Log {
             size_t m_bufferCapacity;
             const char* m_format;
 
-            std::unordered_map <e_level, e_sink> m_levelConfig;
+            /* Sink per level, indexed directly by the level value (INFO, WARNING and ERROR are single bits) which
+             * avoids a hash lookup on every log statement
+            */
+            e_sink m_levelConfig[VERBOSE + 1];
+            /* Cached union of all levels which have a sink configured, this allows an unconfigured level to be rejected
+             * with a single branch
+            */
+            uint32_t m_levelMask;
             std::fstream m_saveFileImmediate;
             std::fstream m_saveFileBuffered;
             /* std::endl is a template function, and this is the signature of that function
             */
             using endl_type = std::ostream& (std::ostream&);
-            /* Variable to hold entry in buffered sink
-            */
-            std::string m_bufferedSinkHolder;
             /* File paths
             */
             std::string m_saveFilePathImmediate;
             std::string m_saveFilePathBuffered;
-            /* Current sink for the filtered level
-            */
-            e_sink m_activeSink;
             bool m_fileImmediateReady;
             bool m_fileBufferedReady;
+            /* Log statements are staged per thread and only touch the record when they are committed. The immediate,
+             * buffered and binary sinks are written under this lock, the async and mapped sinks are lock free
+            */
+            std::mutex m_commitMutex;
+            /* Async sink, the entry is formatted on the calling thread and handed off to the writer thread upon
+             * std::endl
+            */
+            AsyncSink* m_asyncSink;
+            std::string m_saveFilePathAsync;
+            size_t m_asyncCapacity;
+            e_backpressure m_asyncPolicy;
+            bool m_fileAsyncReady;
+            /* Binary sink, entries are written as a call site id, a timestamp and the raw argument values. Text is
+             * reconstructed offline by the decoder tool. Definitions (call sites, interned strings and shapes) seen for
+             * the first time in an entry are written to the file ahead of the entry
+            */
+            std::ofstream m_saveFileBinary;
+            std::vector <char> m_binaryFileBuffer;
+            std::string m_saveFilePathBinary;
+            std::string m_binaryDefinitionHolder;
+            std::string m_binaryEntryHolder;
+            uint64_t m_binaryLastTimestamp;
+            /* Per call site, whether its definition has been written to the file, and its last written shape. Per
+             * interned string, whether its definition has been written to the file
+            */
+            std::vector <bool> m_callSitesWritten;
+            std::vector <std::string> m_callSiteShapes;
+            std::vector <bool> m_stringsWritten;
+            bool m_binaryEntryWritten;
+            bool m_fileBinaryReady;
+            /* Mapped circular sink, text is written straight into a slot of a memory mapped file
+            */
+            MappedRing m_mappedRing;
+            std::string m_saveFilePathMapped;
+            uint32_t m_mappedSlotCount;
+            uint32_t m_mappedSlotSize;
+            bool m_fileMappedReady;
 
             const char* getLevelString (e_level level) {
                 switch (level) {
@@ -66,30 +120,262 @@ namespace Log {
                 }
             }
 
-            std::string getLocalTimestamp (void) {
-                /* The string stream associates a string object with a string. Using this we can read from string as if it
-                 * were a stream like cin
+            /* Write unsigned integer to buffer, left padded with zeros up to min width. Returns pointer past the last
+             * character written
+            */
+            static char* writeUnsigned (char* dst, uint64_t value, uint32_t minWidth = 1) {
+                char digits[20];
+                uint32_t count = 0;
+                do {
+                    digits[count++] = static_cast <char> ('0' + value % 10);
+                    value /= 10;
+                } while (value != 0);
+
+                while (count < minWidth--)
+                    *dst++ = '0';
+                while (count != 0)
+                    *dst++ = digits[--count];
+                return dst;
+            }
+
+            /* Copy string to buffer without running past the end, returns pointer past the last character written
+            */
+            static char* writeString (char* dst, const char* end, const char* src) {
+                while (*src != '\0' && dst < end)
+                    *dst++ = *src++;
+                return dst;
+            }
+
+            /* Writes local timestamp in the format YYYY-MM-DD HH:MM:SS.mmm, localtime and strftime are only called when
+             * the second has changed since the last call on this thread. Returns pointer past the last character
+             * written
+            */
+            static char* writeLocalTimestamp (char* dst) {
+                auto& formatter   = t_headerFormatter;
+                auto now          = std::chrono::system_clock::now();
+                auto sinceEpochMs = std::chrono::duration_cast <std::chrono::milliseconds> (now.time_since_epoch());
+                time_t second     = static_cast <time_t> (sinceEpochMs.count() / 1000);
+                uint32_t milliSec = static_cast <uint32_t> (sinceEpochMs.count() % 1000);
+
+                if (second != formatter.cachedSecond) {
+                    struct tm localTime;
+                    localtime_r (&second, &localTime);
+                    formatter.cachedTimestampLength = strftime (formatter.cachedTimestamp,
+                                                                sizeof (formatter.cachedTimestamp),
+                                                                "%F %T",
+                                                                &localTime);
+                    formatter.cachedSecond          = second;
+                }
+                memcpy (dst, formatter.cachedTimestamp, formatter.cachedTimestampLength);
+                dst   += formatter.cachedTimestampLength;
+                *dst++ = '.';
+                return writeUnsigned (dst, milliSec, 3);
+            }
+
+            template <typename H, typename T>
+            static void appendRaw (H& holder, T value) {
+                holder.append (reinterpret_cast <const char*> (&value), sizeof (T));
+            }
+
+            template <typename H>
+            static void appendRawString (H& holder, const char* data, size_t length) {
+                BinaryFormat::appendVarint (holder, length);
+                holder.append (data, length);
+            }
+
+            static void appendArgTag (Staging* staging, BinaryFormat::e_argTag argTag) {
+                staging->binaryShape.push_back (static_cast <char> (argTag));
+            }
+
+            /* String literals are interned by their address, the string id becomes part of the shape and the text is
+             * written to the file once. Since a char pointer may as well point to a buffer whose contents change, the
+             * interned text is compared on every hit and the string is written inline if it no longer matches
+            */
+            static void appendBinaryString (Staging* staging, const char* data, size_t length, bool canIntern) {
+                if (canIntern) {
+                    auto interned              = t_stringInternCache.intern (data, length);
+                    auto const& internedString = *interned.second;
+                    if (internedString.size() == length && memcmp (internedString.data(), data, length) == 0) {
+                        appendArgTag               (staging, BinaryFormat::ARG_STRING_REF);
+                        BinaryFormat::appendVarint (staging->binaryShape, interned.first);
+                        staging->binaryStrings.push_back (interned);
+                        return;
+                    }
+                }
+                appendArgTag    (staging, BinaryFormat::ARG_STRING);
+                appendRawString (staging->binaryPayload, data, length);
+            }
+
+            template <typename T>
+            static void appendBinaryArg (Staging* staging, const T& data) {
+                if constexpr (std::is_convertible_v <T, std::string_view>) {
+                    std::string_view view (data);
+                    appendBinaryString (staging, view.data(), view.size(), std::is_array_v <T> || std::is_pointer_v <T>);
+                }
+                else if constexpr (std::is_enum_v <T>)
+                    appendBinaryArg (staging, static_cast <std::underlying_type_t <T>> (data));
+
+                else if constexpr (std::is_same_v <T, bool>) {
+                    appendArgTag (staging, BinaryFormat::ARG_BOOL);
+                    appendRaw    (staging->binaryPayload, static_cast <uint8_t> (data));
+                }
+                /* Text sinks print all char types as characters, not as numbers
+                */
+                else if constexpr (std::is_same_v <T, char>        ||
+                                   std::is_same_v <T, signed char> ||
+                                   std::is_same_v <T, unsigned char>) {
+                    appendArgTag (staging, BinaryFormat::ARG_CHAR);
+                    appendRaw    (staging->binaryPayload, static_cast <char> (data));
+                }
+                else if constexpr (std::is_same_v <T, float>) {
+                    appendArgTag (staging, BinaryFormat::ARG_FLOAT);
+                    appendRaw    (staging->binaryPayload, data);
+                }
+                else if constexpr (std::is_floating_point_v <T>) {
+                    appendArgTag (staging, BinaryFormat::ARG_DOUBLE);
+                    appendRaw    (staging->binaryPayload, static_cast <double> (data));
+                }
+                else if constexpr (std::is_integral_v <T> && std::is_signed_v <T>) {
+                    appendArgTag               (staging, BinaryFormat::ARG_INT64);
+                    BinaryFormat::appendVarint (staging->binaryPayload,
+                                                BinaryFormat::encodeZigZag (static_cast <int64_t> (data)));
+                }
+                else if constexpr (std::is_integral_v <T>) {
+                    appendArgTag               (staging, BinaryFormat::ARG_UINT64);
+                    BinaryFormat::appendVarint (staging->binaryPayload, static_cast <uint64_t> (data));
+                }
+                /* Anything else is converted to text the same way the text sinks do
+                */
+                else {
+                    std::string text = std::to_string (data);
+                    appendBinaryString (staging, text.data(), text.size(), false);
+                }
+            }
+
+            static void beginBinaryEntry (Staging* staging, bool enHeader) {
+                auto now           = std::chrono::system_clock::now();
+                staging->timestamp = static_cast <uint64_t> (
+                                     std::chrono::duration_cast <std::chrono::nanoseconds> (now.time_since_epoch()).count());
+                staging->binaryShape.push_back (static_cast <char> (enHeader));
+            }
+
+            /* Needs to be called with the commit lock held
+            */
+            void writeBinaryEntry (Staging* staging) {
+                uint32_t callSiteId = staging->callSiteId;
+                if (callSiteId >= m_callSitesWritten.size()) {
+                    m_callSitesWritten.resize (callSiteId + 1, false);
+                    m_callSiteShapes.resize   (callSiteId + 1);
+                }
+
+                if (!m_callSitesWritten[callSiteId]) {
+                    auto callSite = g_callSiteRegistry.getCallSite (callSiteId);
+                    appendRaw                  (m_binaryDefinitionHolder,
+                                                static_cast <uint8_t> (BinaryFormat::BLOCK_CALL_SITE));
+                    BinaryFormat::appendVarint (m_binaryDefinitionHolder, callSiteId);
+                    appendRaw                  (m_binaryDefinitionHolder, callSite.level);
+                    BinaryFormat::appendVarint (m_binaryDefinitionHolder, callSite.line);
+                    appendRawString            (m_binaryDefinitionHolder, callSite.file,     strlen (callSite.file));
+                    appendRawString            (m_binaryDefinitionHolder, callSite.function, strlen (callSite.function));
+                    m_callSitesWritten[callSiteId] = true;
+                }
+
+                /* The string ids a statement refers to are part of its shape, so while the shape of the call site is
+                 * unchanged every string it refers to has been written already
                 */
-                std::stringstream stream;
+                if (m_callSiteShapes[callSiteId] != staging->binaryShape.view()) {
+                    for (auto const& [stringId, internedString]: staging->binaryStrings) {
+                        if (stringId >= m_stringsWritten.size())
+                            m_stringsWritten.resize (stringId + 1, false);
+                        if (m_stringsWritten[stringId])
+                            continue;
+
+                        appendRaw                  (m_binaryDefinitionHolder,
+                                                    static_cast <uint8_t> (BinaryFormat::BLOCK_STRING));
+                        BinaryFormat::appendVarint (m_binaryDefinitionHolder, stringId);
+                        appendRawString            (m_binaryDefinitionHolder,
+                                                    internedString->data(),
+                                                    internedString->size());
+                        m_stringsWritten[stringId] = true;
+                    }
+
+                    appendRaw                  (m_binaryDefinitionHolder,
+                                                static_cast <uint8_t> (BinaryFormat::BLOCK_SHAPE));
+                    BinaryFormat::appendVarint (m_binaryDefinitionHolder, callSiteId);
+                    appendRawString            (m_binaryDefinitionHolder,
+                                                staging->binaryShape.data(),
+                                                staging->binaryShape.size());
+                    m_callSiteShapes[callSiteId].assign (staging->binaryShape.data(), staging->binaryShape.size());
+                }
 
-                auto now = std::chrono::system_clock::now();
-                auto t_c = std::chrono::system_clock::to_time_t (now);
-                /* https://en.cppreference.com/w/cpp/io/manip/put_time
+                if (!m_binaryDefinitionHolder.empty()) {
+                    m_saveFileBinary.write (m_binaryDefinitionHolder.data(),
+                                            static_cast <std::streamsize> (m_binaryDefinitionHolder.size()));
+                    m_binaryDefinitionHolder.clear();
+                }
+                /* Entries from different threads may be committed slightly out of timestamp order, in which case the
+                 * delta is negative
                 */
-                stream << std::put_time (std::localtime (&t_c), "%F %T");
-                return stream.str();
+                int64_t timestampDelta = static_cast <int64_t> (staging->timestamp - m_binaryLastTimestamp);
+                m_binaryLastTimestamp  = staging->timestamp;
+
+                appendRaw                  (m_binaryEntryHolder, static_cast <uint8_t> (BinaryFormat::BLOCK_ENTRY));
+                BinaryFormat::appendVarint (m_binaryEntryHolder, callSiteId);
+                BinaryFormat::appendVarint (m_binaryEntryHolder, BinaryFormat::encodeZigZag (timestampDelta));
+                m_binaryEntryHolder.append (staging->binaryPayload.data(), staging->binaryPayload.size());
+
+                m_saveFileBinary.write (m_binaryEntryHolder.data(),
+                                        static_cast <std::streamsize> (m_binaryEntryHolder.size()));
+                m_binaryEntryHolder.clear();
+                m_binaryEntryWritten = true;
             }
 
-            /* These 2 methods helps us to convert everything to string type
+            /* Write the staged entry to every sink as a whole line
             */
-            std::string to_string (const std::string& r) const {
-                return r;
+            void commitEntry (Staging* staging, endl_type endl) {
+                uint32_t activeSink = staging->activeSink;
+                if (activeSink & TO_CONSOLE) {
+                    std::lock_guard <std::mutex> lock (g_consoleMutex);
+                    std::cout.write (staging->text.data(), static_cast <std::streamsize> (staging->text.size()));
+                    std::cout << endl;
+                }
+
+                if (activeSink & TO_FILE_ASYNC) {
+                    std::string entry;
+                    entry.reserve (staging->text.size() + 1);
+                    entry += staging->text;
+                    entry += '\n';
+                    g_asyncWriter.push (m_asyncSink, std::move (entry));
+                }
+
+                if (activeSink & TO_FILE_MAPPED_CIRCULAR)
+                    m_mappedRing.write (staging->text.data(), staging->text.size());
+
+                if (activeSink & (TO_FILE_IMMEDIATE | TO_FILE_BUFFER_CIRCULAR | TO_FILE_BINARY)) {
+                    std::lock_guard <std::mutex> lock (m_commitMutex);
+                    if (activeSink & TO_FILE_IMMEDIATE && m_saveFileImmediate.is_open()) {
+                        m_saveFileImmediate.write (staging->text.data(),
+                                                   static_cast <std::streamsize> (staging->text.size()));
+                        m_saveFileImmediate << endl;
+                    }
+                    /* For buffered sink, instead of inserting a new line we push the log entry into the buffer
+                    */
+                    if (activeSink & TO_FILE_BUFFER_CIRCULAR) {
+                        auto logBuffer = GET_BUFFER (RESERVED_ID_LOG_SINK + m_instanceId, std::string);
+                        logBuffer->BUFFER_PUSH (staging->text);
+                    }
+
+                    if (activeSink & TO_FILE_BINARY && m_saveFileBinary.is_open())
+                        writeBinaryEntry (staging);
+                }
             }
 
-            template <typename T>
-            typename std::enable_if <!std::is_convertible <T, std::string>::value,
-                                      std::string>::type to_string (T r) const {
-                return std::to_string (r);
+            void updateLevelMask (void) {
+                m_levelMask = 0;
+                for (auto const& level: {INFO, WARNING, ERROR}) {
+                    if (m_levelConfig[level] != TO_NONE)
+                        m_levelMask |= level;
+                }
             }
 
             void deleteEmptyFile (std::fstream& file, const char* filePath) {
@@ -111,6 +397,55 @@ namespace Log {
             }
 
         public:
+            /* A log statement, created by the LOG macro and alive until the end of the full expression. Pieces of the
+             * statement are staged on the calling thread and committed to the record upon std::endl, so a statement
+             * needs to be terminated with std::endl to be logged
+            */
+            class Statement {
+                private:
+                    Record* m_record;
+                    Staging* m_staging;
+
+                public:
+                    Statement (Record* record, Staging* staging) {
+                        m_record  = record;
+                        m_staging = staging;
+                    }
+
+                    ~Statement (void) {
+                        t_stagingStack.release();
+                    }
+
+                    Statement (const Statement&)             = delete;
+                    Statement& operator = (const Statement&) = delete;
+
+                    /* Overload for std::endl
+                    */
+                    Statement& operator << (endl_type endl) {
+                        m_record->commitEntry (m_staging, endl);
+                        /* Anything logged after std::endl in the same statement starts a new entry, without a header
+                        */
+                        m_staging->reset();
+                        if (m_staging->activeSink & TO_FILE_BINARY)
+                            beginBinaryEntry (m_staging, false);
+                        return *this;
+                    }
+
+                    /* Templated overload operator,
+                     * reference: https://stackoverflow.com/questions/17595957/operator-overloading-in-c-for-logging-purposes
+                    */
+                    template <typename T>
+                    Statement& operator << (const T& data) {
+                        if (m_staging->activeSink & ~TO_FILE_BINARY)
+                            appendText (m_staging->text, data);
+
+                        if (m_staging->activeSink & TO_FILE_BINARY)
+                            appendBinaryArg (m_staging, data);
+
+                        return *this;
+                    }
+            };
+
             Record (uint32_t instanceId,
                     std::string callingFile,
                     std::string saveDir,
@@ -123,14 +458,26 @@ namespace Log {
                 m_bufferCapacity = bufferCapacity;
                 m_format         = format;
 
-                m_levelConfig.insert ({INFO,    TO_NONE});
-                m_levelConfig.insert ({WARNING, TO_NONE});
-                m_levelConfig.insert ({ERROR,   TO_NONE});
+                for (auto& sink: m_levelConfig)
+                    sink = TO_NONE;
+                m_levelMask          = 0;
 
-                m_activeSink         = TO_NONE;
                 m_fileImmediateReady = false;
                 m_fileBufferedReady  = false;
 
+                m_asyncSink          = nullptr;
+                m_asyncCapacity      = 1024;
+                m_asyncPolicy        = BLOCK;
+                m_fileAsyncReady     = false;
+
+                m_binaryLastTimestamp   = 0;
+                m_binaryEntryWritten    = false;
+                m_fileBinaryReady       = false;
+
+                m_mappedSlotCount       = 1024;
+                m_mappedSlotSize        = 256;
+                m_fileMappedReady       = false;
+
                 /* Strip file path and file extension to get just its name
                 */
                 size_t strip_start = m_callingFile.find_last_of ("\\/") + 1;
@@ -142,8 +489,12 @@ namespace Log {
                 clearConfig();
             }
 
+            /* Configuration is not synchronized with logging, sinks need to be configured (and cleared) while no other
+             * thread is logging to the record
+            */
             void addConfig (e_level level, e_sink sink, const char* nameExtension = "") {
                 m_levelConfig[level] = sink;
+                updateLevelMask();
                 /* Open file, note that for this sink we are in append mode
                 */
                 if (!m_fileImmediateReady && (sink & TO_FILE_IMMEDIATE)) {
@@ -184,6 +535,100 @@ namespace Log {
 
                     m_fileBufferedReady = true;
                 }
+
+                if (!m_fileAsyncReady && (sink & TO_FILE_ASYNC)) {
+                    m_saveFilePathAsync     = m_saveDir + "a_" +
+                                              std::to_string (m_instanceId) + "_" +
+                                              m_callingFile +
+                                              nameExtension +
+                                              m_format;
+
+                    m_asyncSink = new AsyncSink (m_instanceId, m_asyncCapacity, m_asyncPolicy);
+                    if (!m_asyncSink->open (m_saveFilePathAsync)) {
+                        delete m_asyncSink;
+                        m_asyncSink = nullptr;
+                        throw std::runtime_error ("Failed to open file for TO_FILE_ASYNC sink");
+                    }
+                    g_asyncWriter.registerSink (m_asyncSink);
+                    m_fileAsyncReady = true;
+                }
+
+                if (!m_fileBinaryReady && (sink & TO_FILE_BINARY)) {
+                    m_saveFilePathBinary    = m_saveDir + "d_" +
+                                              std::to_string (m_instanceId) + "_" +
+                                              m_callingFile +
+                                              nameExtension +
+                                              ".bin";
+                    /* The stream is only flushed when it fills up or when the sink is closed, pubsetbuf needs to be
+                     * called before the file is opened to take effect
+                    */
+                    m_binaryFileBuffer.resize (64 * 1024);
+                    m_saveFileBinary.rdbuf()->pubsetbuf (m_binaryFileBuffer.data(),
+                                                         static_cast <std::streamsize> (m_binaryFileBuffer.size()));
+                    m_saveFileBinary.open (m_saveFilePathBinary,
+                                           std::ios_base::out | std::ios_base::binary);
+
+                    if (!m_saveFileBinary.is_open())
+                        throw std::runtime_error ("Failed to open file for TO_FILE_BINARY sink");
+                    /* A new file starts with no definitions
+                    */
+                    m_callSitesWritten.clear();
+                    m_callSiteShapes.clear();
+                    m_stringsWritten.clear();
+                    m_binaryLastTimestamp = 0;
+                    m_binaryEntryWritten  = false;
+
+                    std::string fileHeader;
+                    fileHeader.append (BinaryFormat::MAGIC, sizeof (BinaryFormat::MAGIC));
+                    appendRaw (fileHeader, BinaryFormat::VERSION);
+                    appendRaw (fileHeader, m_instanceId);
+                    m_saveFileBinary.write (fileHeader.data(), static_cast <std::streamsize> (fileHeader.size()));
+
+                    m_fileBinaryReady = true;
+                }
+
+                if (!m_fileMappedReady && (sink & TO_FILE_MAPPED_CIRCULAR)) {
+                    m_saveFilePathMapped    = m_saveDir + "m_" +
+                                              std::to_string (m_instanceId) + "_" +
+                                              m_callingFile +
+                                              nameExtension +
+                                              ".ring";
+
+                    if (!m_mappedRing.open (m_saveFilePathMapped, m_instanceId, m_mappedSlotCount, m_mappedSlotSize))
+                        throw std::runtime_error ("Failed to map file for TO_FILE_MAPPED_CIRCULAR sink");
+
+                    m_fileMappedReady = true;
+                }
+            }
+
+            /* Slot count and slot size (including a 16 byte slot header) for the mapped circular sink, the file holds
+             * the last slot count entries. This needs to be set before the mapped sink is added to the config
+            */
+            void setMappedConfig (uint32_t slotCount, uint32_t slotSize) {
+                if (slotCount == 0 || slotSize <= sizeof (MappedRingFormat::SlotHeader))
+                    throw std::runtime_error ("Slot count/size invalid for TO_FILE_MAPPED_CIRCULAR sink");
+                /* Every slot starts with the atomic sequence number of its entry, which needs its natural alignment
+                */
+                if (slotSize % alignof (MappedRingFormat::SlotHeader) != 0)
+                    throw std::runtime_error ("Slot size not aligned for TO_FILE_MAPPED_CIRCULAR sink");
+
+                m_mappedSlotCount = slotCount;
+                m_mappedSlotSize  = slotSize;
+            }
+
+            /* Queue capacity and backpressure policy for the async sink, this needs to be set before the async sink is
+             * added to the config
+            */
+            void setAsyncConfig (size_t capacity, e_backpressure policy) {
+                if (capacity == 0)
+                    throw std::runtime_error ("Queue capacity invalid for TO_FILE_ASYNC sink");
+
+                m_asyncCapacity = capacity;
+                m_asyncPolicy   = policy;
+            }
+
+            uint64_t getAsyncDroppedCount (void) {
+                return m_asyncSink != nullptr ? m_asyncSink->getDroppedCount(): 0;
             }
 
             /* Clear config method should be used to overwrite an existing configuration. Since the overwrite may include
@@ -212,12 +657,49 @@ namespace Log {
                     }
                 }
 
+                if (allSinks & TO_FILE_ASYNC) {
+                    /* Writer thread drains whatever is left in the queue before letting go of the sink
+                    */
+                    g_asyncWriter.unregisterSink (m_asyncSink);
+                    m_asyncSink->close();
+                    delete m_asyncSink;
+                    m_asyncSink = nullptr;
+
+                    if (deleteEmptyFiles) {
+                        std::fstream saveFileAsync (m_saveFilePathAsync, std::ios_base::in);
+                        deleteEmptyFile (saveFileAsync, m_saveFilePathAsync.c_str());
+                    }
+                }
+
+                if (allSinks & TO_FILE_BINARY) {
+                    m_saveFileBinary.close();
+                    /* The file always holds the file header, so it is considered empty if no entry was written
+                    */
+                    if (deleteEmptyFiles && !m_binaryEntryWritten) {
+                        if (remove (m_saveFilePathBinary.c_str()) != 0)
+                            throw std::runtime_error ("Failed to delete file");
+                    }
+                }
+
+                if (allSinks & TO_FILE_MAPPED_CIRCULAR) {
+                    bool isEmpty = m_mappedRing.isEmpty();
+                    m_mappedRing.close();
+                    if (deleteEmptyFiles && isEmpty) {
+                        if (remove (m_saveFilePathMapped.c_str()) != 0)
+                            throw std::runtime_error ("Failed to delete file");
+                    }
+                }
+
                 m_levelConfig[INFO]    = TO_NONE;
                 m_levelConfig[WARNING] = TO_NONE;
                 m_levelConfig[ERROR]   = TO_NONE;
+                m_levelMask            = 0;
 
                 m_fileImmediateReady   = false;
                 m_fileBufferedReady    = false;
+                m_fileAsyncReady       = false;
+                m_fileBinaryReady      = false;
+                m_fileMappedReady      = false;
             }
 
             inline Record& getReference (void) {
@@ -226,23 +708,19 @@ namespace Log {
 
             e_sink getSink (void) {
                 auto allSinks = TO_NONE;
-                for (auto const& [level, sink]: m_levelConfig)
-                    allSinks = allSinks | sink;
+                for (auto const& level: {INFO, WARNING, ERROR})
+                    allSinks = allSinks | m_levelConfig[level];
 
                 return allSinks;
             }
 
             e_level getLevel (void) {
-                auto allLevels = NONE;
-                for (auto const& [level, sink]: m_levelConfig) {
-                    if (sink != TO_NONE)
-                        allLevels = allLevels | level;
-                }
-
-                return allLevels;
+                return static_cast <e_level> (m_levelMask);
             }
 
-            std::string getHeader (e_level level,
+            /* The returned header is only valid until the next call on this thread, since the buffer is reused
+            */
+            const char* getHeader (e_level level,
                                    const char* callingFunction,
                                    uint32_t line,
                                    bool enHeader) {
@@ -250,73 +728,61 @@ namespace Log {
                 */
                 if (enHeader == false)
                     return "";
-
-                std::string instanceId = std::to_string (m_instanceId);
-                /* Pad m_instanceId string for single digit ids
+                /* Reserve room at the end of the buffer for the line number, separators and null terminator, only the
+                 * calling function name can get long enough to need truncating
                 */
-                if (m_instanceId < 10)
-                    instanceId.insert (0, 1, '0');
-
-                std::string header = "[" + instanceId + "]" +
-                                     " " +
-                                     getLocalTimestamp() +
-                                     " " +
-                                     "[" + getLevelString (level) + "]"
-                                     + " " +
-                                     callingFunction +
-                                     " " +
-                                     std::to_string (line) +
-                                     " ";
-
-                return header;
-            }
-
-            bool isSinkPresent (e_level level) {
-                /* Set active sink, this will decide where the logging will output to for this level
+                char* headerBuffer = t_headerFormatter.headerBuffer;
+                char* dst          = headerBuffer;
+                const char* end    = headerBuffer + sizeof (t_headerFormatter.headerBuffer) - 16;
+                /* Pad instance id for single digit ids
                 */
-                m_activeSink = m_levelConfig[level];
-                return m_activeSink == TO_NONE ? false: true;
+                *dst++ = '[';
+                dst    = writeUnsigned (dst, m_instanceId, 2);
+                *dst++ = ']';
+                *dst++ = ' ';
+                dst    = writeLocalTimestamp (dst);
+                *dst++ = ' ';
+                *dst++ = '[';
+                dst    = writeString (dst, end, getLevelString (level));
+                *dst++ = ']';
+                *dst++ = ' ';
+                dst    = writeString (dst, end, callingFunction);
+                *dst++ = ' ';
+                dst    = writeUnsigned (dst, line);
+                *dst++ = ' ';
+                *dst   = '\0';
+
+                return headerBuffer;
             }
 
-            /* Overload for std::endl
+            /* Starts a log statement, the header goes to the text sinks while the binary sink only records the call site
+             * id. The call site id is fetched through the passed in function, which holds the id in a static local
+             * variable at the call site, so that text only logging never has to touch it
             */
-            Record& operator << (endl_type endl){
-                if (m_activeSink & TO_FILE_IMMEDIATE && m_saveFileImmediate.is_open())
-                    m_saveFileImmediate << endl;
-
-                if (m_activeSink & TO_CONSOLE)
-                    std::cout << endl;
-
-                /* For buffered sink, instead of inserting a new line we push the log entry into the buffer
-                */
-                if (m_activeSink & TO_FILE_BUFFER_CIRCULAR) {
-                    auto logBuffer = GET_BUFFER (RESERVED_ID_LOG_SINK + m_instanceId, std::string);
-                    logBuffer->BUFFER_PUSH (m_bufferedSinkHolder);
-                    /* Clear after flush
-                    */
-                    m_bufferedSinkHolder = "";
+            template <typename T>
+            Statement beginEntry (e_level level,
+                                  const char* callingFunction,
+                                  uint32_t line,
+                                  bool enHeader,
+                                  T getCallSiteId) {
+
+                Staging* staging    = t_stagingStack.acquire();
+                staging->activeSink = m_levelConfig[level];
+                staging->level      = level;
+                staging->enHeader   = enHeader;
+
+                if (staging->activeSink & ~TO_FILE_BINARY)
+                    staging->text += getHeader (level, callingFunction, line, enHeader);
+
+                if (staging->activeSink & TO_FILE_BINARY) {
+                    staging->callSiteId = getCallSiteId (callingFunction);
+                    beginBinaryEntry (staging, enHeader);
                 }
-
-                return *this;
+                return Statement (this, staging);
             }
 
-            /* Templated overload operator,
-             * reference: https://stackoverflow.com/questions/17595957/operator-overloading-in-c-for-logging-purposes
-            */
-            template <typename T>
-            Record& operator << (const T& data) {
-                if (m_activeSink & TO_FILE_IMMEDIATE && m_saveFileImmediate.is_open())
-                    m_saveFileImmediate << data;
-
-                if (m_activeSink & TO_CONSOLE)
-                    std::cout << data;
-
-                /* Hold till we flush it upon std::endl
-                */
-                if (m_activeSink & TO_FILE_BUFFER_CIRCULAR)
-                    m_bufferedSinkHolder += to_string (data);
-
-                return *this;
+            inline bool isSinkPresent (e_level level) {
+                return (m_levelMask & level) != 0;
             }
     };
 }   // namespace Log
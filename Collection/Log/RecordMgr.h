@@ -48,13 +48,24 @@ namespace Log {
                     ;
             }
 
+            /* Blocks until every entry pushed to an async sink so far has been written out to its file
+            */
+            void flushAllRecords (void) {
+                g_asyncWriter.flush();
+            }
+
+            /* Async sinks are flushed first so that no entry is lost, and the writer thread is stopped only after all
+             * records (and their async sinks) are gone
+            */
             void closeAllRecords (void) {
+                flushAllRecords();
                 for (auto const& [key, val]: m_instancePool) {
                     Record* c_record = static_cast <Record*> (val);
                     delete c_record;
                     BUFFER_CLOSE (RESERVED_ID_LOG_SINK + key);
                 }
                 m_instancePool.clear();
+                g_asyncWriter.shutdown();
             }
 
             /* Clear all configs can be used to disable logging at a global level. Note that, the log objects still exist
@@ -0,0 +1,220 @@
+#ifndef STAGING_H
+#define STAGING_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <type_traits>
+#include <charconv>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+#include <algorithm>
+
+namespace Collection {
+namespace Log {
+    /* Append only byte buffer for the binary sink's staging. Appending to a std::string goes through an out of line call
+     * for every argument, whereas here the common case (the bytes fit in the capacity) is a compare and a copy. The
+     * capacity is kept across clears
+    */
+    class ByteHolder {
+        private:
+            std::vector <char> m_bytes;
+            size_t m_size = 0;
+
+            void grow (size_t length) {
+                m_bytes.resize (std::max (m_bytes.size() * 2, m_size + length + 64));
+            }
+
+        public:
+            inline void push_back (char byte) {
+                if (m_size == m_bytes.size())
+                    grow (1);
+                m_bytes[m_size++] = byte;
+            }
+
+            inline void append (const char* data, size_t length) {
+                if (m_size + length > m_bytes.size())
+                    grow (length);
+                memcpy (m_bytes.data() + m_size, data, length);
+                m_size += length;
+            }
+
+            inline const char* data (void) const {
+                return m_bytes.data();
+            }
+
+            inline size_t size (void) const {
+                return m_size;
+            }
+
+            inline std::string_view view (void) const {
+                return std::string_view (m_bytes.data(), m_size);
+            }
+
+            inline void clear (void) {
+                m_size = 0;
+            }
+    };
+
+    /* A log statement is built up in a staging area owned by the calling thread, and is committed to the sinks as a
+     * whole line upon std::endl. Two threads logging to the same record therefore never see each other's partial
+     * entries, and the pieces of a statement need no synchronization at all
+    */
+    struct Staging {
+        uint32_t activeSink;
+        uint32_t level;
+        bool enHeader;
+        /* Text for the text sinks (file, console, buffered, async and mapped), header included
+        */
+        std::string text;
+        /* Binary sink entry, see BinaryFormat.h. Interned strings used by the entry are collected so that their
+         * definitions can be written ahead of the entry when it is committed
+        */
+        uint32_t callSiteId;
+        uint64_t timestamp;
+        ByteHolder binaryShape;
+        ByteHolder binaryPayload;
+        std::vector <std::pair <uint32_t, const std::string*>> binaryStrings;
+
+        void reset (void) {
+            text.clear();
+            binaryShape.clear();
+            binaryPayload.clear();
+            binaryStrings.clear();
+        }
+    };
+
+    /* Stagings are reused across statements so that their buffers keep their capacity. A statement may log from within
+     * its own arguments (a function which logs, called in the middle of a statement), so each thread holds a stack of
+     * stagings rather than a single one
+    */
+    class StagingStack {
+        private:
+            std::vector <std::unique_ptr <Staging>> m_stagings;
+            size_t m_depth;
+
+        public:
+            StagingStack (void) {
+                m_depth = 0;
+            }
+
+            Staging* acquire (void) {
+                if (m_depth == m_stagings.size())
+                    m_stagings.push_back (std::make_unique <Staging>());
+
+                Staging* staging = m_stagings[m_depth++].get();
+                staging->reset();
+                return staging;
+            }
+
+            void release (void) {
+                m_depth--;
+            }
+    };
+    thread_local StagingStack t_stagingStack;
+
+    /* Header is formatted into this buffer, which is reused for every log statement on the thread. The wall clock part
+     * of the timestamp only changes once a second, so it is formatted once and cached along with the second it belongs
+     * to
+    */
+    struct HeaderFormatter {
+        char headerBuffer[256]      = {'\0'};
+        char cachedTimestamp[32]    = {'\0'};
+        size_t cachedTimestampLength = 0;
+        time_t cachedSecond         = -1;
+    };
+    thread_local HeaderFormatter t_headerFormatter;
+
+    /* String literals logged to the binary sink are interned by their address, ids are process wide and each binary
+     * file writes the definition of an id the first time it uses it. Strings are held in a deque so that a reference
+     * to a stored string stays valid as more strings are added, which lets each thread cache lookups without holding
+     * the lock
+    */
+    class StringInternTable {
+        private:
+            std::mutex m_mutex;
+            std::deque <std::string> m_strings;
+            std::unordered_map <const char*, uint32_t> m_stringIds;
+
+        public:
+            std::pair <uint32_t, const std::string*> intern (const char* data, size_t length) {
+                std::lock_guard <std::mutex> lock (m_mutex);
+                auto it = m_stringIds.find (data);
+                if (it == m_stringIds.end()) {
+                    m_strings.emplace_back (data, length);
+                    it = m_stringIds.insert ({data, static_cast <uint32_t> (m_strings.size() - 1)}).first;
+                }
+                return {it->second, &m_strings[it->second]};
+            }
+    };
+    StringInternTable g_stringInternTable;
+
+    /* Each thread caches its lookups in a small direct mapped table (by address) in front of a map of its own, so a
+     * literal seen before costs a compare
+    */
+    class StringInternCache {
+        private:
+            struct Slot {
+                const char* data = nullptr;
+                std::pair <uint32_t, const std::string*> internedString;
+            };
+            static const size_t SLOT_COUNT = 256;
+            Slot m_slots[SLOT_COUNT];
+            std::unordered_map <const char*, std::pair <uint32_t, const std::string*>> m_internedStrings;
+
+        public:
+            std::pair <uint32_t, const std::string*> intern (const char* data, size_t length) {
+                auto& slot = m_slots[(reinterpret_cast <uintptr_t> (data) >> 2) % SLOT_COUNT];
+                if (slot.data != data) {
+                    auto it = m_internedStrings.find (data);
+                    if (it == m_internedStrings.end())
+                        it = m_internedStrings.insert ({data, g_stringInternTable.intern (data, length)}).first;
+
+                    slot.data           = data;
+                    slot.internedString = it->second;
+                }
+                return slot.internedString;
+            }
+    };
+    thread_local StringInternCache t_stringInternCache;
+
+    /* Append to text the same way an output stream would print the value (floating point values use the default
+     * stream precision of 6 significant digits), without going through a stream or a temporary string
+    */
+    template <typename T>
+    void appendText (std::string& text, const T& data) {
+        if constexpr (std::is_convertible_v <T, std::string_view>)
+            text += std::string_view (data);
+
+        else if constexpr (std::is_enum_v <T>)
+            appendText (text, static_cast <std::underlying_type_t <T>> (data));
+
+        else if constexpr (std::is_same_v <T, bool>)
+            text += data ? '1': '0';
+
+        else if constexpr (std::is_same_v <T, char>        ||
+                           std::is_same_v <T, signed char> ||
+                           std::is_same_v <T, unsigned char>)
+            text += static_cast <char> (data);
+
+        else if constexpr (std::is_floating_point_v <T>) {
+            char digits[32];
+            auto result = std::to_chars (digits, digits + sizeof (digits), data, std::chars_format::general, 6);
+            text.append (digits, static_cast <size_t> (result.ptr - digits));
+        }
+        else if constexpr (std::is_integral_v <T>) {
+            char digits[24];
+            auto result = std::to_chars (digits, digits + sizeof (digits), data);
+            text.append (digits, static_cast <size_t> (result.ptr - digits));
+        }
+        else
+            text += std::to_string (data);
+    }
+}   // namespace Log
+}   // namespace Collection
+#endif  // STAGING_H
\ No newline at end of file
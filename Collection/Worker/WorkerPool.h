@@ -0,0 +1,180 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+/* Number of threads a parallel for runs on, the calling thread included. Zero picks one thread per hardware thread,
+ * one runs everything on the calling thread
+*/
+#ifndef WORKER_THREAD_COUNT
+    #define WORKER_THREAD_COUNT                 (0)
+#endif  // WORKER_THREAD_COUNT
+
+namespace Collection {
+namespace Worker {
+    /* Set on the worker threads, and on the calling thread for the duration of a parallel for. A parallel for issued
+     * from within one runs on the calling thread, since the workers are all busy with the outer one
+    */
+    thread_local bool t_insideParallelFor = false;
+
+    /* A fixed set of worker threads, started lazily on the first parallel for. One parallel for runs at a time, the
+     * calling thread takes part in it and returns once every index has been processed
+    */
+    class WorkerPool {
+        private:
+            std::vector <std::thread> m_threads;
+            /* Serializes parallel for calls from different threads
+            */
+            std::mutex m_submitMutex;
+            std::mutex m_mutex;
+            std::condition_variable m_wakeCondition;
+            std::condition_variable m_doneCondition;
+            bool m_running;
+            /* Every worker takes part in every job, a job is complete once all the workers have reported back, which
+             * means that no worker can still be looking at it when the next job is posted
+            */
+            uint64_t m_jobGeneration;
+            size_t m_finishedCount;
+
+            std::function <void (size_t)> m_body;
+            size_t m_count;
+            std::atomic <size_t> m_nextIdx;
+            /* First exception thrown by the body, rethrown on the calling thread
+            */
+            std::exception_ptr m_exception;
+
+            void runJob (void) {
+                size_t idx;
+                while ((idx = m_nextIdx.fetch_add (1, std::memory_order_relaxed)) < m_count) {
+                    try {
+                        m_body (idx);
+                    }
+                    catch (...) {
+                        std::lock_guard <std::mutex> lock (m_mutex);
+                        if (!m_exception)
+                            m_exception = std::current_exception();
+                    }
+                }
+            }
+
+            void run (void) {
+                t_insideParallelFor = true;
+                uint64_t jobGeneration = 0;
+
+                std::unique_lock <std::mutex> lock (m_mutex);
+                while (true) {
+                    m_wakeCondition.wait (lock, [&]() {
+                        return !m_running || m_jobGeneration != jobGeneration;
+                    });
+                    if (!m_running)
+                        break;
+
+                    jobGeneration = m_jobGeneration;
+                    lock.unlock();
+                    runJob();
+                    lock.lock();
+
+                    if (++m_finishedCount == m_threads.size())
+                        m_doneCondition.notify_one();
+                }
+            }
+
+            void start (void) {
+                size_t threadCount = getThreadCount();
+                m_running = true;
+                for (size_t i = 0; i + 1 < threadCount; i++)
+                    m_threads.emplace_back (&WorkerPool::run, this);
+            }
+
+        public:
+            WorkerPool (void) {
+                m_running       = false;
+                m_jobGeneration = 0;
+                m_finishedCount = 0;
+                m_count         = 0;
+                m_nextIdx.store (0, std::memory_order_relaxed);
+            }
+
+            ~WorkerPool (void) {
+                shutdown();
+            }
+
+            /* Number of threads a parallel for runs on, which callers can use to size the work they split up
+            */
+            static size_t getThreadCount (void) {
+                size_t threadCount = WORKER_THREAD_COUNT;
+                if (threadCount == 0)
+                    threadCount = std::max (1u, std::thread::hardware_concurrency());
+                return threadCount;
+            }
+
+            /* Run body for every index in [0, count), in no particular order. Exceptions thrown by the body do not stop
+             * the remaining indices from running, the first one is rethrown once they are done
+            */
+            void parallelFor (size_t count, const std::function <void (size_t)>& body) {
+                if (count == 0)
+                    return;
+
+                if (t_insideParallelFor || count == 1) {
+                    for (size_t i = 0; i < count; i++)
+                        body (i);
+                    return;
+                }
+
+                std::lock_guard <std::mutex> submitLock (m_submitMutex);
+                {
+                    std::lock_guard <std::mutex> lock (m_mutex);
+                    if (!m_running)
+                        start();
+
+                    m_body          = body;
+                    m_count         = count;
+                    m_exception     = nullptr;
+                    m_finishedCount = 0;
+                    m_nextIdx.store (0, std::memory_order_relaxed);
+                    m_jobGeneration++;
+                }
+                m_wakeCondition.notify_all();
+
+                t_insideParallelFor = true;
+                runJob();
+                t_insideParallelFor = false;
+
+                std::exception_ptr exception;
+                {
+                    std::unique_lock <std::mutex> lock (m_mutex);
+                    m_doneCondition.wait (lock, [&]() {
+                        return m_finishedCount == m_threads.size();
+                    });
+                    m_body    = nullptr;
+                    exception = m_exception;
+                }
+                if (exception)
+                    std::rethrow_exception (exception);
+            }
+
+            void shutdown (void) {
+                {
+                    std::lock_guard <std::mutex> lock (m_mutex);
+                    if (!m_running)
+                        return;
+                    m_running = false;
+                }
+                m_wakeCondition.notify_all();
+
+                for (auto& thread: m_threads)
+                    thread.join();
+                m_threads.clear();
+            }
+    };
+    WorkerPool g_workerPool;
+}   // namespace Worker
+}   // namespace Collection
+#endif  // WORKER_POOL_H
\ No newline at end of file
@@ -46,12 +46,64 @@ namespace Core {
                              &bufferInfo->meta.bufferMapped);
             }
 
-            void updateStorageBuffer (uint32_t bufferInfoId,
-                                      VkDeviceSize size,
-                                      const void* data) {
+            /* Storage buffer in device local memory for data that rarely changes, which is shared by all the frames in
+             * flight. It is written through transfers from a staging buffer (see createStorageStagingBuffer)
+            */
+            void createDeviceStorageBuffer (uint32_t deviceInfoId,
+                                            uint32_t bufferInfoId,
+                                            VkDeviceSize size) {
 
-                auto bufferInfo = getBufferInfo (bufferInfoId, STORAGE_BUFFER);
-                memcpy (bufferInfo->meta.bufferMapped, data, static_cast <size_t> (size));
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto bufferShareQueueFamilyIndices = std::vector {
+                    deviceInfo->meta.graphicsFamilyIndex.value()
+                };
+
+                createBuffer (deviceInfoId,
+                              bufferInfoId,
+                              STORAGE_BUFFER,
+                              size,
+                              VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                              VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                              bufferShareQueueFamilyIndices);
+            }
+
+            /* Staging buffer for a device local storage buffer, mapped for its lifetime. The copies out of it are
+             * recorded in the frame's command buffer, so it is owned by the graphics queue family
+            */
+            void createStorageStagingBuffer (uint32_t deviceInfoId,
+                                             uint32_t bufferInfoId,
+                                             VkDeviceSize size) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto bufferShareQueueFamilyIndices = std::vector {
+                    deviceInfo->meta.graphicsFamilyIndex.value()
+                };
+
+                createBuffer (deviceInfoId,
+                              bufferInfoId,
+                              STAGING_BUFFER,
+                              size,
+                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                              bufferShareQueueFamilyIndices);
+
+                auto bufferInfo = getBufferInfo (bufferInfoId, STAGING_BUFFER);
+                vkMapMemory (deviceInfo->resource.logDevice,
+                             bufferInfo->resource.bufferMemory,
+                             0,
+                             size,
+                             0,
+                             &bufferInfo->meta.bufferMapped);
+            }
+
+            /* The buffer stays mapped for its lifetime, it is written through this pointer directly (see
+             * writeInstances)
+            */
+            void* getStorageBufferMapped (uint32_t bufferInfoId, e_bufferType type = STORAGE_BUFFER) {
+                auto bufferInfo = getBufferInfo (bufferInfoId, type);
+                return bufferInfo->meta.bufferMapped;
             }
     };
 }   // namespace Core
@@ -94,6 +94,57 @@ namespace Core {
                                  &copyRegion);
             }
 
+            /* Copy a set of regions (only parts of the buffers) in one command
+            */
+            void copyBufferRegionsToBuffer (uint32_t srcBufferInfoId,
+                                            uint32_t dstBufferInfoId,
+                                            e_bufferType srcBufferType,
+                                            e_bufferType dstBufferType,
+                                            const std::vector <VkBufferCopy>& copyRegions,
+                                            VkCommandBuffer commandBuffer) {
+
+                auto srcBufferInfo = getBufferInfo (srcBufferInfoId, srcBufferType);
+                auto dstBufferInfo = getBufferInfo (dstBufferInfoId, dstBufferType);
+                vkCmdCopyBuffer (commandBuffer,
+                                 srcBufferInfo->resource.buffer,
+                                 dstBufferInfo->resource.buffer,
+                                 static_cast <uint32_t> (copyRegions.size()),
+                                 copyRegions.data());
+            }
+
+            /* Buffer memory barrier over the whole buffer, the buffer equivalent of the image memory barrier used in
+             * transitionImageLayout (without the layouts)
+            */
+            void bufferMemoryBarrier (uint32_t bufferInfoId,
+                                      e_bufferType type,
+                                      VkAccessFlags srcAccessMask,
+                                      VkAccessFlags dstAccessMask,
+                                      VkPipelineStageFlags sourceStage,
+                                      VkPipelineStageFlags destinationStage,
+                                      VkCommandBuffer commandBuffer) {
+
+                auto bufferInfo = getBufferInfo (bufferInfoId, type);
+
+                VkBufferMemoryBarrier barrier;
+                barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                barrier.pNext               = VK_NULL_HANDLE;
+                barrier.srcAccessMask       = srcAccessMask;
+                barrier.dstAccessMask       = dstAccessMask;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.buffer              = bufferInfo->resource.buffer;
+                barrier.offset              = 0;
+                barrier.size                = VK_WHOLE_SIZE;
+
+                vkCmdPipelineBarrier (commandBuffer,
+                                      sourceStage,
+                                      destinationStage,
+                                      0,
+                                      0, VK_NULL_HANDLE,
+                                      1, &barrier,
+                                      0, VK_NULL_HANDLE);
+            }
+
             /* One of the most common ways to perform layout transitions is using an image memory barrier. A pipeline
              * barrier like this is generally used to synchronize access to resources, like ensuring that a write to a
              * buffer completes before reading from it, but it can also be used to transition image layouts and transfer
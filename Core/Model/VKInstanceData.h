@@ -1,7 +1,11 @@
 #ifndef VK_INSTANCE_DATA_H
 #define VK_INSTANCE_DATA_H
 
-#include <json/single_include/nlohmann/json.hpp>
+#include <fstream>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+#include "VKInstanceFormat.h"
 #include "VKModelMatrix.h"
 
 namespace Core {
@@ -10,6 +14,107 @@ namespace Core {
             Log::Record* m_VKInstanceDataLog;
             const uint32_t m_instanceId = g_collectionSettings.instanceId++;
 
+            void resizeInstances (uint32_t modelInfoId, uint32_t instancesCount) {
+                auto modelInfo = getModelInfo (modelInfoId);
+                auto& meta     = modelInfo->meta;
+                /* A model keeps its slice of the instance arena as long as its number of instances does not change,
+                 * otherwise its instances move out to a vector of their own until it is given a new slice (see
+                 * readyInstanceArena)
+                */
+                if (meta.instances.size() != instancesCount) {
+                    std::vector <InstanceDataSSBO> instances (meta.instances.begin(), meta.instances.end());
+                    std::vector <StaticInstanceDataSSBO> staticInstances (meta.staticInstances.begin(),
+                                                                          meta.staticInstances.end());
+                    instances.resize       (instancesCount);
+                    staticInstances.resize (instancesCount);
+
+                    meta.instancesStorage       = std::move (instances);
+                    meta.staticInstancesStorage = std::move (staticInstances);
+                    meta.instances              = meta.instancesStorage;
+                    meta.staticInstances        = meta.staticInstancesStorage;
+                    meta.firstArenaInstance     = UINT32_MAX;
+                    meta.drawOrder.resize (instancesCount);
+                    std::iota (meta.drawOrder.begin(), meta.drawOrder.end(), 0);
+                }
+                meta.instanceDatas.resize (instancesCount);
+                meta.modelMatrices.resize (instancesCount);
+                meta.instancesCount = instancesCount;
+            }
+
+            /* Returns an empty string on success, and what went wrong otherwise
+            */
+            std::string readInstanceDataJson (uint32_t modelInfoId, const char* instanceDataPath) {
+                auto modelInfo = getModelInfo (modelInfoId);
+                std::ifstream fJson (instanceDataPath, std::ios_base::in | std::ios_base::binary);
+                if (!fJson.is_open())
+                    return "Failed to open file";
+
+                InstanceDataJsonReader reader (
+                    [&](uint32_t instancesCount) {
+                        resizeInstances (modelInfoId, instancesCount);
+                        return true;
+                    },
+                    [&](uint32_t modelInstanceId, const InstanceDataFormat::Record& record) {
+                        if (modelInstanceId >= modelInfo->meta.instancesCount)
+                            return false;
+
+                        auto& instanceData          = modelInfo->meta.instanceDatas[modelInstanceId];
+                        instanceData.position       = {record.position[0], record.position[1], record.position[2]};
+                        instanceData.rotateAxis     = {record.rotateAxis[0], record.rotateAxis[1], record.rotateAxis[2]};
+                        instanceData.scale          = {record.scale[0], record.scale[1], record.scale[2]};
+                        instanceData.rotateAngleDeg = record.rotateAngleDeg;
+                        return true;
+                    }
+                );
+                /* The stream is read through its buffer as the parser goes, the file is never held in memory as a whole
+                */
+                if (!nlohmann::json::sax_parse (fJson, &reader))
+                    return reader.getErrorMessage().empty() ? "Failed to parse file": reader.getErrorMessage();
+                return std::string();
+            }
+
+            std::string readInstanceDataBinary (uint32_t modelInfoId, const char* instanceDataPath) {
+                auto modelInfo = getModelInfo (modelInfoId);
+                std::ifstream file (instanceDataPath, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+                if (!file.is_open())
+                    return "Failed to open file";
+
+                uint64_t fileSize = static_cast <uint64_t> (file.tellg());
+                if (fileSize < InstanceDataFormat::FILE_HEADER_SIZE)
+                    return "File is too small";
+
+                InstanceDataFormat::FileHeader fileHeader;
+                file.seekg (0);
+                file.read  (reinterpret_cast <char*> (&fileHeader), sizeof (fileHeader));
+
+                if (memcmp (fileHeader.magic, InstanceDataFormat::MAGIC, sizeof (InstanceDataFormat::MAGIC)) != 0)
+                    return "File is not an instance data file";
+                if (fileHeader.version    != InstanceDataFormat::VERSION ||
+                    fileHeader.recordSize != sizeof (InstanceDataFormat::Record))
+                    return "Unsupported instance data version";
+
+                uint64_t recordsSize = static_cast <uint64_t> (fileHeader.instancesCount) * fileHeader.recordSize;
+                /* Compared against the size left after the offset, so that a huge offset can not wrap the sum around
+                */
+                if (fileHeader.fileSize      != fileSize ||
+                    fileHeader.recordsOffset  > fileSize ||
+                    recordsSize               > fileSize - fileHeader.recordsOffset)
+                    return "File is truncated";
+                /* The records have the layout of the instance datas, so they are read in place
+                */
+                using InstanceDataType = std::remove_reference_t <decltype (modelInfo->meta.instanceDatas[0])>;
+                static_assert (sizeof (InstanceDataType) == sizeof (InstanceDataFormat::Record));
+                static_assert (std::is_trivially_copyable_v <InstanceDataType>);
+
+                resizeInstances (modelInfoId, fileHeader.instancesCount);
+                file.seekg (static_cast <std::streamoff> (fileHeader.recordsOffset));
+                file.read  (reinterpret_cast <char*> (modelInfo->meta.instanceDatas.data()),
+                            static_cast <std::streamsize> (recordsSize));
+                if (!file)
+                    return "Failed to read records";
+                return std::string();
+            }
+
         public:
             VKInstanceData (void) {
                 m_VKInstanceDataLog = LOG_INIT (m_instanceId, g_collectionSettings.logSaveDirPath);
@@ -66,80 +171,43 @@ namespace Core {
                 uint32_t writeIdx  = oldTexId / 4;
                 uint32_t offsetIdx = oldTexId % 4;
                 uint32_t mask      = UINT8_MAX << offsetIdx * 8;
-                uint32_t packet    = modelInfo->meta.instances[modelInstanceId].texIdLUT[writeIdx];
+                uint32_t packet    = modelInfo->meta.staticInstances[modelInstanceId].texIdLUT[writeIdx];
 
                 packet             = packet & ~mask;
                 packet             = packet | (newTexId << offsetIdx * 8);
 
-                modelInfo->meta.instances[modelInstanceId].texIdLUT[writeIdx] = packet;
+                modelInfo->meta.staticInstances[modelInstanceId].texIdLUT[writeIdx] = packet;
+                setStaticInstanceDirty (modelInfo, modelInstanceId);
             }
 
+            /* Import instance data from a *_Instances.json file (streamed through InstanceDataJsonReader, straight into
+             * the instance datas of the model) or from a binary *_Instances.bin file (read into them as is). Model
+             * matrices are created once every instance has been read, in parallel batches
+            */
             uint32_t importInstanceData (uint32_t modelInfoId, const char* instanceDataPath) {
                 auto modelInfo = getModelInfo (modelInfoId);
-                uint32_t instancesCount = 0;
-                /* Read and parse json file
-                */
-                std::ifstream fJson (instanceDataPath);
-                std::stringstream stream;
-
-                stream << fJson.rdbuf();
-                nlohmann::basic_json json;
-                /* When the input is not valid JSON, an exception of type parse_error is thrown. This exception contains
-                 * the position in the input where the error occurred, together with a diagnostic message and the last
-                 * read input token
-                */
-                try {
-                    json = nlohmann::json::parse (stream.str());
-                }
-                catch (nlohmann::json::parse_error& exception) {
+                bool isBinary  = std::filesystem::path (instanceDataPath).extension() ==
+                                 InstanceDataFormat::FILE_EXTENSION;
+
+                std::string errorMessage = isBinary ? readInstanceDataBinary (modelInfoId, instanceDataPath):
+                                                      readInstanceDataJson   (modelInfoId, instanceDataPath);
+                if (!errorMessage.empty()) {
                     LOG_WARNING (m_VKInstanceDataLog) << "Failed to import instance data "
                                                       << "[" << modelInfoId << "]"
                                                       << " "
                                                       << "[" << instanceDataPath << "]"
+                                                      << " "
+                                                      << "[" << errorMessage << "]"
                                                       << std::endl;
                     /* Set default instance data
                     */
-                    instancesCount = 1;
-                    modelInfo->meta.instances.resize     (instancesCount);
-                    modelInfo->meta.instanceDatas.resize (instancesCount);
-                    modelInfo->meta.instancesCount      = instancesCount;
-                    uint32_t modelInstanceId            = 0;
-
-                    modelInfo->meta.instanceDatas[modelInstanceId].position       = {0.0f, 0.0f, 0.0f};
-                    modelInfo->meta.instanceDatas[modelInstanceId].rotateAxis     = {0.0f, 1.0f, 0.0f};
-                    modelInfo->meta.instanceDatas[modelInstanceId].scale          = {1.0f, 1.0f, 1.0f};
-                    modelInfo->meta.instanceDatas[modelInstanceId].rotateAngleDeg = 0.0f;
-                    createModelMatrix (modelInfoId, modelInstanceId);
-                }
-
-                if (instancesCount == 0) {
-                    instancesCount  = json["instancesCount"];
-                    modelInfo->meta.instances.resize     (instancesCount);
-                    modelInfo->meta.instanceDatas.resize (instancesCount);
-                    modelInfo->meta.instancesCount      = instancesCount;
-
-                    for (auto const& instance: json["instances"]) {
-                        uint32_t modelInstanceId = instance["id"];
-
-                        modelInfo->meta.instanceDatas[modelInstanceId].position       = {
-                            instance["position"][0],
-                            instance["position"][1],
-                            instance["position"][2]
-                        };
-                        modelInfo->meta.instanceDatas[modelInstanceId].rotateAxis     = {
-                            instance["rotateAxis"][0],
-                            instance["rotateAxis"][1],
-                            instance["rotateAxis"][2]
-                        };
-                        modelInfo->meta.instanceDatas[modelInstanceId].scale          = {
-                            instance["scale"][0],
-                            instance["scale"][1],
-                            instance["scale"][2]
-                        };
-                        modelInfo->meta.instanceDatas[modelInstanceId].rotateAngleDeg = instance["rotateAngleDeg"];
-                        createModelMatrix (modelInfoId, modelInstanceId);
-                    }
+                    resizeInstances (modelInfoId, 1);
+                    modelInfo->meta.instanceDatas[0].position       = {0.0f, 0.0f, 0.0f};
+                    modelInfo->meta.instanceDatas[0].rotateAxis     = {0.0f, 1.0f, 0.0f};
+                    modelInfo->meta.instanceDatas[0].scale          = {1.0f, 1.0f, 1.0f};
+                    modelInfo->meta.instanceDatas[0].rotateAngleDeg = 0.0f;
                 }
+                createModelMatrices (modelInfoId);
                 return modelInfo->meta.instancesCount;
             }
     };
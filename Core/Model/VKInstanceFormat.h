@@ -0,0 +1,207 @@
+#ifndef VK_INSTANCE_FORMAT_H
+#define VK_INSTANCE_FORMAT_H
+
+#include <string>
+#include <functional>
+#include <json/single_include/nlohmann/json.hpp>
+
+namespace Core {
+    /* Layout of a binary instance data file (*_Instances.bin), an alternative to the *_Instances.json files that is read
+     * without any parsing. Tool/InstanceConverter converts between the two
+     *
+     * File header (FILE_HEADER_SIZE bytes)
+     *      char magic[8]               "ENINSTDT"
+     *      uint32_t version
+     *      uint32_t recordSize         sizeof (Record)
+     *      uint32_t instancesCount
+     *      uint32_t reserved
+     *      uint64_t recordsOffset
+     *      uint64_t fileSize
+     *
+     * Records, one per instance in the order of the instance ids
+    */
+    namespace InstanceDataFormat {
+        const char     MAGIC[8]         = {'E', 'N', 'I', 'N', 'S', 'T', 'D', 'T'};
+        const uint32_t VERSION          = 1;
+        const size_t   FILE_HEADER_SIZE = 64;
+        const char* const FILE_EXTENSION = ".bin";
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t recordSize;
+            uint32_t instancesCount;
+            uint32_t reserved;
+            uint64_t recordsOffset;
+            uint64_t fileSize;
+        };
+        static_assert (sizeof (FileHeader) <= FILE_HEADER_SIZE);
+
+        struct Record {
+            float position[3];
+            float rotateAxis[3];
+            float scale[3];
+            float rotateAngleDeg;
+        };
+        static_assert (sizeof (Record) == 40);
+    }   // namespace InstanceDataFormat
+
+    /* SAX handler for the *_Instances.json files, which hands over every instance as soon as its object has been read
+     * instead of building the document first. The layout it expects is
+     *
+     * {
+     *     "instancesCount": n,
+     *     "instances": [
+     *         {"id": 0, "position": [x, y, z], "rotateAxis": [x, y, z], "scale": [x, y, z], "rotateAngleDeg": a},
+     *         ...
+     *     ]
+     * }
+     *
+     * with instancesCount ahead of the instances. Fields missing from an instance keep their defaults (no translation or
+     * rotation, unit scale), other keys are skipped. Parsing stops at the first callback that returns false
+    */
+    class InstanceDataJsonReader: public nlohmann::json_sax <nlohmann::json> {
+        private:
+            std::function <bool (uint32_t)> m_onInstancesCount;
+            std::function <bool (uint32_t, const InstanceDataFormat::Record&)> m_onInstance;
+            /* Nesting of objects and arrays, the root object is at depth 1, the instances array at 2, an instance at 3
+             * and its vectors at 4
+            */
+            uint32_t m_depth;
+            bool m_insideInstances;
+            std::string m_key;
+            uint32_t m_elementIdx;
+
+            uint32_t m_modelInstanceId;
+            bool m_hasModelInstanceId;
+            InstanceDataFormat::Record m_record;
+            std::string m_errorMessage;
+
+            bool setError (const std::string& message) {
+                m_errorMessage = message;
+                return false;
+            }
+
+            bool setNumber (double value) {
+                if (m_depth == 1 && m_key == "instancesCount") {
+                    if (value < 0.0 || value > UINT32_MAX || !m_onInstancesCount (static_cast <uint32_t> (value)))
+                        return setError ("Invalid instances count");
+                    return true;
+                }
+                if (!m_insideInstances)
+                    return true;
+
+                if (m_depth == 3) {
+                    if (m_key == "id") {
+                        if (value < 0.0 || value > UINT32_MAX)
+                            return setError ("Invalid model instance id");
+                        m_modelInstanceId    = static_cast <uint32_t> (value);
+                        m_hasModelInstanceId = true;
+                    }
+                    else if (m_key == "rotateAngleDeg")
+                        m_record.rotateAngleDeg = static_cast <float> (value);
+                }
+                else if (m_depth == 4) {
+                    float* vector = m_key == "position"   ? m_record.position:
+                                    m_key == "rotateAxis" ? m_record.rotateAxis:
+                                    m_key == "scale"      ? m_record.scale: nullptr;
+                    if (vector != nullptr && m_elementIdx < 3)
+                        vector[m_elementIdx] = static_cast <float> (value);
+                    m_elementIdx++;
+                }
+                return true;
+            }
+
+        public:
+            InstanceDataJsonReader (const std::function <bool (uint32_t)>& onInstancesCount,
+                                    const std::function <bool (uint32_t, const InstanceDataFormat::Record&)>& onInstance) {
+                m_onInstancesCount   = onInstancesCount;
+                m_onInstance         = onInstance;
+                m_depth              = 0;
+                m_insideInstances    = false;
+                m_elementIdx         = 0;
+                m_modelInstanceId    = 0;
+                m_hasModelInstanceId = false;
+                m_record             = {};
+            }
+
+            const std::string& getErrorMessage (void) {
+                return m_errorMessage;
+            }
+
+            bool null (void) override {
+                return true;
+            }
+
+            bool boolean (bool) override {
+                return true;
+            }
+
+            bool number_integer (number_integer_t val) override {
+                return setNumber (static_cast <double> (val));
+            }
+
+            bool number_unsigned (number_unsigned_t val) override {
+                return setNumber (static_cast <double> (val));
+            }
+
+            bool number_float (number_float_t val, const string_t&) override {
+                return setNumber (val);
+            }
+
+            bool string (string_t&) override {
+                return true;
+            }
+
+            bool binary (binary_t&) override {
+                return true;
+            }
+
+            bool start_object (std::size_t) override {
+                m_depth++;
+                if (m_insideInstances && m_depth == 3) {
+                    m_record             = {{0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, 0.0f};
+                    m_hasModelInstanceId = false;
+                }
+                return true;
+            }
+
+            bool key (string_t& val) override {
+                m_key = val;
+                return true;
+            }
+
+            bool end_object (void) override {
+                bool instanceRead = m_insideInstances && m_depth == 3;
+                m_depth--;
+                if (!instanceRead)
+                    return true;
+
+                if (!m_hasModelInstanceId)
+                    return setError ("Missing model instance id");
+                if (!m_onInstance (m_modelInstanceId, m_record))
+                    return setError ("Invalid model instance id");
+                return true;
+            }
+
+            bool start_array (std::size_t) override {
+                m_depth++;
+                if (m_depth == 2 && m_key == "instances")
+                    m_insideInstances = true;
+                m_elementIdx = 0;
+                return true;
+            }
+
+            bool end_array (void) override {
+                if (m_depth == 2)
+                    m_insideInstances = false;
+                m_depth--;
+                return true;
+            }
+
+            bool parse_error (std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+                return setError (ex.what());
+            }
+    };
+}   // namespace Core
+#endif  // VK_INSTANCE_FORMAT_H
\ No newline at end of file
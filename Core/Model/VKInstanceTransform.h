@@ -0,0 +1,58 @@
+#ifndef VK_INSTANCE_TRANSFORM_H
+#define VK_INSTANCE_TRANSFORM_H
+
+#include <cmath>
+#include <glm/glm.hpp>
+#include "../Scene/VKUniform.h"
+
+namespace Core {
+    /* Instance transforms are written to the storage buffer in the layout picked by INSTANCE_TRANSFORM_FORMAT, the
+     * vertex shader decodes them back (see defaultShader.vert)
+     * (0) 4x4 model matrix, as is
+     * (1) 3x4 row major affine, the 4th row of a model matrix is always (0, 0, 0, 1) so it is left out. A vertex is
+     *     transformed with three dot products
+     * (2) Quaternion, translation and scale. Instances are only ever translated, rotated about an axis and scaled (see
+     *     VKModelMatrixBatch), so the model matrix is rebuilt exactly from them. A vertex is scaled, rotated by the
+     *     quaternion and translated
+    */
+    class VKInstanceTransform {
+        public:
+            /* Unit quaternion (x, y, z, w) rotating by the angle about the axis, the same rotation as glm::rotate
+            */
+            static glm::vec4 getRotation (const glm::vec3& rotateAxis, float rotateAngleDeg) {
+                float halfAngle = glm::radians (rotateAngleDeg) * 0.5f;
+                glm::vec3 axis  = glm::normalize (rotateAxis);
+                float sinHalf   = std::sin (halfAngle);
+                return glm::vec4 (axis.x * sinHalf, axis.y * sinHalf, axis.z * sinHalf, std::cos (halfAngle));
+            }
+
+            /* Write the transform of an instance, where the model matrix was composed from the instance data given
+            */
+            static void encodeTransform (InstanceDataSSBO& instance,
+                                         const glm::mat4& modelMatrix,
+                                         const glm::vec3& rotateAxis,
+                                         const glm::vec3& scale,
+                                         float rotateAngleDeg) {
+#if INSTANCE_TRANSFORM_FORMAT == INSTANCE_TRANSFORM_AFFINE_3X4
+                (void) rotateAxis;
+                (void) scale;
+                (void) rotateAngleDeg;
+                for (int i = 0; i < 3; i++)
+                    instance.modelRows[i] = glm::vec4 (modelMatrix[0][i],
+                                                       modelMatrix[1][i],
+                                                       modelMatrix[2][i],
+                                                       modelMatrix[3][i]);
+#elif INSTANCE_TRANSFORM_FORMAT == INSTANCE_TRANSFORM_QUATERNION
+                instance.rotation    = getRotation (rotateAxis, rotateAngleDeg);
+                instance.translation = glm::vec3 (modelMatrix[3]);
+                instance.scale       = glm::vec4 (scale, 0.0f);
+#else
+                (void) rotateAxis;
+                (void) scale;
+                (void) rotateAngleDeg;
+                instance.modelMatrix = modelMatrix;
+#endif  // INSTANCE_TRANSFORM_FORMAT
+            }
+    };
+}   // namespace Core
+#endif  // VK_INSTANCE_TRANSFORM_H
\ No newline at end of file
@@ -0,0 +1,232 @@
+#ifndef VK_MESH_OPTIMIZER_H
+#define VK_MESH_OPTIMIZER_H
+
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "VKVertexData.h"
+
+namespace Core {
+    /* Import time reordering of a model's index and vertex data, neither changes what is drawn
+     * (1) Triangles are reordered so that consecutive triangles share vertices, which lets the GPU reuse the vertex
+     *     shader output of a vertex still in its post transform cache instead of shading it again (Forsyth, "Linear-
+     *     Speed Vertex Cache Optimisation")
+     * (2) Vertices are then reordered to the order they are first used in by the index data, so that vertex fetches
+     *     walk through the vertex buffer instead of jumping around in it
+     *
+     * How well the index data uses the cache is measured as,
+     * ACMR (average cache miss ratio), vertices shaded per triangle. Ranges from 3 (no reuse) down to about 0.5 for a
+     * regular grid
+     * ATVR (average transformed vertex ratio), vertices shaded per unique vertex. 1 is the best possible
+    */
+    class VKMeshOptimizer {
+        private:
+            /* Size of the LRU cache modelled while reordering, the scores favour vertices near its front so the order
+             * is good for any real cache size up to this
+            */
+            static constexpr uint32_t CACHE_SIZE          = 32;
+            static constexpr uint32_t MAX_VALENCE         = 32;
+            static constexpr float    CACHE_DECAY_POWER   = 1.5f;
+            static constexpr float    LAST_TRIANGLE_SCORE = 0.75f;
+            static constexpr float    VALENCE_BOOST_SCALE = 2.0f;
+            static constexpr float    VALENCE_BOOST_POWER = 0.5f;
+
+            struct ScoreTables {
+                float cache[CACHE_SIZE];
+                float valence[MAX_VALENCE + 1];
+
+                ScoreTables (void) {
+                    /* The vertices of the last triangle get a fixed score, they are in the cache no matter in which
+                     * order that triangle's vertices were used
+                    */
+                    for (uint32_t i = 0; i < CACHE_SIZE; i++)
+                        cache[i] = i < 3 ? LAST_TRIANGLE_SCORE:
+                                           std::pow (1.0f - static_cast <float> (i - 3) / (CACHE_SIZE - 3),
+                                                     CACHE_DECAY_POWER);
+                    /* Vertices with only a few triangles left are boosted, to get rid of them before they leave the
+                     * cache and need to be shaded again
+                    */
+                    valence[0] = 0.0f;
+                    for (uint32_t i = 1; i <= MAX_VALENCE; i++)
+                        valence[i] = VALENCE_BOOST_SCALE * std::pow (static_cast <float> (i), -VALENCE_BOOST_POWER);
+                }
+            };
+
+            static float getVertexScore (const ScoreTables& tables, int32_t cachePosition, uint32_t liveTrianglesCount) {
+                if (liveTrianglesCount == 0)
+                    return -1.0f;
+
+                float score = cachePosition < 0 ? 0.0f: tables.cache[cachePosition];
+                return score + tables.valence[std::min (liveTrianglesCount, MAX_VALENCE)];
+            }
+
+        public:
+            struct CacheStats {
+                float acmr;
+                float atvr;
+            };
+
+            /* Simulates a FIFO post transform cache of the given size, which is what most hardware is modelled as
+            */
+            static CacheStats getCacheStats (std::span <const uint32_t> indices,
+                                             size_t verticesCount,
+                                             uint32_t cacheSize = 16) {
+                std::vector <uint64_t> insertedAt (verticesCount, 0);
+                uint64_t missesCount = 0;
+                size_t usedCount     = 0;
+                /* A vertex is in the cache if fewer than cacheSize misses have happened since it was inserted, the
+                 * timestamps start at cacheSize + 1 so that a zero always reads as not cached
+                */
+                uint64_t timestamp   = cacheSize + 1;
+                for (auto const& index: indices) {
+                    if (insertedAt[index] == 0)
+                        usedCount++;
+                    if (timestamp - insertedAt[index] > cacheSize) {
+                        insertedAt[index] = timestamp++;
+                        missesCount++;
+                    }
+                }
+
+                CacheStats stats;
+                size_t trianglesCount = indices.size() / 3;
+                stats.acmr = trianglesCount == 0 ? 0.0f: static_cast <float> (missesCount) / trianglesCount;
+                stats.atvr = usedCount      == 0 ? 0.0f: static_cast <float> (missesCount) / usedCount;
+                return stats;
+            }
+
+            static void optimizeVertexCache (std::vector <uint32_t>& indices, size_t verticesCount) {
+                static const ScoreTables tables;
+                size_t trianglesCount = indices.size() / 3;
+                if (trianglesCount == 0)
+                    return;
+                /* Triangles of every vertex, the first liveTrianglesCounts[v] entries of a vertex's range are the ones
+                 * not emitted yet
+                */
+                std::vector <uint32_t> liveTrianglesCounts (verticesCount, 0);
+                for (auto const& index: indices)
+                    liveTrianglesCounts[index]++;
+
+                std::vector <uint32_t> adjacencyOffsets (verticesCount + 1, 0);
+                for (size_t v = 0; v < verticesCount; v++)
+                    adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTrianglesCounts[v];
+
+                std::vector <uint32_t> adjacency (indices.size());
+                std::vector <uint32_t> fillCounts (verticesCount, 0);
+                for (size_t t = 0; t < trianglesCount; t++) {
+                    for (size_t i = 0; i < 3; i++) {
+                        uint32_t v = indices[t * 3 + i];
+                        adjacency[adjacencyOffsets[v] + fillCounts[v]++] = static_cast <uint32_t> (t);
+                    }
+                }
+
+                std::vector <float> vertexScores (verticesCount);
+                for (size_t v = 0; v < verticesCount; v++)
+                    vertexScores[v] = getVertexScore (tables, -1, liveTrianglesCounts[v]);
+
+                auto getTriangleScore = [&](size_t t) {
+                    return vertexScores[indices[t * 3 + 0]] +
+                           vertexScores[indices[t * 3 + 1]] +
+                           vertexScores[indices[t * 3 + 2]];
+                };
+                std::vector <bool> isEmitted (trianglesCount, false);
+                int64_t bestTriangle = -1;
+                float bestScore      = -1.0f;
+                for (size_t t = 0; t < trianglesCount; t++) {
+                    float score = getTriangleScore (t);
+                    if (score > bestScore) {
+                        bestScore    = score;
+                        bestTriangle = static_cast <int64_t> (t);
+                    }
+                }
+                /* The cache holds up to 3 more entries while it is being updated
+                */
+                std::vector <uint32_t> cache;
+                std::vector <uint32_t> newCache;
+                cache.reserve    (CACHE_SIZE + 3);
+                newCache.reserve (CACHE_SIZE + 3);
+
+                std::vector <uint32_t> reordered;
+                reordered.reserve (indices.size());
+                size_t nextTriangle = 0;
+
+                while (reordered.size() < indices.size()) {
+                    /* None of the triangles around the cached vertices are left, carry on with the first triangle that
+                     * has not been emitted
+                    */
+                    if (bestTriangle < 0) {
+                        while (isEmitted[nextTriangle])
+                            nextTriangle++;
+                        bestTriangle = static_cast <int64_t> (nextTriangle);
+                    }
+
+                    size_t t = static_cast <size_t> (bestTriangle);
+                    isEmitted[t] = true;
+                    newCache.clear();
+                    for (size_t i = 0; i < 3; i++) {
+                        uint32_t v = indices[t * 3 + i];
+                        reordered.push_back (v);
+                        newCache.push_back  (v);
+                        /* Remove the triangle from the vertex's live triangles
+                        */
+                        uint32_t* begin = &adjacency[adjacencyOffsets[v]];
+                        uint32_t* end   = begin + liveTrianglesCounts[v];
+                        std::iter_swap (std::find (begin, end, static_cast <uint32_t> (t)), end - 1);
+                        liveTrianglesCounts[v]--;
+                    }
+                    for (auto const& v: cache) {
+                        if (v != newCache[0] && v != newCache[1] && v != newCache[2])
+                            newCache.push_back (v);
+                    }
+                    /* Vertices pushed out of the cache lose their cache score
+                    */
+                    for (size_t i = CACHE_SIZE; i < newCache.size(); i++) {
+                        uint32_t v      = newCache[i];
+                        vertexScores[v] = getVertexScore (tables, -1, liveTrianglesCounts[v]);
+                    }
+                    if (newCache.size() > CACHE_SIZE)
+                        newCache.resize (CACHE_SIZE);
+
+                    for (size_t i = 0; i < newCache.size(); i++) {
+                        uint32_t v      = newCache[i];
+                        vertexScores[v] = getVertexScore (tables, static_cast <int32_t> (i), liveTrianglesCounts[v]);
+                    }
+                    /* Only the triangles around the cached vertices changed score, the next triangle is the best of them
+                    */
+                    bestTriangle = -1;
+                    bestScore    = -1.0f;
+                    for (auto const& v: newCache) {
+                        for (uint32_t i = 0; i < liveTrianglesCounts[v]; i++) {
+                            uint32_t adjacent = adjacency[adjacencyOffsets[v] + i];
+                            float score       = getTriangleScore (adjacent);
+                            if (score > bestScore) {
+                                bestScore    = score;
+                                bestTriangle = adjacent;
+                            }
+                        }
+                    }
+                    std::swap (cache, newCache);
+                }
+                indices = std::move (reordered);
+            }
+
+            /* Renumber the vertices in the order the index data first uses them, vertices that are not used are dropped
+            */
+            static void optimizeVertexFetch (std::vector <Vertex>& vertices, std::vector <uint32_t>& indices) {
+                std::vector <uint32_t> remap (vertices.size(), UINT32_MAX);
+                std::vector <Vertex> reordered;
+                reordered.reserve (vertices.size());
+
+                for (auto& index: indices) {
+                    if (remap[index] == UINT32_MAX) {
+                        remap[index] = static_cast <uint32_t> (reordered.size());
+                        reordered.push_back (vertices[index]);
+                    }
+                    index = remap[index];
+                }
+                vertices = std::move (reordered);
+            }
+    };
+}   // namespace Core
+#endif  // VK_MESH_OPTIMIZER_
\ No newline at end of file
@@ -0,0 +1,405 @@
+#ifndef VK_MESH_SIMPLIFIER_H
+#define VK_MESH_SIMPLIFIER_H
+
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <unordered_map>
+#include <iterator>
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <cstdint>
+#include "VKVertexData.h"
+
+namespace Core {
+    /* Index only mesh simplification by edge collapse with quadric error metrics (Garland and Heckbert, "Surface
+     * Simplification Using Quadric Error Metrics"). The simplified index data references the same vertices as the input,
+     * so all the levels of detail of a model share its vertex buffer
+     *
+     * Every collapse moves all the vertices at one position (U) onto the position of a neighbouring one (V), its cost is
+     * the sum of squared distances of V to the planes of the triangles around U and V. Collapses are done cheapest first
+     * and are rejected if,
+     * (1) U is on a non manifold edge or where several open borders meet, such positions are locked
+     * (2) U is on an open border and the edge is not, so that the outline of the model does not shrink inwards
+     * (3) A vertex of U can not be matched with exactly one vertex of V that it shares a triangle with, which would move
+     *     an attribute seam (texture coordinates, normals) or tear the mesh apart along it
+     * (4) A remaining triangle around U flips
+     *
+     * Positions are scaled to the unit cube of the model's bounding box first, so errors are relative to the model size
+    */
+    class VKMeshSimplifier {
+        private:
+            /* Weight of the planes along open border edges, relative to the planes of the triangles
+            */
+            static constexpr float BORDER_WEIGHT = 10.0f;
+
+            enum PositionKind {
+                MANIFOLD,
+                BORDER,
+                LOCKED
+            };
+
+            /* Upper triangle of the symmetric 4x4 matrix of the plane equations (a, b, c, d) summed over the planes
+            */
+            struct Quadric {
+                double a00, a01, a02, a03, a11, a12, a13, a22, a23, a33;
+            };
+
+            struct Collapse {
+                uint32_t positionA;
+                uint32_t positionB;
+                bool     isBorderEdge;
+                float    costAB;
+                float    costBA;
+
+                float getMinCost (void) const {
+                    return std::min (costAB, costBA);
+                }
+            };
+
+            static void addPlane (Quadric& quadric, const glm::vec3& normal, float distance, float weight) {
+                double a = normal.x, b = normal.y, c = normal.z, d = distance, w = weight;
+                quadric.a00 += w * a * a; quadric.a01 += w * a * b; quadric.a02 += w * a * c; quadric.a03 += w * a * d;
+                quadric.a11 += w * b * b; quadric.a12 += w * b * c; quadric.a13 += w * b * d;
+                quadric.a22 += w * c * c; quadric.a23 += w * c * d;
+                quadric.a33 += w * d * d;
+            }
+
+            static void addQuadric (Quadric& quadric, const Quadric& other) {
+                quadric.a00 += other.a00; quadric.a01 += other.a01; quadric.a02 += other.a02; quadric.a03 += other.a03;
+                quadric.a11 += other.a11; quadric.a12 += other.a12; quadric.a13 += other.a13;
+                quadric.a22 += other.a22; quadric.a23 += other.a23;
+                quadric.a33 += other.a33;
+            }
+
+            static float getError (const Quadric& quadric, const glm::vec3& point) {
+                double x = point.x, y = point.y, z = point.z;
+                double error = quadric.a00 * x * x + 2.0 * quadric.a01 * x * y + 2.0 * quadric.a02 * x * z +
+                               2.0 * quadric.a03 * x + quadric.a11 * y * y + 2.0 * quadric.a12 * y * z +
+                               2.0 * quadric.a13 * y + quadric.a22 * z * z + 2.0 * quadric.a23 * z + quadric.a33;
+                return static_cast <float> (std::max (error, 0.0));
+            }
+
+            static uint64_t getEdgeKey (uint32_t positionA, uint32_t positionB) {
+                return positionA < positionB ? (static_cast <uint64_t> (positionA) << 32) | positionB:
+                                               (static_cast <uint64_t> (positionB) << 32) | positionA;
+            }
+
+            /* Sorted keys of the edges of every triangle, an edge shows up once for every triangle it is on. That
+             * makes it cheap to find open borders (edges on 1 triangle) and non manifold edges (on more than 2)
+            */
+            static void getEdgeKeys (std::span <const uint32_t> indices,
+                                     const std::vector <uint32_t>& positionIds,
+                                     std::vector <uint64_t>& edgeKeys) {
+                edgeKeys.resize (indices.size());
+                for (size_t i = 0; i < indices.size(); i += 3) {
+                    for (size_t e = 0; e < 3; e++)
+                        edgeKeys[i + e] = getEdgeKey (positionIds[indices[i + e]],
+                                                      positionIds[indices[i + (e + 1) % 3]]);
+                }
+                std::sort (edgeKeys.begin(), edgeKeys.end());
+            }
+
+            static uint32_t getEdgeTrianglesCount (const std::vector <uint64_t>& edgeKeys, uint64_t edgeKey) {
+                auto range = std::equal_range (edgeKeys.begin(), edgeKeys.end(), edgeKey);
+                return static_cast <uint32_t> (std::distance (range.first, range.second));
+            }
+
+        public:
+            /* Simplify the triangles in indices down to about targetIndicesCount indices, without any collapse with an
+             * error over maxError (a distance relative to the size of the model). The error of the costliest collapse
+             * done is returned through resultError
+            */
+            static std::vector <uint32_t> simplify (std::span <const Vertex> vertices,
+                                                    std::span <const uint32_t> indices,
+                                                    size_t targetIndicesCount,
+                                                    float maxError,
+                                                    float* resultError = nullptr) {
+
+                std::vector <uint32_t> result (indices.begin(), indices.end());
+                if (resultError != nullptr)
+                    *resultError = 0.0f;
+                if (vertices.empty() || result.size() <= targetIndicesCount)
+                    return result;
+                /* Vertices at the same position (split by their other attributes) are one position, the positions are
+                 * what gets collapsed
+                */
+                std::vector <uint32_t> positionIds (vertices.size());
+                std::vector <glm::vec3> positions;
+                {
+                    std::unordered_map <glm::vec3, uint32_t> uniquePositions;
+                    uniquePositions.reserve (vertices.size());
+                    for (size_t v = 0; v < vertices.size(); v++) {
+                        auto it = uniquePositions.try_emplace (vertices[v].pos,
+                                                               static_cast <uint32_t> (positions.size()));
+                        if (it.second)
+                            positions.push_back (vertices[v].pos);
+                        positionIds[v] = it.first->second;
+                    }
+                }
+                glm::vec3 boundsMin = positions[0], boundsMax = positions[0];
+                for (auto const& position: positions) {
+                    boundsMin = glm::min (boundsMin, position);
+                    boundsMax = glm::max (boundsMax, position);
+                }
+                glm::vec3 extent = boundsMax - boundsMin;
+                float maxExtent  = std::max (extent.x, std::max (extent.y, extent.z));
+                float invScale   = maxExtent > 0.0f ? 1.0f / maxExtent: 1.0f;
+                for (auto& position: positions)
+                    position = (position - boundsMin) * invScale;
+
+                size_t positionsCount = positions.size();
+                /* Vertices of every position as a linked list
+                */
+                std::vector <uint32_t> firstVertex (positionsCount, UINT32_MAX);
+                std::vector <uint32_t> nextVertex  (vertices.size(), UINT32_MAX);
+                for (size_t v = vertices.size(); v-- > 0;) {
+                    nextVertex[v]               = firstVertex[positionIds[v]];
+                    firstVertex[positionIds[v]] = static_cast <uint32_t> (v);
+                }
+                std::vector <uint64_t> edgeKeys;
+                getEdgeKeys (result, positionIds, edgeKeys);
+
+                std::vector <Quadric> quadrics (positionsCount, Quadric {});
+                std::vector <uint32_t> borderEdgesCounts (positionsCount, 0);
+                std::vector <uint8_t> kinds (positionsCount, MANIFOLD);
+                for (size_t i = 0; i < result.size(); i += 3) {
+                    uint32_t p[3]     = {positionIds[result[i + 0]],
+                                         positionIds[result[i + 1]],
+                                         positionIds[result[i + 2]]};
+                    glm::vec3 normal  = glm::cross (positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+                    float doubleArea  = glm::length (normal);
+                    if (doubleArea == 0.0f)
+                        continue;
+
+                    normal /= doubleArea;
+                    float distance = -glm::dot (normal, positions[p[0]]);
+                    for (size_t e = 0; e < 3; e++)
+                        addPlane (quadrics[p[e]], normal, distance, doubleArea * 0.5f);
+                    /* An open border edge gets a plane through it perpendicular to the triangle, which keeps collapses
+                     * along the border from pulling it off its line
+                    */
+                    for (size_t e = 0; e < 3; e++) {
+                        uint32_t a = p[e], b = p[(e + 1) % 3];
+                        uint32_t count = getEdgeTrianglesCount (edgeKeys, getEdgeKey (a, b));
+                        if (count > 2) {
+                            kinds[a] = LOCKED;
+                            kinds[b] = LOCKED;
+                        }
+                        if (count != 1)
+                            continue;
+
+                        glm::vec3 edge       = positions[b] - positions[a];
+                        float length         = glm::length (edge);
+                        if (length == 0.0f)
+                            continue;
+
+                        glm::vec3 edgeNormal = glm::normalize (glm::cross (edge, normal));
+                        float edgeDistance   = -glm::dot (edgeNormal, positions[a]);
+                        addPlane (quadrics[a], edgeNormal, edgeDistance, BORDER_WEIGHT * length * length);
+                        addPlane (quadrics[b], edgeNormal, edgeDistance, BORDER_WEIGHT * length * length);
+                        borderEdgesCounts[a]++;
+                        borderEdgesCounts[b]++;
+                    }
+                }
+                /* A position on exactly one border loop has two border edges, any other count means several loops (or
+                 * a non manifold border) meet there
+                */
+                for (size_t p = 0; p < positionsCount; p++) {
+                    if (kinds[p] == LOCKED || borderEdgesCounts[p] == 0)
+                        continue;
+                    kinds[p] = borderEdgesCounts[p] == 2 ? BORDER: LOCKED;
+                }
+
+                float maxErrorSquared = maxError * maxError;
+                float appliedError    = 0.0f;
+                std::vector <uint32_t> remap (vertices.size());
+                std::vector <uint8_t>  isTouched (positionsCount);
+                std::vector <uint32_t> adjacencyOffsets (positionsCount + 1);
+                std::vector <uint32_t> adjacency;
+                std::vector <Collapse> collapses;
+                std::vector <uint64_t> collapseOrder;
+                std::vector <std::pair <uint32_t, uint32_t>> wedgeMatches;
+
+                while (result.size() > targetIndicesCount) {
+                    size_t trianglesCount = result.size() / 3;
+                    /* Triangles around every position
+                    */
+                    std::fill (adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+                    for (auto const& index: result)
+                        adjacencyOffsets[positionIds[index] + 1]++;
+                    for (size_t p = 0; p < positionsCount; p++)
+                        adjacencyOffsets[p + 1] += adjacencyOffsets[p];
+
+                    adjacency.resize (result.size());
+                    std::vector <uint32_t> fillOffsets (adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+                    for (size_t t = 0; t < trianglesCount; t++)
+                        for (size_t i = 0; i < 3; i++)
+                            adjacency[fillOffsets[positionIds[result[t * 3 + i]]]++] = static_cast <uint32_t> (t);
+                    /* Every edge once, with the cost of collapsing it either way
+                    */
+                    getEdgeKeys (result, positionIds, edgeKeys);
+                    collapses.clear();
+                    for (size_t i = 0; i < edgeKeys.size();) {
+                        size_t runEnd = i + 1;
+                        while (runEnd < edgeKeys.size() && edgeKeys[runEnd] == edgeKeys[i])
+                            runEnd++;
+
+                        collapses.push_back ({static_cast <uint32_t> (edgeKeys[i] >> 32),
+                                              static_cast <uint32_t> (edgeKeys[i]),
+                                              runEnd - i == 1,
+                                              0.0f, 0.0f});
+                        i = runEnd;
+                    }
+
+                    auto isKindAllowed = [&](uint32_t from, bool isBorderEdge) {
+                        return kinds[from] == MANIFOLD || (kinds[from] == BORDER && isBorderEdge);
+                    };
+                    for (auto& collapse: collapses) {
+                        uint32_t a            = collapse.positionA;
+                        uint32_t b            = collapse.positionB;
+                        Quadric quadric       = quadrics[a];
+                        addQuadric (quadric, quadrics[b]);
+                        collapse.costAB = isKindAllowed (a, collapse.isBorderEdge) ? getError (quadric, positions[b]):
+                                                                                      FLT_MAX;
+                        collapse.costBA = isKindAllowed (b, collapse.isBorderEdge) ? getError (quadric, positions[a]):
+                                                                                      FLT_MAX;
+                    }
+
+                    /* Sorted by the cost in the upper bits and the collapse in the lower bits, the bits of a non negative
+                     * float compare in the same order as the float
+                    */
+                    collapseOrder.resize (collapses.size());
+                    for (size_t i = 0; i < collapses.size(); i++) {
+                        float minCost = collapses[i].getMinCost();
+                        uint32_t costBits;
+                        std::memcpy (&costBits, &minCost, sizeof (float));
+                        collapseOrder[i] = (static_cast <uint64_t> (costBits) << 32) | i;
+                    }
+                    std::sort (collapseOrder.begin(), collapseOrder.end());
+                    /* Matches every vertex at position 'from' with the vertex at position 'to' it shares triangles with,
+                     * and checks that no remaining triangle around 'from' flips
+                    */
+                    auto isCollapseValid = [&](uint32_t from, uint32_t to) {
+                        wedgeMatches.clear();
+                        for (uint32_t i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1]; i++) {
+                            const uint32_t* triangle = &result[adjacency[i] * 3];
+                            uint32_t fromVertex = UINT32_MAX, toVertex = UINT32_MAX;
+                            glm::vec3 corners[3];
+                            for (size_t c = 0; c < 3; c++) {
+                                uint32_t position = positionIds[triangle[c]];
+                                if (position == from) fromVertex = triangle[c];
+                                if (position == to)   toVertex   = triangle[c];
+                                corners[c] = positions[position];
+                            }
+
+                            if (toVertex != UINT32_MAX) {
+                                wedgeMatches.push_back ({fromVertex, toVertex});
+                                continue;
+                            }
+                            glm::vec3 normalBefore = glm::cross (corners[1] - corners[0], corners[2] - corners[0]);
+                            for (size_t c = 0; c < 3; c++)
+                                if (positionIds[triangle[c]] == from)
+                                    corners[c] = positions[to];
+                            glm::vec3 normalAfter  = glm::cross (corners[1] - corners[0], corners[2] - corners[0]);
+                            if (glm::dot (normalBefore, normalAfter) <= 0.0f)
+                                return false;
+                        }
+
+                        for (uint32_t v = firstVertex[from]; v != UINT32_MAX; v = nextVertex[v]) {
+                            uint32_t match = UINT32_MAX;
+                            bool isUsed    = false;
+                            for (uint32_t i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1] && !isUsed; i++) {
+                                const uint32_t* triangle = &result[adjacency[i] * 3];
+                                isUsed = triangle[0] == v || triangle[1] == v || triangle[2] == v;
+                            }
+                            if (!isUsed)
+                                continue;
+
+                            for (auto const& [fromVertex, toVertex]: wedgeMatches) {
+                                if (fromVertex != v)
+                                    continue;
+                                if (match != UINT32_MAX && match != toVertex)
+                                    return false;
+                                match = toVertex;
+                            }
+                            if (match == UINT32_MAX)
+                                return false;
+                        }
+                        return true;
+                    };
+
+                    for (size_t v = 0; v < vertices.size(); v++)
+                        remap[v] = static_cast <uint32_t> (v);
+                    std::fill (isTouched.begin(), isTouched.end(), 0);
+
+                    size_t targetTrianglesCount  = targetIndicesCount / 3;
+                    size_t removedTrianglesCount = 0;
+                    size_t appliedCount          = 0;
+                    for (auto const& orderKey: collapseOrder) {
+                        auto const& collapse = collapses[static_cast <uint32_t> (orderKey)];
+                        if (collapse.getMinCost() > maxErrorSquared)
+                            break;
+                        if (trianglesCount - removedTrianglesCount <= targetTrianglesCount)
+                            break;
+                        if (isTouched[collapse.positionA] || isTouched[collapse.positionB])
+                            continue;
+
+                        uint32_t from = collapse.positionA, to = collapse.positionB;
+                        float cost    = collapse.costAB;
+                        bool isValid  = cost <= maxErrorSquared && isCollapseValid (from, to);
+                        if (!isValid) {
+                            std::swap (from, to);
+                            cost    = collapse.costBA;
+                            isValid = cost <= maxErrorSquared && isCollapseValid (from, to);
+                        }
+                        if (!isValid)
+                            continue;
+
+                        for (auto const& [fromVertex, toVertex]: wedgeMatches)
+                            remap[fromVertex] = toVertex;
+                        addQuadric (quadrics[to], quadrics[from]);
+                        /* Keep the triangles around 'from' as they are for the rest of the pass, so that the checks of
+                         * later collapses see the current mesh
+                        */
+                        for (uint32_t i = adjacencyOffsets[from]; i < adjacencyOffsets[from + 1]; i++) {
+                            const uint32_t* triangle = &result[adjacency[i] * 3];
+                            for (size_t c = 0; c < 3; c++)
+                                isTouched[positionIds[triangle[c]]] = 1;
+                        }
+                        isTouched[from] = 1;
+                        isTouched[to]   = 1;
+
+                        removedTrianglesCount += collapse.isBorderEdge ? 1: 2;
+                        appliedError           = std::max (appliedError, cost);
+                        appliedCount++;
+                    }
+                    if (appliedCount == 0)
+                        break;
+                    /* Triangles that were on a collapsed edge are left with two corners at the same position
+                    */
+                    size_t writeIdx = 0;
+                    for (size_t i = 0; i < result.size(); i += 3) {
+                        uint32_t a = remap[result[i + 0]];
+                        uint32_t b = remap[result[i + 1]];
+                        uint32_t c = remap[result[i + 2]];
+                        if (positionIds[a] == positionIds[b] ||
+                            positionIds[b] == positionIds[c] ||
+                            positionIds[c] == positionIds[a])
+                            continue;
+
+                        result[writeIdx++] = a;
+                        result[writeIdx++] = b;
+                        result[writeIdx++] = c;
+                    }
+                    result.resize (writeIdx);
+                }
+
+                if (resultError != nullptr)
+                    *resultError = std::sqrt (appliedError);
+                return result;
+            }
+    };
+}   // namespace Core
+#endif  // VK_MESH_SIMPLIFIER_H
\ No newline at end of file
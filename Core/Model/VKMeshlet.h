@@ -0,0 +1,178 @@
+#ifndef VK_MESHLET_H
+#define VK_MESHLET_H
+
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "VKVertexData.h"
+
+namespace Core {
+    /* Cluster of consecutive triangles of a model, its range of indices is drawn on its own when it passes culling
+     * (1) Bounding sphere, for culling against the view frustum
+     * (2) Normal cone, the axis and the sine of the widest angle of a triangle normal to it. Every triangle of the cluster
+     *     faces away from a camera that sees the whole sphere from within the mirrored cone, which is when
+     *     dot (center - camera, axis) >= coneCutoff * length (center - camera) + radius
+     *     A cluster whose normals spread over more than a half sphere gets a cutoff of 1, which never passes the test
+    */
+    struct Meshlet {
+        uint32_t firstIndex;
+        uint32_t indicesCount;
+        glm::vec3 center;
+        float radius;
+        glm::vec3 coneAxis;
+        float coneCutoff;
+    };
+
+    class VKMeshlet {
+        public:
+            /* Planes (normal, distance) of the view frustum, pointing inwards
+            */
+            struct Frustum {
+                glm::vec4 planes[6];
+            };
+
+            /* Triangles are added to a cluster in index order until it would go over either limit, so the clusters are
+             * only as compact as the index data is local (see VKMeshOptimizer). Keeping the order leaves the index data
+             * as it is, every cluster is a range of it
+            */
+            static std::vector <Meshlet> buildMeshlets (std::span <const Vertex> vertices,
+                                                        std::span <const uint32_t> indices,
+                                                        uint32_t maxVerticesCount,
+                                                        uint32_t maxTrianglesCount,
+                                                        bool isFrontFaceCCW) {
+                std::vector <Meshlet> meshlets;
+                /* Id of the last cluster a vertex was added to, to count the unique vertices of a cluster
+                */
+                std::vector <uint32_t> meshletIds (vertices.size(), UINT32_MAX);
+                uint32_t verticesCount  = 0;
+                uint32_t trianglesCount = 0;
+                uint32_t firstIndex     = 0;
+
+                for (uint32_t i = 0; i < indices.size(); i += 3) {
+                    uint32_t meshletId     = static_cast <uint32_t> (meshlets.size());
+                    uint32_t newVertices   = 0;
+                    for (uint32_t c = 0; c < 3; c++)
+                        newVertices += meshletIds[indices[i + c]] != meshletId ? 1: 0;
+
+                    if (trianglesCount != 0 && (verticesCount + newVertices > maxVerticesCount ||
+                                                trianglesCount + 1            > maxTrianglesCount)) {
+                        meshlets.push_back (getMeshlet (vertices, indices, firstIndex, i - firstIndex, isFrontFaceCCW));
+                        meshletId      = static_cast <uint32_t> (meshlets.size());
+                        verticesCount  = 0;
+                        trianglesCount = 0;
+                        firstIndex     = i;
+                    }
+                    for (uint32_t c = 0; c < 3; c++) {
+                        if (meshletIds[indices[i + c]] != meshletId) {
+                            meshletIds[indices[i + c]] = meshletId;
+                            verticesCount++;
+                        }
+                    }
+                    trianglesCount++;
+                }
+                if (trianglesCount != 0)
+                    meshlets.push_back (getMeshlet (vertices,
+                                                    indices,
+                                                    firstIndex,
+                                                    static_cast <uint32_t> (indices.size()) - firstIndex,
+                                                    isFrontFaceCCW));
+                return meshlets;
+            }
+
+            static Meshlet getMeshlet (std::span <const Vertex> vertices,
+                                       std::span <const uint32_t> indices,
+                                       uint32_t firstIndex,
+                                       uint32_t indicesCount,
+                                       bool isFrontFaceCCW) {
+                Meshlet meshlet;
+                meshlet.firstIndex   = firstIndex;
+                meshlet.indicesCount = indicesCount;
+
+                auto range           = indices.subspan (firstIndex, indicesCount);
+                glm::vec3 boundsMin  = vertices[range[0]].pos;
+                glm::vec3 boundsMax  = vertices[range[0]].pos;
+                for (auto const& index: range) {
+                    boundsMin = glm::min (boundsMin, vertices[index].pos);
+                    boundsMax = glm::max (boundsMax, vertices[index].pos);
+                }
+                meshlet.center = (boundsMin + boundsMax) * 0.5f;
+                meshlet.radius = 0.0f;
+                for (auto const& index: range)
+                    meshlet.radius = std::max (meshlet.radius, glm::distance (vertices[index].pos, meshlet.center));
+                /* The axis is the average of the triangle normals, degenerate triangles face nowhere and are left out
+                */
+                std::vector <glm::vec3> normals;
+                normals.reserve (indicesCount / 3);
+                glm::vec3 axis = glm::vec3 (0.0f);
+                for (uint32_t i = 0; i < indicesCount; i += 3) {
+                    glm::vec3 a      = vertices[range[i + 0]].pos;
+                    glm::vec3 b      = vertices[range[i + 1]].pos;
+                    glm::vec3 c      = vertices[range[i + 2]].pos;
+                    glm::vec3 normal = glm::cross (b - a, c - a);
+                    float length     = glm::length (normal);
+                    if (length == 0.0f)
+                        continue;
+
+                    normal = normal / length * (isFrontFaceCCW ? 1.0f: -1.0f);
+                    normals.push_back (normal);
+                    axis  += normal;
+                }
+
+                float axisLength   = glm::length (axis);
+                meshlet.coneAxis   = axisLength == 0.0f ? glm::vec3 (0.0f, 0.0f, 1.0f): axis / axisLength;
+                meshlet.coneCutoff = 1.0f;
+                if (axisLength == 0.0f || normals.empty())
+                    return meshlet;
+
+                float minDot = 1.0f;
+                for (auto const& normal: normals)
+                    minDot = std::min (minDot, glm::dot (normal, meshlet.coneAxis));
+                if (minDot > 0.0f)
+                    meshlet.coneCutoff = std::sqrt (1.0f - minDot * minDot);
+                return meshlet;
+            }
+
+            /* Planes of the view frustum from the combined projection and view matrix (Gribb and Hartmann, "Fast
+             * Extraction of Viewing Frustum Planes from the World-View-Projection Matrix"). The near plane is z >= 0
+             * since the projection uses the Vulkan depth range of 0.0 to 1.0
+            */
+            static Frustum getFrustum (const glm::mat4& viewProjection) {
+                auto getRow = [&](int r) {
+                    return glm::vec4 (viewProjection[0][r], viewProjection[1][r], viewProjection[2][r],
+                                      viewProjection[3][r]);
+                };
+                glm::vec4 rows[4] = {getRow (0), getRow (1), getRow (2), getRow (3)};
+                Frustum frustum;
+                frustum.planes[0] = rows[3] + rows[0];
+                frustum.planes[1] = rows[3] - rows[0];
+                frustum.planes[2] = rows[3] + rows[1];
+                frustum.planes[3] = rows[3] - rows[1];
+                frustum.planes[4] = rows[2];
+                frustum.planes[5] = rows[3] - rows[2];
+                for (auto& plane: frustum.planes) {
+                    float length = glm::length (glm::vec3 (plane));
+                    if (length != 0.0f)
+                        plane = plane * (1.0f / length);
+                }
+                return frustum;
+            }
+
+            static bool isSphereVisible (const Frustum& frustum, const glm::vec3& center, float radius) {
+                for (auto const& plane: frustum.planes) {
+                    if (glm::dot (glm::vec3 (plane), center) + plane.w < -radius)
+                        return false;
+                }
+                return true;
+            }
+
+            /* The camera position is in the model space of the cluster
+            */
+            static bool isBackFacing (const Meshlet& meshlet, const glm::vec3& cameraPosition) {
+                glm::vec3 view = meshlet.center - cameraPosition;
+                return glm::dot (view, meshlet.coneAxis) >= meshlet.coneCutoff * glm::length (view) + meshlet.radius;
+            }
+    };
+}   // namespace Core
+#endif  // VK_MESHLET_H
\ No newline at end of file
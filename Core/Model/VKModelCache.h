@@ -0,0 +1,331 @@
+#ifndef VK_MODEL_CACHE_H
+#define VK_MODEL_CACHE_H
+
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <span>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "VKVertexData.h"
+
+namespace Core {
+    /* Layout of a model cache file, which holds the deduplicated vertex and index data of a model so that the next
+     * import can skip parsing the model file
+     *
+     * File header (FILE_HEADER_SIZE bytes)
+     *      char magic[8]               "ENMCACHE"
+     *      uint32_t version            bumped whenever the vertex/index data built from a model file changes
+     *      uint32_t vertexSize         sizeof (Vertex)
+     *      uint64_t sourceHash         hash of the model file and its .mtl files (and of how they were built)
+     *      uint64_t textureMappingHash hash of the texture image info ids the vertices were built with
+     *      uint32_t verticesCount
+     *      uint32_t indicesCount
+     *      uint32_t texturePathsCount  diffuse texture paths read from the .mtl files
+     *      uint32_t texturePathsSize
+     *      uint64_t texturePathsOffset null terminated paths, one after the other
+     *      uint64_t verticesOffset     aligned to VERTICES_ALIGNMENT
+     *      uint64_t indicesOffset      indices of the model followed by the indices of its levels of detail
+     *      uint64_t fileSize
+     *      uint32_t lodsCount          levels of detail other than the model itself
+     *      uint32_t lodIndicesCount
+     *      uint64_t lodsOffset         indices count of every level of detail (uint32_t), after the texture paths
+    */
+    namespace ModelCacheFormat {
+        const char     MAGIC[8]           = {'E', 'N', 'M', 'C', 'A', 'C', 'H', 'E'};
+        const uint32_t VERSION            = 2;
+        const size_t   FILE_HEADER_SIZE   = 128;
+        const size_t   VERTICES_ALIGNMENT = 16;
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t vertexSize;
+            uint64_t sourceHash;
+            uint64_t textureMappingHash;
+            uint32_t verticesCount;
+            uint32_t indicesCount;
+            uint32_t texturePathsCount;
+            uint32_t texturePathsSize;
+            uint64_t texturePathsOffset;
+            uint64_t verticesOffset;
+            uint64_t indicesOffset;
+            uint64_t fileSize;
+            uint32_t lodsCount;
+            uint32_t lodIndicesCount;
+            uint64_t lodsOffset;
+        };
+        static_assert (sizeof (FileHeader) <= FILE_HEADER_SIZE);
+    }   // namespace ModelCacheFormat
+
+    class VKModelCache: protected VKVertexData {
+        private:
+            Log::Record* m_VKModelCacheLog;
+            const uint32_t m_instanceId = g_collectionSettings.instanceId++;
+
+            /* 64 bit FNV-1a, which is enough to tell whether a source file has changed (this is not protecting against
+             * anything other than stale data)
+            */
+            static uint64_t getHash (const void* data, size_t size, uint64_t hash = 14695981039346656037ULL) {
+                auto bytes = static_cast <const uint8_t*> (data);
+                for (size_t i = 0; i < size; i++) {
+                    hash ^= bytes[i];
+                    hash *= 1099511628211ULL;
+                }
+                return hash;
+            }
+
+            static bool readFile (const std::string& filePath, std::string& contents) {
+                std::ifstream file (filePath, std::ios_base::in | std::ios_base::binary);
+                if (!file.is_open())
+                    return false;
+
+                std::stringstream stream;
+                stream << file.rdbuf();
+                contents = stream.str();
+                return true;
+            }
+
+            /* One cache file per model file, named after the model file along with a hash of its path so that models
+             * with the same name in different directories do not share a cache file
+            */
+            std::string getCacheFilePath (const char* modelPath) {
+                std::string path (modelPath);
+                std::string name = path.substr (path.find_last_of ('/') + 1);
+                name             = name.substr (0, name.find_last_of ('.'));
+
+                std::stringstream stream;
+                stream << g_coreSettings.modelCacheDirPath
+                       << name
+                       << "_"
+                       << std::hex << getHash (path.data(), path.size())
+                       << ".cache";
+                return stream.str();
+            }
+
+        public:
+            VKModelCache (void) {
+                m_VKModelCacheLog = LOG_INIT (m_instanceId, g_collectionSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+            }
+
+            ~VKModelCache (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* Vertex and index data of a model as read from its cache file. The spans point into a read only mapping of
+             * the file, which stays mapped for as long as a copy of the mapping pointer is held
+            */
+            struct CachedModel {
+                std::shared_ptr <const void> mapping;
+                std::span <const Vertex>   vertices;
+                std::span <const uint32_t> indices;
+                std::span <const uint32_t> lodIndices;
+                std::vector <uint32_t> lodIndicesCounts;
+                std::vector <std::string> diffuseTextureImages;
+                uint64_t textureMappingHash;
+            };
+
+            /* Hash of the model file and the .mtl files it references (mtllib statements, resolved against the .mtl
+             * file directory)
+            */
+            uint64_t getSourceHash (const char* modelPath, const char* mtlFileDirPath) {
+                std::string contents;
+                if (!readFile (modelPath, contents))
+                    return 0;
+                /* The vertices built from a model file also depend on the parser that read it and on whether they were
+                 * reordered, and the levels of detail on the settings they were generated with
+                */
+                const uint32_t builderId = (ENABLE_NATIVE_OBJ_PARSER ? 1: 0) |
+                                           (ENABLE_MESH_OPTIMIZATION ? 2: 0) |
+                                           (ENABLE_MESH_LOD          ? 4: 0);
+                const float lodSettings[3] = {
+                    static_cast <float> (g_coreSettings.maxLODsCount),
+                    g_coreSettings.lodIndicesRatio,
+                    g_coreSettings.lodMaxError
+                };
+                uint64_t hash = getHash (&builderId,      sizeof (builderId));
+                hash          = getHash (lodSettings,     sizeof (lodSettings), hash);
+                hash          = getHash (contents.data(), contents.size(),     hash);
+
+                std::istringstream stream (contents);
+                std::string line;
+                while (std::getline (stream, line)) {
+                    if (line.compare (0, 7, "mtllib ") != 0)
+                        continue;
+
+                    std::istringstream names (line.substr (7));
+                    std::string name, mtlContents;
+                    while (names >> name) {
+                        hash = getHash (name.data(), name.size(), hash);
+                        if (readFile (std::string (mtlFileDirPath) + name, mtlContents))
+                            hash = getHash (mtlContents.data(), mtlContents.size(), hash);
+                    }
+                }
+                return hash;
+            }
+
+            static uint64_t getTextureMappingHash (const std::vector <uint32_t>& textureImageInfoIds) {
+                return getHash (textureImageInfoIds.data(), textureImageInfoIds.size() * sizeof (uint32_t));
+            }
+
+            /* Map the model's cache file, fails if there is no cache file or if it was written for a different version
+             * of the model file or of the cache format
+            */
+            bool readModelCache (const char* modelPath, uint64_t sourceHash, CachedModel& cachedModel) {
+                std::string cacheFilePath = getCacheFilePath (modelPath);
+                int fd = open (cacheFilePath.c_str(), O_RDONLY);
+                if (fd == -1)
+                    return false;
+
+                struct stat fileStat;
+                if (fstat (fd, &fileStat) != 0 ||
+                    static_cast <size_t> (fileStat.st_size) < ModelCacheFormat::FILE_HEADER_SIZE) {
+                    close (fd);
+                    return false;
+                }
+
+                size_t fileSize = static_cast <size_t> (fileStat.st_size);
+                void* base      = mmap (nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+                close (fd);
+                if (base == MAP_FAILED)
+                    return false;
+                /* Unmapped once the last copy goes away
+                */
+                std::shared_ptr <const void> mapping (base, [fileSize](const void* ptr) {
+                    munmap (const_cast <void*> (ptr), fileSize);
+                });
+
+                ModelCacheFormat::FileHeader header;
+                memcpy (&header, base, sizeof (header));
+
+                size_t verticesSize = static_cast <size_t> (header.verticesCount) * sizeof (Vertex);
+                size_t indicesSize  = (static_cast <size_t> (header.indicesCount) + header.lodIndicesCount) *
+                                      sizeof (uint32_t);
+                size_t lodsSize     = static_cast <size_t> (header.lodsCount) * sizeof (uint32_t);
+                if (memcmp (header.magic, ModelCacheFormat::MAGIC, sizeof (ModelCacheFormat::MAGIC)) != 0 ||
+                    header.version                                 != ModelCacheFormat::VERSION              ||
+                    header.vertexSize                              != sizeof (Vertex)                        ||
+                    header.sourceHash                              != sourceHash                             ||
+                    header.fileSize                                != fileSize                               ||
+                    header.texturePathsOffset + header.texturePathsSize > fileSize                           ||
+                    header.verticesOffset     + verticesSize            > fileSize                           ||
+                    header.indicesOffset      + indicesSize             > fileSize                           ||
+                    header.lodsOffset         + lodsSize                > fileSize                           ||
+                    header.verticesOffset % ModelCacheFormat::VERTICES_ALIGNMENT != 0                        ||
+                    header.indicesOffset  % alignof (uint32_t)                   != 0                        ||
+                    header.lodsOffset     % alignof (uint32_t)                   != 0)
+                    return false;
+
+                auto bytes = static_cast <const char*> (base);
+                cachedModel.diffuseTextureImages.clear();
+
+                const char* texturePath     = bytes + header.texturePathsOffset;
+                const char* texturePathsEnd = texturePath + header.texturePathsSize;
+                for (uint32_t i = 0; i < header.texturePathsCount; i++) {
+                    size_t length = strnlen (texturePath, static_cast <size_t> (texturePathsEnd - texturePath));
+                    if (texturePath + length == texturePathsEnd)
+                        return false;
+
+                    cachedModel.diffuseTextureImages.emplace_back (texturePath, length);
+                    texturePath += length + 1;
+                }
+
+                auto lodIndicesCounts          = reinterpret_cast <const uint32_t*> (bytes + header.lodsOffset);
+                cachedModel.lodIndicesCounts.assign (lodIndicesCounts, lodIndicesCounts + header.lodsCount);
+
+                uint64_t lodIndicesCount = 0;
+                for (auto const& count: cachedModel.lodIndicesCounts)
+                    lodIndicesCount += count;
+                if (lodIndicesCount != header.lodIndicesCount)
+                    return false;
+
+                cachedModel.vertices           = std::span <const Vertex> (
+                    reinterpret_cast <const Vertex*> (bytes + header.verticesOffset), header.verticesCount);
+                cachedModel.indices            = std::span <const uint32_t> (
+                    reinterpret_cast <const uint32_t*> (bytes + header.indicesOffset), header.indicesCount);
+                cachedModel.lodIndices         = std::span <const uint32_t> (
+                    cachedModel.indices.data() + header.indicesCount, header.lodIndicesCount);
+                cachedModel.textureMappingHash = header.textureMappingHash;
+                cachedModel.mapping            = mapping;
+                return true;
+            }
+
+            /* The file is written under a temporary name and renamed into place, so a cache file is either complete or
+             * absent even if the process goes down mid write (or another process is importing the same model)
+            */
+            void writeModelCache (const char* modelPath,
+                                  uint64_t sourceHash,
+                                  uint64_t textureMappingHash,
+                                  std::span <const std::string> diffuseTextureImages,
+                                  std::span <const Vertex> vertices,
+                                  std::span <const uint32_t> indices,
+                                  std::span <const uint32_t> lodIndices,
+                                  std::span <const uint32_t> lodIndicesCounts) {
+
+                ModelCacheFormat::FileHeader header{};
+                memcpy (header.magic, ModelCacheFormat::MAGIC, sizeof (ModelCacheFormat::MAGIC));
+                header.version            = ModelCacheFormat::VERSION;
+                header.vertexSize         = sizeof (Vertex);
+                header.sourceHash         = sourceHash;
+                header.textureMappingHash = textureMappingHash;
+                header.verticesCount      = static_cast <uint32_t> (vertices.size());
+                header.indicesCount       = static_cast <uint32_t> (indices.size());
+                header.texturePathsCount  = static_cast <uint32_t> (diffuseTextureImages.size());
+                header.lodsCount          = static_cast <uint32_t> (lodIndicesCounts.size());
+                header.lodIndicesCount    = static_cast <uint32_t> (lodIndices.size());
+
+                std::string texturePaths;
+                for (auto const& path: diffuseTextureImages)
+                    texturePaths.append (path.c_str(), path.size() + 1);
+
+                size_t alignment          = ModelCacheFormat::VERTICES_ALIGNMENT;
+                header.texturePathsSize   = static_cast <uint32_t> (texturePaths.size());
+                header.texturePathsOffset = ModelCacheFormat::FILE_HEADER_SIZE;
+                size_t lodsAlignment      = alignof (uint32_t);
+                header.lodsOffset         = (header.texturePathsOffset + header.texturePathsSize + lodsAlignment - 1) /
+                                            lodsAlignment * lodsAlignment;
+                header.verticesOffset     = (header.lodsOffset + lodIndicesCounts.size_bytes() + alignment - 1) /
+                                            alignment * alignment;
+                header.indicesOffset      = header.verticesOffset + vertices.size_bytes();
+                header.fileSize           = header.indicesOffset  + indices.size_bytes() + lodIndices.size_bytes();
+
+                std::string cacheFilePath = getCacheFilePath (modelPath);
+                std::string tempFilePath  = cacheFilePath + ".tmp" + std::to_string (getpid());
+                {
+                    std::ofstream file (tempFilePath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+                    /* Header, texture paths and levels of detail, zero padded up to the vertices
+                    */
+                    std::vector <char> prefix (header.verticesOffset, '\0');
+                    memcpy (prefix.data(), &header, sizeof (header));
+                    memcpy (prefix.data() + header.texturePathsOffset, texturePaths.data(), texturePaths.size());
+                    std::copy (lodIndicesCounts.begin(), lodIndicesCounts.end(),
+                               reinterpret_cast <uint32_t*> (prefix.data() + header.lodsOffset));
+
+                    file.write (prefix.data(), static_cast <std::streamsize> (prefix.size()));
+                    file.write (reinterpret_cast <const char*> (vertices.data()),
+                                static_cast <std::streamsize> (vertices.size_bytes()));
+                    file.write (reinterpret_cast <const char*> (indices.data()),
+                                static_cast <std::streamsize> (indices.size_bytes()));
+                    file.write (reinterpret_cast <const char*> (lodIndices.data()),
+                                static_cast <std::streamsize> (lodIndices.size_bytes()));
+
+                    if (file.good()) {
+                        file.close();
+                        if (std::rename (tempFilePath.c_str(), cacheFilePath.c_str()) == 0)
+                            return;
+                    }
+                }
+                remove (tempFilePath.c_str());
+                LOG_WARNING (m_VKModelCacheLog) << "Failed to write model cache "
+                                                << "[" << cacheFilePath << "]"
+                                                << std::endl;
+            }
+    };
+}   // namespace Core
+#endif  // VK_MODEL_CACHE_H
\ No newline at end of file
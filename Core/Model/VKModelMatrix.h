@@ -3,6 +3,8 @@
 
 #define GLM_FORCE_RADIANS
 #include <glm/gtc/matrix_transform.hpp>
+#include "VKModelMatrixBatch.h"
+#include "VKInstanceTransform.h"
 #include "VKModelMgr.h"
 
 namespace Core {
@@ -59,11 +61,94 @@ namespace Core {
                 glm::vec3 scale       = modelInfo->meta.instanceDatas[modelInstanceId].scale;
                 float rotateAngleDeg  = modelInfo->meta.instanceDatas[modelInstanceId].rotateAngleDeg;
 
-                glm::mat4 modelMatrix = glm::translate (glm::mat4 (1.0f), position) *
-                                        glm::rotate    (glm::mat4 (1.0f), glm::radians (rotateAngleDeg), rotateAxis) *
-                                        glm::scale     (glm::mat4 (1.0f), scale);
+                /* Same as glm::translate (I, position) * glm::rotate (I, angle, rotateAxis) * glm::scale (I, scale), see
+                 * VKModelMatrixBatch
+                */
+                glm::mat4 modelMatrix = VKModelMatrixBatch::getModelMatrix (position, rotateAxis, scale, rotateAngleDeg);
+
+                modelInfo->meta.modelMatrices[modelInstanceId] = modelMatrix;
+                VKInstanceTransform::encodeTransform (modelInfo->meta.instances[modelInstanceId],
+                                                      modelMatrix,
+                                                      rotateAxis,
+                                                      scale,
+                                                      rotateAngleDeg);
+                setInstanceDirty (modelInfo, modelInstanceId);
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                createPositionDequant (modelInfoId, modelInstanceId);
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+            }
+
+            /* Model matrices of every instance of the model, bit identical to createModelMatrix. The instances are split
+             * into batches of instanceBatchSize spread over the worker pool, and every batch is composed a chunk at a
+             * time: the instance datas are transposed into struct of arrays layout (along with the sine and cosine of
+             * the angles), composed with SIMD, and the results written to the model matrices (and encoded into the
+             * instances). Instances only write to their own entries, so the batches need no synchronization
+            */
+            void createModelMatrices (uint32_t modelInfoId) {
+                auto modelInfo          = getModelInfo (modelInfoId);
+                size_t instancesCount   = modelInfo->meta.instancesCount;
+                size_t batchSize        = g_coreSettings.instanceBatchSize;
+                size_t batchesCount     = (instancesCount + batchSize - 1) / batchSize;
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                glm::vec4 positionOffset = glm::vec4 (modelInfo->meta.bounds.min, 0.0f);
+                glm::vec4 positionScale  = glm::vec4 (VKVertexCompact::getPositionScale (modelInfo->meta.bounds), 0.0f);
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+
+                Worker::g_workerPool.parallelFor (batchesCount, [&](size_t i) {
+                    /* Lanes past the last instance of a chunk keep the values of the chunk before them (or zero), they
+                     * are composed but never read
+                    */
+                    VKModelMatrixBatch::TRSChunk trsChunk {};
+                    VKModelMatrixBatch::AffineChunk affineChunk;
+                    size_t lastInstanceId = std::min (instancesCount, (i + 1) * batchSize);
+
+                    for (size_t firstInstanceId = i * batchSize; firstInstanceId < lastInstanceId;
+                         firstInstanceId += VKModelMatrixBatch::CHUNK_SIZE) {
+
+                        size_t chunkInstancesCount = std::min (VKModelMatrixBatch::CHUNK_SIZE,
+                                                               lastInstanceId - firstInstanceId);
+                        for (size_t j = 0; j < chunkInstancesCount; j++) {
+                            auto& instanceData = modelInfo->meta.instanceDatas[firstInstanceId + j];
+                            float angle        = glm::radians (instanceData.rotateAngleDeg);
+                            for (int k = 0; k < 3; k++) {
+                                trsChunk.position[k][j]   = instanceData.position[k];
+                                trsChunk.rotateAxis[k][j] = instanceData.rotateAxis[k];
+                                trsChunk.scale[k][j]      = instanceData.scale[k];
+                            }
+                            trsChunk.cosAngle[j] = std::cos (angle);
+                            trsChunk.sinAngle[j] = std::sin (angle);
+                        }
+
+                        VKModelMatrixBatch::composeChunk (trsChunk, affineChunk, chunkInstancesCount);
+
+                        for (size_t j = 0; j < chunkInstancesCount; j++) {
+                            auto& modelMatrix = modelInfo->meta.modelMatrices[firstInstanceId + j];
+                            for (int k = 0; k < 3; k++)
+                                modelMatrix[k] = glm::vec4 (affineChunk.columns[k][0][j],
+                                                            affineChunk.columns[k][1][j],
+                                                            affineChunk.columns[k][2][j], 0.0f);
+                            modelMatrix[3]     = glm::vec4 (trsChunk.position[0][j],
+                                                            trsChunk.position[1][j],
+                                                            trsChunk.position[2][j], 1.0f);
 
-                modelInfo->meta.instances[modelInstanceId].modelMatrix = modelMatrix;
+                            auto& instanceData = modelInfo->meta.instanceDatas[firstInstanceId + j];
+                            VKInstanceTransform::encodeTransform (modelInfo->meta.instances[firstInstanceId + j],
+                                                                  modelMatrix,
+                                                                  instanceData.rotateAxis,
+                                                                  instanceData.scale,
+                                                                  instanceData.rotateAngleDeg);
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                            auto& staticInstance          = modelInfo->meta.staticInstances[firstInstanceId + j];
+                            staticInstance.positionOffset = positionOffset;
+                            staticInstance.positionScale  = positionScale;
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+                        }
+                    }
+                });
+                setInstancesDirty (modelInfo);
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                setStaticInstancesDirty (modelInfo);
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
             }
     };
 }   // namespace Core
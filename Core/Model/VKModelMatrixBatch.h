@@ -0,0 +1,208 @@
+#ifndef VK_MODEL_MATRIX_BATCH_H
+#define VK_MODEL_MATRIX_BATCH_H
+
+#include <cmath>
+#include <cstddef>
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#if defined (__SSE2__)
+#include <immintrin.h>
+#endif  // __SSE2__
+
+namespace Core {
+    /* Model matrices (translate * rotate * scale) of instances in struct of arrays layout, composed without the three
+     * 4x4 matrix multiplies. The product only has 12 elements that are not 0 or 1
+     *
+     *      | r00 * sx   r10 * sy   r20 * sz   px |
+     *      | r01 * sx   r11 * sy   r21 * sz   py |
+     *      | r02 * sx   r12 * sy   r22 * sz   pz |
+     *      | 0          0          0          1  |
+     *
+     * where r is the rotation matrix built the way glm::rotate builds it. Each of these elements is the same
+     * multiplications and additions, in the same order, as in glm::translate * glm::rotate * glm::scale, so the two
+     * agree exactly (except for the sign of zero elements that glm gets from adding products with zero)
+     *
+     * The instances are processed WIDTH at a time, with AVX (8 lanes), SSE (4 lanes) or one at a time as a fallback.
+     * Every path runs the same compose function, sine and cosine are computed with std::sin and std::cos ahead of it
+     * since there is no vector equivalent that gives the same results. Note that, the paths (and glm) are only bit
+     * identical as long as the compiler does not contract multiplications and additions into fused multiply adds.
+     * That is the default for -std=c++20 with gcc, but clang contracts within an expression by default (which fuses
+     * the terms of glm::rotate on targets with FMA, such as arm64), so the Makefile passes -ffp-contract=off
+    */
+    class VKModelMatrixBatch {
+        public:
+            /* Number of instances in a chunk, the arrays are padded to it so that every path can run over whole
+             * vectors
+            */
+            static constexpr size_t CHUNK_SIZE = 64;
+
+            struct TRSChunk {
+                alignas (32) float position[3][CHUNK_SIZE];
+                alignas (32) float rotateAxis[3][CHUNK_SIZE];
+                alignas (32) float scale[3][CHUNK_SIZE];
+                alignas (32) float cosAngle[CHUNK_SIZE];
+                alignas (32) float sinAngle[CHUNK_SIZE];
+            };
+
+            /* Upper left 3x3 of the model matrices, column major. The translation is the position
+            */
+            struct AffineChunk {
+                alignas (32) float columns[3][3][CHUNK_SIZE];
+            };
+
+        private:
+            struct ScalarLanes {
+                using Type = float;
+                static constexpr size_t WIDTH = 1;
+
+                static Type load  (const float* src)        { return *src;         }
+                static void store (float* dst, Type a)      { *dst = a;            }
+                static Type set1  (float a)                 { return a;            }
+                static Type add   (Type a, Type b)          { return a + b;        }
+                static Type sub   (Type a, Type b)          { return a - b;        }
+                static Type mul   (Type a, Type b)          { return a * b;        }
+                static Type div   (Type a, Type b)          { return a / b;        }
+                static Type sqrt  (Type a)                  { return std::sqrt (a); }
+            };
+
+#if defined (__SSE2__)
+            struct SSELanes {
+                using Type = __m128;
+                static constexpr size_t WIDTH = 4;
+
+                static Type load  (const float* src)        { return _mm_load_ps  (src);    }
+                static void store (float* dst, Type a)      { _mm_store_ps (dst, a);        }
+                static Type set1  (float a)                 { return _mm_set1_ps  (a);      }
+                static Type add   (Type a, Type b)          { return _mm_add_ps   (a, b);   }
+                static Type sub   (Type a, Type b)          { return _mm_sub_ps   (a, b);   }
+                static Type mul   (Type a, Type b)          { return _mm_mul_ps   (a, b);   }
+                static Type div   (Type a, Type b)          { return _mm_div_ps   (a, b);   }
+                static Type sqrt  (Type a)                  { return _mm_sqrt_ps  (a);      }
+            };
+#endif  // __SSE2__
+
+#if defined (__AVX__)
+            struct AVXLanes {
+                using Type = __m256;
+                static constexpr size_t WIDTH = 8;
+
+                static Type load  (const float* src)        { return _mm256_load_ps  (src);  }
+                static void store (float* dst, Type a)      { _mm256_store_ps (dst, a);      }
+                static Type set1  (float a)                 { return _mm256_set1_ps  (a);    }
+                static Type add   (Type a, Type b)          { return _mm256_add_ps   (a, b); }
+                static Type sub   (Type a, Type b)          { return _mm256_sub_ps   (a, b); }
+                static Type mul   (Type a, Type b)          { return _mm256_mul_ps   (a, b); }
+                static Type div   (Type a, Type b)          { return _mm256_div_ps   (a, b); }
+                static Type sqrt  (Type a)                  { return _mm256_sqrt_ps  (a);    }
+            };
+#endif  // __AVX__
+
+            /* Rotation (about the normalized axis) times scale, in the order of operations of glm::rotate and
+             * glm::normalize (v * 1 / sqrt (dot (v, v)))
+            */
+            template <typename L>
+            static void compose (const typename L::Type rotateAxis[3],
+                                 const typename L::Type scale[3],
+                                 typename L::Type cosAngle,
+                                 typename L::Type sinAngle,
+                                 typename L::Type columns[3][3]) {
+
+                using T = typename L::Type;
+                T lengthSq  = L::add (L::add (L::mul (rotateAxis[0], rotateAxis[0]),
+                                              L::mul (rotateAxis[1], rotateAxis[1])),
+                                              L::mul (rotateAxis[2], rotateAxis[2]));
+                T invLength = L::div (L::set1 (1.0f), L::sqrt (lengthSq));
+                T axis[3]   = {
+                    L::mul (rotateAxis[0], invLength),
+                    L::mul (rotateAxis[1], invLength),
+                    L::mul (rotateAxis[2], invLength)
+                };
+                T oneMinusCos = L::sub (L::set1 (1.0f), cosAngle);
+                T temp[3]     = {
+                    L::mul (oneMinusCos, axis[0]),
+                    L::mul (oneMinusCos, axis[1]),
+                    L::mul (oneMinusCos, axis[2])
+                };
+
+                T rotate[3][3];
+                rotate[0][0] = L::add (cosAngle, L::mul (temp[0], axis[0]));
+                rotate[0][1] = L::add (L::mul (temp[0], axis[1]), L::mul (sinAngle, axis[2]));
+                rotate[0][2] = L::sub (L::mul (temp[0], axis[2]), L::mul (sinAngle, axis[1]));
+
+                rotate[1][0] = L::sub (L::mul (temp[1], axis[0]), L::mul (sinAngle, axis[2]));
+                rotate[1][1] = L::add (cosAngle, L::mul (temp[1], axis[1]));
+                rotate[1][2] = L::add (L::mul (temp[1], axis[2]), L::mul (sinAngle, axis[0]));
+
+                rotate[2][0] = L::add (L::mul (temp[2], axis[0]), L::mul (sinAngle, axis[1]));
+                rotate[2][1] = L::sub (L::mul (temp[2], axis[1]), L::mul (sinAngle, axis[0]));
+                rotate[2][2] = L::add (cosAngle, L::mul (temp[2], axis[2]));
+
+                for (size_t i = 0; i < 3; i++) {
+                    for (size_t j = 0; j < 3; j++)
+                        columns[i][j] = L::mul (rotate[i][j], scale[i]);
+                }
+            }
+
+            /* Instances [begin, end) of the chunk, end - begin is expected to be a multiple of the width
+            */
+            template <typename L>
+            static void composeChunk (const TRSChunk& trsChunk, AffineChunk& affineChunk, size_t begin, size_t end) {
+                using T = typename L::Type;
+                for (size_t i = begin; i < end; i += L::WIDTH) {
+                    T rotateAxis[3], scale[3], columns[3][3];
+                    for (size_t j = 0; j < 3; j++) {
+                        rotateAxis[j] = L::load (&trsChunk.rotateAxis[j][i]);
+                        scale[j]      = L::load (&trsChunk.scale[j][i]);
+                    }
+                    compose <L> (rotateAxis,
+                                 scale,
+                                 L::load (&trsChunk.cosAngle[i]),
+                                 L::load (&trsChunk.sinAngle[i]),
+                                 columns);
+
+                    for (size_t j = 0; j < 3; j++) {
+                        for (size_t k = 0; k < 3; k++)
+                            L::store (&affineChunk.columns[j][k][i], columns[j][k]);
+                    }
+                }
+            }
+
+        public:
+            /* Compose the first instancesCount instances of the chunk. Lanes past instancesCount (up to the next
+             * multiple of the width) are composed too, from whatever the chunk holds there, and are to be ignored
+            */
+            static void composeChunk (const TRSChunk& trsChunk, AffineChunk& affineChunk, size_t instancesCount) {
+                size_t begin = 0;
+#if defined (__AVX__)
+                size_t end   = (instancesCount + AVXLanes::WIDTH - 1) / AVXLanes::WIDTH * AVXLanes::WIDTH;
+                composeChunk <AVXLanes>    (trsChunk, affineChunk, begin, end);
+#elif defined (__SSE2__)
+                size_t end   = (instancesCount + SSELanes::WIDTH - 1) / SSELanes::WIDTH * SSELanes::WIDTH;
+                composeChunk <SSELanes>    (trsChunk, affineChunk, begin, end);
+#else
+                size_t end   = instancesCount;
+                composeChunk <ScalarLanes> (trsChunk, affineChunk, begin, end);
+#endif  // __AVX__
+            }
+
+            /* Single instance, through the scalar path
+            */
+            static glm::mat4 getModelMatrix (const glm::vec3& position,
+                                             const glm::vec3& rotateAxis,
+                                             const glm::vec3& scale,
+                                             float rotateAngleDeg) {
+
+                float angle           = glm::radians (rotateAngleDeg);
+                float axisValues[3]   = {rotateAxis.x, rotateAxis.y, rotateAxis.z};
+                float scaleValues[3]  = {scale.x,      scale.y,      scale.z};
+                float columns[3][3];
+                compose <ScalarLanes> (axisValues, scaleValues, std::cos (angle), std::sin (angle), columns);
+
+                return glm::mat4 (glm::vec4 (columns[0][0], columns[0][1], columns[0][2], 0.0f),
+                                  glm::vec4 (columns[1][0], columns[1][1], columns[1][2], 0.0f),
+                                  glm::vec4 (columns[2][0], columns[2][1], columns[2][2], 0.0f),
+                                  glm::vec4 (position, 1.0f));
+            }
+    };
+}   // namespace Core
+#endif  // VK_MODEL_MATRIX_BATCH_H
\ No newline at end of file
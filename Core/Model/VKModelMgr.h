@@ -4,11 +4,19 @@
 */
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tinyobjloader/tiny_obj_loader.h>
-#include "VKVertexData.h"
+#include <numeric>
+#include "VKModelCache.h"
+#include "VKVertexDedup.h"
+#include "VKOBJParser.h"
+#include "VKMeshOptimizer.h"
+#include "VKVertexCompact.h"
+#include "VKMeshSimplifier.h"
+#include "VKMeshlet.h"
+#include "../../Collection/Worker/WorkerPool.h"
 #include "../Scene/VKUniform.h"
 
 namespace Core {
-    class VKModelMgr: protected VKVertexData {
+    class VKModelMgr: protected VKModelCache {
         private:
             struct InstanceData {
                 glm::vec3 position;
@@ -17,22 +25,81 @@ namespace Core {
                 float rotateAngleDeg;
             };
 
+            /* Range of a level of detail within the indices of a model, where the indices of the levels of detail follow
+             * the model's own indices (level 0)
+            */
+            struct LOD {
+                uint32_t firstIndex;
+                uint32_t indicesCount;
+            };
+
             struct ModelInfo {
                 struct Meta {
                     /* The attributes are combined into one array of vertices, this is known as interleaving vertex
                      * attributes
                     */
-                    std::vector <Vertex> vertices;
+                    std::span <const Vertex> vertices;
                     /* Note that it is possible to use either uint16_t or uint32_t for your index buffer depending on the
                      * number of entries in vertices, you also have to specify the correct type when binding the index
                      * buffer
                     */
-                    std::vector <uint32_t> indices;
-                    std::vector <InstanceDataSSBO> instances;
+                    std::span <const uint32_t> indices;
+                    /* Memory behind the vertices and indices, either the vectors built at import or a read only mapping
+                     * of the model cache file
+                    */
+                    std::vector <Vertex>   verticesStorage;
+                    std::vector <uint32_t> indicesStorage;
+                    std::shared_ptr <const void> cacheMapping;
+                    /* Indices of the levels of detail other than the model itself, they reference the model's vertices
+                    */
+                    std::span <const uint32_t> lodIndices;
+                    std::vector <uint32_t> lodIndicesStorage;
+                    std::vector <LOD> lods;
+                    /* Number of instances drawn at every level of detail in the current frame
+                    */
+                    std::vector <uint32_t> lodInstancesCounts;
+                    /* Clusters of the model's own indices (level 0)
+                    */
+                    std::vector <Meshlet> meshlets;
+                    /* The instances are a slice of the instance arena once the model has been given one (see
+                     * readyInstanceArena), and the vector built at import until then. The model matrices are kept on
+                     * the host as 4x4 matrices, whatever the layout of the transforms in the instances
+                    */
+                    std::span <InstanceDataSSBO> instances;
+                    std::vector <InstanceDataSSBO> instancesStorage;
                     std::vector <InstanceData>     instanceDatas;
+                    std::vector <glm::mat4>        modelMatrices;
+                    /* Static data of the instances, in a slice of the static instance arena at the same offset as the
+                     * instances' slice (or a vector of its own, like the instances). An instance's flag is set while the
+                     * static instance data buffer has not seen its latest static data (see setStaticInstanceDirty)
+                    */
+                    std::span <StaticInstanceDataSSBO> staticInstances;
+                    std::vector <StaticInstanceDataSSBO> staticInstancesStorage;
+                    std::vector <uint8_t> staticInstanceDirtyFlags;
+                    /* Model instance ids in the order their instances are laid out in the model's slice of the storage
+                     * buffer, ordered by level of detail every frame (see orderInstancesByLOD)
+                    */
+                    std::vector <uint32_t> drawOrder;
+                    /* Bit n of an instance's mask is set while the copy of the instances for frame in flight n has not
+                     * seen the instance's latest data (see setInstanceDirty)
+                    */
+                    std::vector <uint32_t> instanceDirtyMasks;
+                    /* Model space bounding box of the vertices
+                    */
+                    BoundingBox bounds;
+                    /* Where the model's vertices and indices start in the combined vertex and index buffers, and the
+                     * type of its indices. Set when the buffers are created, and moved when the model is reloaded (see
+                     * VKModelReload)
+                    */
+                    int32_t vertexOffset;
+                    VKVertexCompact::IndexSegment indexSegment;
                     uint32_t verticesCount;
                     uint32_t indicesCount;
                     uint32_t instancesCount;
+                    /* Where the model's slice starts in the instance arena, and in the storage buffer. UINT32_MAX if the
+                     * model has no slice
+                    */
+                    uint32_t firstArenaInstance;
                     uint32_t parsedDataLogInstanceId;
                 } meta;
 
@@ -49,6 +116,28 @@ namespace Core {
                 } id;
             };
             std::unordered_map <uint32_t, ModelInfo>   m_modelInfoPool;
+            /* Instances of the drawn models back to back, in the layout of the storage buffer. Every model owns a fixed
+             * slice of it, so the instances are written to the storage buffer from where they live
+            */
+            std::vector <InstanceDataSSBO> m_instanceArena;
+            std::vector <StaticInstanceDataSSBO> m_staticInstanceArena;
+            /* Model file contents held between the import stages, see importOBJModels
+            */
+            struct ImportStaging {
+#if ENABLE_NATIVE_OBJ_PARSER
+                OBJParsedData parsedData;
+#else
+                tinyobj::attrib_t attrib;
+                std::vector <tinyobj::shape_t> shapes;
+#endif  // ENABLE_NATIVE_OBJ_PARSER
+                std::vector <tinyobj::material_t> materials;
+                /* Set if the model was found in the model cache, in which case the model file is not parsed unless the
+                 * cached vertices turn out to have been built with different texture image info ids
+                */
+                bool isCached;
+                uint64_t sourceHash;
+                CachedModel cachedModel;
+            };
 
             uint32_t m_textureImageInfoId;
             std::unordered_map <std::string, uint32_t> m_textureImagePool;
@@ -129,6 +218,87 @@ namespace Core {
             }
 
         protected:
+            /* Draw of a range of a model's indices for a run of instances, emitted by the cluster culling
+            */
+            struct MeshletDraw {
+                uint32_t firstIndex;
+                uint32_t indicesCount;
+                uint32_t firstInstance;
+                uint32_t instancesCount;
+            };
+
+            /* Slots of the storage buffer that a frame in flight's copy needs written. The copy remembers which
+             * instance (model info id << 32 | model instance id) it holds in every slot, a slot is dirty when a
+             * different instance has moved into it (instances are reordered by level of detail every frame) or when
+             * its instance has changed since the copy last saw it
+            */
+            struct InstanceSlotTracker {
+                uint32_t frameInFlight;
+                std::vector <uint64_t>* slotKeys;
+            };
+
+            /* Mark the instance's data as changed for every frame in flight, call after writing to it. Instances the
+             * masks do not cover yet (the instances were resized) start out changed
+            */
+            static void setInstanceDirty (ModelInfo* modelInfo, uint32_t modelInstanceId) {
+                uint32_t allFramesMask = getAllFramesMask();
+                modelInfo->meta.instanceDirtyMasks.resize (modelInfo->meta.instances.size(), allFramesMask);
+                modelInfo->meta.instanceDirtyMasks[modelInstanceId] = allFramesMask;
+            }
+
+            static uint32_t getAllFramesMask (void) {
+                return static_cast <uint32_t> ((1ULL << g_coreSettings.maxFramesInFlight) - 1);
+            }
+
+            static void setInstancesDirty (ModelInfo* modelInfo) {
+                modelInfo->meta.instanceDirtyMasks.assign (modelInfo->meta.instances.size(), getAllFramesMask());
+            }
+
+            /* Mark the instance's static data as changed, call after writing to it. Unlike the instances, there is one
+             * static instance data buffer for all the frames in flight, so a single flag is enough
+            */
+            static void setStaticInstanceDirty (ModelInfo* modelInfo, uint32_t modelInstanceId) {
+                modelInfo->meta.staticInstanceDirtyFlags.resize (modelInfo->meta.staticInstances.size(), 1);
+                modelInfo->meta.staticInstanceDirtyFlags[modelInstanceId] = 1;
+            }
+
+            static void setStaticInstancesDirty (ModelInfo* modelInfo) {
+                modelInfo->meta.staticInstanceDirtyFlags.assign (modelInfo->meta.staticInstances.size(), 1);
+            }
+
+            static void readyInstanceSlotTracker (InstanceSlotTracker* tracker, size_t slotsCount) {
+                if (tracker == nullptr)
+                    return;
+                /* Slots the copy has never been written to hold no instance
+                */
+                tracker->slotKeys->resize (slotsCount, UINT64_MAX);
+            }
+
+            /* Returns true if the slot is to be written, in which case the instance's bit for the frame in flight is
+             * cleared. Without a tracker every slot is written
+            */
+            static bool trackInstanceSlot (InstanceSlotTracker* tracker,
+                                           size_t slot,
+                                           uint32_t modelInfoId,
+                                           ModelInfo* modelInfo,
+                                           uint32_t modelInstanceId) {
+                if (tracker == nullptr)
+                    return true;
+
+                auto& masks        = modelInfo->meta.instanceDirtyMasks;
+                uint32_t frameMask = 1u << tracker->frameInFlight;
+                uint64_t slotKey   = static_cast <uint64_t> (modelInfoId) << 32 | modelInstanceId;
+                if (masks.size() < modelInfo->meta.instances.size())
+                    masks.resize (modelInfo->meta.instances.size(), getAllFramesMask());
+
+                if ((masks[modelInstanceId] & frameMask) != 0 || (*tracker->slotKeys)[slot] != slotKey) {
+                    (*tracker->slotKeys)[slot] = slotKey;
+                    masks[modelInstanceId]    &= ~frameMask;
+                    return true;
+                }
+                return false;
+            }
+
             void readyModelInfo (uint32_t modelInfoId,
                                  const char* modelPath,
                                  const char* mtlFileDirPath) {
@@ -149,6 +319,7 @@ namespace Core {
                 */
                 info.path.diffuseTextureImages.push_back (g_coreSettings.defaultDiffuseTexturePath);
 
+                info.meta.firstArenaInstance      = UINT32_MAX;
                 info.id.indexBufferInfo           = UINT32_MAX;
                 m_modelInfoPool[modelInfoId]      = info;
                 m_textureImageInfoId              = 0;
@@ -162,16 +333,37 @@ namespace Core {
                                 nameExtension.c_str());
             }
 
-            void createVertices (uint32_t modelInfoId, const std::vector <Vertex>& vertices) {
+            void createVertices (uint32_t modelInfoId, std::vector <Vertex>&& vertices) {
+                auto modelInfo = getModelInfo (modelInfoId);
+                modelInfo->meta.verticesStorage = std::move (vertices);
+                modelInfo->meta.vertices        = modelInfo->meta.verticesStorage;
+                modelInfo->meta.verticesCount   = static_cast <uint32_t> (modelInfo->meta.vertices.size());
+                modelInfo->meta.bounds          = VKVertexCompact::getBoundingBox (modelInfo->meta.vertices);
+            }
+
+            void createIndices (uint32_t modelInfoId, std::vector <uint32_t>&& indices) {
                 auto modelInfo = getModelInfo (modelInfoId);
-                modelInfo->meta.vertices      = vertices;
-                modelInfo->meta.verticesCount = static_cast <uint32_t> (vertices.size());
+                modelInfo->meta.indicesStorage = std::move (indices);
+                modelInfo->meta.indices        = modelInfo->meta.indicesStorage;
+                modelInfo->meta.indicesCount   = static_cast <uint32_t> (modelInfo->meta.indices.size());
+                createLODs (modelInfoId, {}, {});
             }
 
-            void createIndices (uint32_t modelInfoId, const std::vector <uint32_t>& indices) {
+            /* Level 0 is the model itself, followed by a level for every entry in lodIndicesCounts
+            */
+            void createLODs (uint32_t modelInfoId,
+                             std::span <const uint32_t> lodIndices,
+                             std::span <const uint32_t> lodIndicesCounts) {
+
                 auto modelInfo = getModelInfo (modelInfoId);
-                modelInfo->meta.indices      = indices;
-                modelInfo->meta.indicesCount = static_cast <uint32_t> (indices.size());
+                modelInfo->meta.lodIndices = lodIndices;
+                modelInfo->meta.lods       = {{0, modelInfo->meta.indicesCount}};
+
+                uint32_t firstIndex = modelInfo->meta.indicesCount;
+                for (auto const& indicesCount: lodIndicesCounts) {
+                    modelInfo->meta.lods.push_back ({firstIndex, indicesCount});
+                    firstIndex += indicesCount;
+                }
             }
 
             /* OBJ file format
@@ -224,33 +416,44 @@ namespace Core {
             /* Note that, you should run your program with optimization enabled (with the -O3 compiler flag). This is
              * necessary, because otherwise loading the model will be very slow
             */
-            void importOBJModel (uint32_t modelInfoId) {
+            void loadOBJModel (uint32_t modelInfoId, ImportStaging& staging) {
                 auto modelInfo = getModelInfo (modelInfoId);
+                /* The err string contains errors and the warn string contains warnings that occurred while loading the
+                 * file, like a missing material definition. Loading only really failed if the load function returns
+                 * false.
+                 *
+                 * As mentioned before, faces in OBJ files can actually contain an arbitrary number of vertices, whereas
+                 * our application can only render triangles. Both loaders triangulate such faces
+                */
+                std::string warn, err;
+                auto& materials = staging.materials;
+#if ENABLE_NATIVE_OBJ_PARSER
+                bool isLoaded   = VKOBJParser::loadOBJ (modelInfo->path.model,
+                                                        modelInfo->path.mtlFileDir,
+                                                        staging.parsedData,
+                                                        warn, err);
+                for (auto const& parsedMaterial: staging.parsedData.materials) {
+                    tinyobj::material_t material;
+                    material.name            = parsedMaterial.name;
+                    material.diffuse_texname = parsedMaterial.diffuseTexturePath;
+                    materials.push_back (material);
+                }
+#else
                 /* The attrib container holds all of the positions, normals and texture coordinates in its
                  * attrib.vertices, attrib.normals, attrib.texcoords vectors
                 */
-                tinyobj::attrib_t attrib;
+                auto& attrib    = staging.attrib;
                 /* The shapes container contains all of the separate objects and their faces. Each face consists of an
                  * array of vertices, and each vertex contains the indices of the position, normal and texture coordinate
                  * attributes
                 */
-                std::vector <tinyobj::shape_t> shapes;
-                std::vector <tinyobj::material_t> materials;
-                /* The err string contains errors and the warn string contains warnings that occurred while loading the
-                 * file, like a missing material definition. Loading only really failed if the LoadObj function returns
-                 * false.
-                 *
-                 * As mentioned before, faces in OBJ files can actually contain an arbitrary number of vertices, whereas
-                 * our application can only render triangles. Luckily the LoadObj has an optional parameter to
-                 * automatically triangulate such faces, which is enabled by default
-                */
-                std::string warn, err;
-
-                if (!tinyobj::LoadObj (&attrib, &shapes, &materials,
-                                       &warn, &err,
-                                       modelInfo->path.model,
-                                       modelInfo->path.mtlFileDir)) {
-
+                auto& shapes    = staging.shapes;
+                bool isLoaded   = tinyobj::LoadObj (&attrib, &shapes, &materials,
+                                                    &warn, &err,
+                                                    modelInfo->path.model,
+                                                    modelInfo->path.mtlFileDir);
+#endif  // ENABLE_NATIVE_OBJ_PARSER
+                if (!isLoaded) {
                     LOG_ERROR (m_VKModelMgrLog) << "Failed to import model "
                                                 << "[" << modelInfoId << "]"
                                                 << " "
@@ -260,7 +463,27 @@ namespace Core {
                                                 << std::endl;
                     throw std::runtime_error ("Failed to import model");
                 }
+            }
+
+            void parseOBJModel (uint32_t modelInfoId, ImportStaging& staging) {
+                auto modelInfo   = getModelInfo (modelInfoId);
+                staging.isCached = false;
+#if ENABLE_MODEL_CACHE
+                /* The diffuse texture paths are stored in the cache file along with the vertices, so a cached model
+                 * needs neither its model file nor its .mtl files parsed
+                */
+                staging.sourceHash = getSourceHash (modelInfo->path.model, modelInfo->path.mtlFileDir);
+                if (readModelCache (modelInfo->path.model, staging.sourceHash, staging.cachedModel)) {
+                    for (auto const& path: staging.cachedModel.diffuseTextureImages)
+                        modelInfo->path.diffuseTextureImages.push_back (path);
+
+                    staging.isCached = true;
+                    return;
+                }
+#endif  // ENABLE_MODEL_CACHE
+                loadOBJModel (modelInfoId, staging);
 
+                auto const& materials = staging.materials;
                 if (materials.size() == 0) {
                     LOG_WARNING (m_VKModelMgrLog) << "Failed to find .mtl file "
                                                   << "[" << modelInfoId << "]"
@@ -284,30 +507,223 @@ namespace Core {
                                                           << std::endl;
                     }
                 }
-                /* Populate texture image pool, which contains all the textures used across models along with their
-                 * respective texture image info ids
-                */
+            }
+
+            /* Populate texture image pool, which contains all the textures used across models along with their respective
+             * texture image info ids. Ids are handed out in the order the textures are first seen, so this is always run
+             * one model at a time in the order of import
+            */
+            void mergeTextureImages (uint32_t modelInfoId) {
+                auto modelInfo = getModelInfo (modelInfoId);
                 for (auto const& path: modelInfo->path.diffuseTextureImages)
                     updateTextureImagePool (modelInfoId, path);
+            }
 
-                /* Map to take advantage of indices vector (index buffer). Note that, to be able to use std::unordered_map
-                 * with a user-defined key-type, you need to define two thing:
-                 * (1) A hash function; this must be a class that overrides operator() and calculates the hash value given
-                 * an object of the key-type. One particularly straight-forward way of doing this is to specialize the
-                 * std::hash template for your key-type
-                 *
-                 * (2) A comparison function for equality; this is required because the hash cannot rely on the fact that
-                 * the hash function will always provide a unique hash value for every distinct key (i.e., it needs to be
-                 * able to deal with collisions), so it needs a way to compare two given keys for an exact match. You can
-                 * implement this by overloading operator==() for your key type
+            /* The file order of the triangles rarely reuses the vertices still in the post transform cache, reorder them
+             * (and then the vertices) before the data is uploaded. Note that, the miss ratios are for the model on its
+             * own and do not account for the instances drawn with it
+            */
+            void optimizeMesh (uint32_t modelInfoId, std::vector <Vertex>& vertices, std::vector <uint32_t>& indices) {
+                auto statsBefore = VKMeshOptimizer::getCacheStats (indices, vertices.size());
+                VKMeshOptimizer::optimizeVertexCache (indices, vertices.size());
+                VKMeshOptimizer::optimizeVertexFetch (vertices, indices);
+                auto statsAfter  = VKMeshOptimizer::getCacheStats (indices, vertices.size());
+
+                LOG_INFO (m_VKModelMgrLog) << "Optimized mesh "
+                                           << "[" << modelInfoId << "]"
+                                           << " "
+                                           << "[ACMR " << statsBefore.acmr << "]"
+                                           << "->"
+                                           << "[ACMR " << statsAfter.acmr  << "]"
+                                           << " "
+                                           << "[ATVR " << statsBefore.atvr << "]"
+                                           << "->"
+                                           << "[ATVR " << statsAfter.atvr  << "]"
+                                           << std::endl;
+            }
+
+            /* Every level is simplified from the one before it, until a level no longer gets the index count down by at
+             * least 10% or the maximum number of levels is reached
+            */
+            void generateLODs (uint32_t modelInfoId) {
+                auto modelInfo = getModelInfo (modelInfoId);
+                std::vector <uint32_t> lodIndices;
+                std::vector <uint32_t> lodIndicesCounts;
+                std::vector <uint32_t> previousIndices (modelInfo->meta.indices.begin(), modelInfo->meta.indices.end());
+
+                for (uint32_t level = 1; level < g_coreSettings.maxLODsCount; level++) {
+                    size_t targetIndicesCount = static_cast <size_t> (previousIndices.size() *
+                                                                      g_coreSettings.lodIndicesRatio) / 3 * 3;
+                    float error               = 0.0f;
+                    auto indices              = VKMeshSimplifier::simplify (modelInfo->meta.vertices,
+                                                                            previousIndices,
+                                                                            targetIndicesCount,
+                                                                            g_coreSettings.lodMaxError,
+                                                                            &error);
+                    if (indices.size() * 10 > previousIndices.size() * 9)
+                        break;
+#if ENABLE_MESH_OPTIMIZATION
+                    VKMeshOptimizer::optimizeVertexCache (indices, modelInfo->meta.verticesCount);
+#endif  // ENABLE_MESH_OPTIMIZATION
+                    LOG_INFO (m_VKModelMgrLog) << "Generated LOD "
+                                               << "[" << modelInfoId << "]"
+                                               << " "
+                                               << "[" << level << "]"
+                                               << " "
+                                               << "[" << previousIndices.size() << "]"
+                                               << "->"
+                                               << "[" << indices.size() << "]"
+                                               << " "
+                                               << "[Error " << error << "]"
+                                               << std::endl;
+
+                    lodIndicesCounts.push_back (static_cast <uint32_t> (indices.size()));
+                    lodIndices.insert (lodIndices.end(), indices.begin(), indices.end());
+                    previousIndices = std::move (indices);
+                }
+                modelInfo->meta.lodIndicesStorage = std::move (lodIndices);
+                createLODs (modelInfoId, modelInfo->meta.lodIndicesStorage, lodIndicesCounts);
+            }
+
+            /* The clusters are cheap to build from the index data, so they are built on every import instead of being
+             * written to the model cache
+            */
+            void createMeshlets (uint32_t modelInfoId) {
+                auto modelInfo = getModelInfo (modelInfoId);
+                modelInfo->meta.meshlets = VKMeshlet::buildMeshlets (modelInfo->meta.vertices,
+                                                                     modelInfo->meta.indices,
+                                                                     g_coreSettings.maxMeshletVerticesCount,
+                                                                     g_coreSettings.maxMeshletTrianglesCount,
+                                                                     g_pipelineSettings.rasterization.frontFace ==
+                                                                     VK_FRONT_FACE_COUNTER_CLOCKWISE);
+            }
+
+            /* The texture image pool is only read from here, which lets models be built concurrently
+            */
+            void buildOBJModel (uint32_t modelInfoId, ImportStaging& staging) {
+                auto modelInfo = getModelInfo (modelInfoId);
+#if ENABLE_MODEL_CACHE
+                /* The texture image info ids are part of the vertex data, so the cached vertices are only valid if the
+                 * model's textures were given the same ids as when the cache file was written
                 */
-                std::unordered_map <Vertex, uint32_t> uniqueVertices;
+                uint64_t textureMappingHash = getTextureMappingHash (modelInfo->id.diffuseTextureImageInfos);
+                if (staging.isCached) {
+                    if (staging.cachedModel.textureMappingHash == textureMappingHash) {
+                        modelInfo->meta.vertices      = staging.cachedModel.vertices;
+                        modelInfo->meta.indices       = staging.cachedModel.indices;
+                        modelInfo->meta.verticesCount = static_cast <uint32_t> (modelInfo->meta.vertices.size());
+                        modelInfo->meta.indicesCount  = static_cast <uint32_t> (modelInfo->meta.indices.size());
+                        modelInfo->meta.cacheMapping  = staging.cachedModel.mapping;
+                        modelInfo->meta.bounds        = VKVertexCompact::getBoundingBox (modelInfo->meta.vertices);
+                        createLODs (modelInfoId, staging.cachedModel.lodIndices, staging.cachedModel.lodIndicesCounts);
+#if ENABLE_MESHLET_CULLING
+                        createMeshlets (modelInfoId);
+#endif  // ENABLE_MESHLET_CULLING
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                        for (uint32_t i = 0; i < modelInfo->meta.instancesCount; i++)
+                            createPositionDequant (modelInfoId, i);
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+
+                        LOG_INFO (m_VKModelMgrLog) << "Imported model from cache "
+                                                   << "[" << modelInfoId << "]"
+                                                   << " "
+                                                   << "[" << modelInfo->path.model << "]"
+                                                   << std::endl;
+                        return;
+                    }
+                    loadOBJModel (modelInfoId, staging);
+                }
+#endif  // ENABLE_MODEL_CACHE
+#if ENABLE_NATIVE_OBJ_PARSER
+                auto const& parsedData = staging.parsedData;
+                size_t indicesCount    = parsedData.corners.size();
+#else
+                auto const& attrib     = staging.attrib;
+                auto const& shapes     = staging.shapes;
+                size_t indicesCount    = 0;
+                for (auto const& shape: shapes)
+                    indicesCount += shape.mesh.indices.size();
+#endif  // ENABLE_NATIVE_OBJ_PARSER
+                /* Table to take advantage of indices vector (index buffer), sized up front from the number of indices in
+                 * the model's faces (an upper bound on the number of unique vertices)
+                */
+                VKVertexDedup uniqueVertices;
+                uniqueVertices.reset (indicesCount);
                 std::vector <Vertex>   vertices;
                 std::vector <uint32_t> indices;
+                indices.reserve (indicesCount);
                 auto defaultTexCoords = std::vector <glm::vec2> {
                     {0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 0.0f},
                     {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}
                 };
+                /* The default texture's uv mapping starts over with every shape
+                */
+                const uint32_t verticesPerQuad = 6;
+                uint32_t quadIndex             = 0;
+
+                auto addVertex = [&](Vertex& vertex, int32_t materialId) {
+                    /* We will handle missing texture faces (material_ids = -1) by adding +1 to all material_ids, this
+                     * will allow us to use the default texture whose image info id is 0. Note that, the local texture
+                     * id is an index into the current model's texture array embedded with in the model file. What we
+                     * need is an image info id that can be used to index into the global texture pool, so that the
+                     * shader can sample from the correct texture from the global pool of textures. The image info ids
+                     * were recorded in the same order as the model's texture array when merging into the pool
+                    */
+                    uint32_t localTexId = static_cast <uint32_t> (materialId + 1);
+                    vertex.texId        = modelInfo->id.diffuseTextureImageInfos[localTexId];
+                    /* Manual uv mapping of default texture
+                    */
+                    if (vertex.texId == 0) {
+                        vertex.texCoord = defaultTexCoords[quadIndex];
+                        quadIndex       == verticesPerQuad - 1 ? quadIndex = 0: quadIndex++;
+                    }
+                    /* To take advantage of the index buffer, we should keep only the unique vertices and use the
+                     * index buffer to reuse them whenever they come up. Every time we read a vertex from the OBJ
+                     * file, we check if we've already seen a vertex with the exact same attributes before. If not,
+                     * we add it to vertices array and store its index in the table. After that we add the index of
+                     * the new vertex to indices array
+                     *
+                     * If we've seen the exact same vertex before, then we look up its index in the table and store
+                     * that index in indices array
+                    */
+                    indices.push_back (uniqueVertices.getIndex (vertex, vertices));
+                };
+#if ENABLE_NATIVE_OBJ_PARSER
+                /* The parsed data is already triangulated, with the corners of every triangle one after the other and
+                 * with their attribute indices resolved. Attributes are looked up (and the texture coordinates flipped)
+                 * the same way as for the tinyobjloader output below
+                */
+                size_t shapeIdx = 0;
+                for (size_t triangleIdx = 0; triangleIdx < parsedData.materialIds.size(); triangleIdx++) {
+                    if (shapeIdx < parsedData.shapeFirstTriangles.size() &&
+                        parsedData.shapeFirstTriangles[shapeIdx] == triangleIdx) {
+                        quadIndex = 0;
+                        shapeIdx++;
+                    }
+                    for (size_t i = 0; i < 3; i++) {
+                        auto const& corner = parsedData.corners[triangleIdx * 3 + i];
+                        Vertex vertex {};
+                        vertex.pos = {
+                                        parsedData.positions[3 * corner.positionIdx + 0],
+                                        parsedData.positions[3 * corner.positionIdx + 1],
+                                        parsedData.positions[3 * corner.positionIdx + 2]
+                                     };
+                        if (corner.texCoordIdx >= 0)
+                            vertex.texCoord = {
+                                                       parsedData.texCoords[2 * corner.texCoordIdx + 0],
+                                                1.0f - parsedData.texCoords[2 * corner.texCoordIdx + 1]
+                                              };
+
+                        if (corner.normalIdx >= 0)
+                            vertex.normal   = {
+                                                parsedData.normals[3 * corner.normalIdx + 0],
+                                                parsedData.normals[3 * corner.normalIdx + 1],
+                                                parsedData.normals[3 * corner.normalIdx + 2]
+                                              };
+                        addVertex (vertex, parsedData.materialIds[triangleIdx]);
+                    }
+                }
+#else
                 /* Iterate overall all faces (may belong to different objects in a scene) and populate the vertex and
                  * index vectors
                 */
@@ -316,13 +732,12 @@ namespace Core {
                      * so we can now directly iterate over the vertices and dump them straight into our vertices vector
                     */
                     const uint32_t verticesPerFace = 3;
-                    const uint32_t verticesPerQuad = 6;
                     uint32_t faceIndex             = 0;
-                    uint32_t quadIndex             = 0;
                     uint32_t indexProcessedCount   = 0;
+                    quadIndex                      = 0;
 
                     for (auto const& index: shape.mesh.indices) {
-                        Vertex vertex;
+                        Vertex vertex {};
                         /* The index variable is of type tinyobj::index_t, which contains the vertex_index, normal_index
                          * and texcoord_index members. We need to use these indices to look up the actual vertex
                          * attributes in the attrib arrays. Unfortunately the attrib.vertices array is an array of float
@@ -361,35 +776,7 @@ namespace Core {
                                             attrib.normals[3 * index.normal_index + 1],
                                             attrib.normals[3 * index.normal_index + 2]
                                           };
-                        /* We will handle missing texture faces (material_ids = -1) by adding +1 to all material_ids, this
-                         * will allow us to use the default texture whose image info id is 0. Note that, the local texture
-                         * id is an index into the current model's texture array embedded with in the model file. What we
-                         * need is an image info id that can be used to index into the global texture pool, so that the
-                         * shader can sample from the correct texture from the global pool of textures
-                        */
-                        uint32_t localTexId     = shape.mesh.material_ids[faceIndex] + 1;
-                        std::string texturePath = modelInfo->path.diffuseTextureImages[localTexId];
-                        vertex.texId            = m_textureImagePool[texturePath];
-                        /* Manual uv mapping of default texture
-                        */
-                        if (vertex.texId == 0) {
-                            vertex.texCoord = defaultTexCoords[quadIndex];
-                            quadIndex       == verticesPerQuad - 1 ? quadIndex = 0: quadIndex++;
-                        }
-                        /* To take advantage of the index buffer, we should keep only the unique vertices and use the
-                         * index buffer to reuse them whenever they come up. Every time we read a vertex from the OBJ
-                         * file, we check if we've already seen a vertex with the exact same attributes before. If not,
-                         * we add it to vertices array and store its index in the map container. After that we add the
-                         * index of the new vertex to indices array
-                         *
-                         * If we've seen the exact same vertex before, then we look up its index in the map container and
-                         * store that index in indices array
-                        */
-                        if (uniqueVertices.count (vertex) == 0) {
-                            uniqueVertices[vertex] = static_cast <uint32_t> (vertices.size());
-                            vertices.push_back (vertex);
-                        }
-                        indices.push_back (uniqueVertices[vertex]);
+                        addVertex (vertex, shape.mesh.material_ids[faceIndex]);
                         /* Increment face index after we process a face (3 vertices make up a face)
                         */
                         indexProcessedCount++;
@@ -399,11 +786,109 @@ namespace Core {
                         }
                     }
                 }
-                createVertices (modelInfoId, vertices);
-                createIndices  (modelInfoId, indices);
+#endif  // ENABLE_NATIVE_OBJ_PARSER
+#if ENABLE_MESH_OPTIMIZATION
+                optimizeMesh (modelInfoId, vertices, indices);
+#endif  // ENABLE_MESH_OPTIMIZATION
+                createVertices (modelInfoId, std::move (vertices));
+                createIndices  (modelInfoId, std::move (indices));
+#if ENABLE_MESH_LOD
+                generateLODs   (modelInfoId);
+#endif  // ENABLE_MESH_LOD
+#if ENABLE_MESHLET_CULLING
+                createMeshlets (modelInfoId);
+#endif  // ENABLE_MESHLET_CULLING
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                /* Instances created ahead of the import were given the dequantization of an empty bounding box
+                */
+                for (uint32_t i = 0; i < modelInfo->meta.instancesCount; i++)
+                    createPositionDequant (modelInfoId, i);
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
                 dumpParsedData (modelInfoId);
+#if ENABLE_MODEL_CACHE
+                /* The default texture path is not read from the .mtl files, so it is left out of the cache file
+                */
+                std::vector <uint32_t> lodIndicesCounts;
+                for (size_t i = 1; i < modelInfo->meta.lods.size(); i++)
+                    lodIndicesCounts.push_back (modelInfo->meta.lods[i].indicesCount);
+
+                writeModelCache (modelInfo->path.model,
+                                 staging.sourceHash,
+                                 textureMappingHash,
+                                 std::span <const std::string> (modelInfo->path.diffuseTextureImages).subspan (1),
+                                 modelInfo->meta.vertices,
+                                 modelInfo->meta.indices,
+                                 modelInfo->meta.lodIndices,
+                                 lodIndicesCounts);
+#endif  // ENABLE_MODEL_CACHE
+            }
+
+            void importOBJModel (uint32_t modelInfoId) {
+                ImportStaging staging;
+                parseOBJModel      (modelInfoId, staging);
+                mergeTextureImages (modelInfoId);
+                buildOBJModel      (modelInfoId, staging);
+            }
+
+            /* Import again after the texture resources are created, without adding to the texture image pool. Textures
+             * that are not in the pool fall back to the default texture, since only the pool's textures have images. Safe
+             * to run off the main thread as long as the model info pool is not changed meanwhile
+            */
+            void reimportOBJModel (uint32_t modelInfoId) {
+                ImportStaging staging;
+                parseOBJModel      (modelInfoId, staging);
+                auto modelInfo = getModelInfo (modelInfoId);
+                for (auto const& path: modelInfo->path.diffuseTextureImages) {
+                    auto it = m_textureImagePool.find (path);
+                    if (it == m_textureImagePool.end()) {
+                        LOG_WARNING (m_VKModelMgrLog) << "Failed to find texture image in pool "
+                                                      << "[" << modelInfoId << "]"
+                                                      << " "
+                                                      << "[" << path << "]"
+                                                      << std::endl;
+                        it = m_textureImagePool.find (g_coreSettings.defaultDiffuseTexturePath);
+                    }
+                    modelInfo->id.diffuseTextureImageInfos.push_back (it->second);
+                }
+                buildOBJModel      (modelInfoId, staging);
+            }
+
+            /* Import several models on the worker pool. The import is split into three stages,
+             * (1) Parse, the model files are loaded (or mapped from the model cache) and their diffuse texture paths
+             *     collected, models in parallel
+             * (2) Merge, the texture paths are added to the texture image pool one model after the other in the given
+             *     order, so the texture image info ids are the same as if the models were imported one by one
+             * (3) Build, vertices are deduplicated and the vertex/index data is created, models in parallel
+             *
+             * The vertex and index data of each model is identical to that of importOBJModel
+            */
+            void importOBJModels (const std::vector <uint32_t>& modelInfoIds) {
+                std::vector <ImportStaging> stagings (modelInfoIds.size());
+
+                Worker::g_workerPool.parallelFor (modelInfoIds.size(), [&](size_t i) {
+                    parseOBJModel (modelInfoIds[i], stagings[i]);
+                });
+                for (auto const& infoId: modelInfoIds)
+                    mergeTextureImages (infoId);
+
+                Worker::g_workerPool.parallelFor (modelInfoIds.size(), [&](size_t i) {
+                    buildOBJModel (modelInfoIds[i], stagings[i]);
+                    stagings[i] = ImportStaging();
+                });
             }
 
+#if ENABLE_COMPACT_VERTEX_FORMAT
+            void createPositionDequant (uint32_t modelInfoId, uint32_t modelInstanceId) {
+                auto modelInfo       = getModelInfo (modelInfoId);
+                auto& staticInstance = modelInfo->meta.staticInstances[modelInstanceId];
+
+                staticInstance.positionOffset = glm::vec4 (modelInfo->meta.bounds.min, 0.0f);
+                staticInstance.positionScale  = glm::vec4 (VKVertexCompact::getPositionScale (modelInfo->meta.bounds),
+                                                           0.0f);
+                setStaticInstanceDirty (modelInfo, modelInstanceId);
+            }
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+
             std::unordered_map <std::string, uint32_t>& getTextureImagePool (void) {
                 return m_textureImagePool;
             }
@@ -433,15 +918,289 @@ namespace Core {
                 uint32_t readIdx   = oldTexId / 4;
                 uint32_t offsetIdx = oldTexId % 4;
                 uint32_t mask      = UINT8_MAX << offsetIdx * 8;
-                uint32_t packet    = modelInfo->meta.instances[modelInstanceId].texIdLUT[readIdx];
+                uint32_t packet    = modelInfo->meta.staticInstances[modelInstanceId].texIdLUT[readIdx];
                 uint32_t newTexId  = (packet & mask) >> offsetIdx * 8;
 
                 return newTexId;
             }
 
+            /* Give every model a slice of the instance arena, in the order of the model info ids. The model's instances
+             * are moved into its slice and stay there, at the same offset in the storage buffer. Models that have been
+             * given a slice before are moved to their new one. The static data of the instances is laid out the same
+             * way in the static instance arena
+            */
+            void readyInstanceArena (const std::vector <uint32_t>& modelInfoIds) {
+                size_t arenaInstancesCount = 0;
+                for (auto const& infoId: modelInfoIds)
+                    arenaInstancesCount += getModelInfo (infoId)->meta.instances.size();
+                /* Moving the vectors afterwards keeps the spans into them valid
+                */
+                std::vector <InstanceDataSSBO> instanceArena (arenaInstancesCount);
+                std::vector <StaticInstanceDataSSBO> staticInstanceArena (arenaInstancesCount);
+                uint32_t firstArenaInstance = 0;
+                for (auto const& infoId: modelInfoIds) {
+                    auto modelInfo        = getModelInfo (infoId);
+                    auto& meta            = modelInfo->meta;
+                    size_t instancesCount = meta.instances.size();
+                    std::copy (meta.instances.begin(),       meta.instances.end(),
+                               instanceArena.begin()       + firstArenaInstance);
+                    std::copy (meta.staticInstances.begin(), meta.staticInstances.end(),
+                               staticInstanceArena.begin() + firstArenaInstance);
+
+                    meta.instances              = std::span <InstanceDataSSBO> (instanceArena).subspan (
+                                                  firstArenaInstance, instancesCount);
+                    meta.staticInstances        = std::span <StaticInstanceDataSSBO> (staticInstanceArena).subspan (
+                                                  firstArenaInstance, instancesCount);
+                    meta.firstArenaInstance     = firstArenaInstance;
+                    meta.instancesStorage       = std::vector <InstanceDataSSBO>();
+                    meta.staticInstancesStorage = std::vector <StaticInstanceDataSSBO>();
+                    for (uint32_t i = 0; i < instancesCount; i++)
+                        meta.instances[i].staticDataIdx = firstArenaInstance + i;
+
+                    meta.drawOrder.resize (instancesCount);
+                    std::iota (meta.drawOrder.begin(), meta.drawOrder.end(), 0);
+                    setInstancesDirty       (modelInfo);
+                    setStaticInstancesDirty (modelInfo);
+                    firstArenaInstance         += static_cast <uint32_t> (instancesCount);
+                }
+                m_instanceArena       = std::move (instanceArena);
+                m_staticInstanceArena = std::move (staticInstanceArena);
+            }
+
+            size_t getInstanceArenaSize (void) {
+                return m_instanceArena.size();
+            }
+
+            /* Write the instances of the given models to mapped (the mapped storage buffer), every model to its slice
+             * in the order of its draw order. With a tracker, only the slots that the tracker's frame in flight needs
+             * written are. The writes go front to back, and runs of slots whose instances are next to each other in
+             * the arena are written with one copy, since mapped memory is usually write combined (and never read from
+             * here). Returns the number of bytes written
+            */
+            uint64_t writeInstances (const std::vector <uint32_t>& modelInfoIds,
+                                     void* mapped,
+                                     InstanceSlotTracker* tracker = nullptr) {
+
+                readyInstanceSlotTracker (tracker, m_instanceArena.size());
+                auto dstInstances = static_cast <InstanceDataSSBO*> (mapped);
+                uint64_t bytes    = 0;
+
+                for (auto const& infoId: modelInfoIds) {
+                    auto modelInfo   = getModelInfo (infoId);
+                    auto const& meta = modelInfo->meta;
+                    if (meta.firstArenaInstance == UINT32_MAX) {
+                        LOG_ERROR (m_VKModelMgrLog) << "Model has no instance arena slice "
+                                                    << "[" << infoId << "]"
+                                                    << std::endl;
+                        throw std::runtime_error ("Model has no instance arena slice");
+                    }
+                    /* Run of slots [runFirstSlot, runFirstSlot + runSlotsCount) to be copied from runSrc
+                    */
+                    size_t runFirstSlot  = 0;
+                    size_t runSlotsCount = 0;
+                    const InstanceDataSSBO* runSrc = nullptr;
+                    auto writeRun = [&](void) {
+                        if (runSlotsCount == 0)
+                            return;
+                        memcpy (dstInstances + runFirstSlot, runSrc, runSlotsCount * sizeof (InstanceDataSSBO));
+                        bytes        += runSlotsCount * sizeof (InstanceDataSSBO);
+                        runSlotsCount = 0;
+                    };
+
+                    for (uint32_t i = 0; i < meta.instancesCount; i++) {
+                        size_t slot              = meta.firstArenaInstance + i;
+                        uint32_t modelInstanceId = meta.drawOrder[i];
+                        if (!trackInstanceSlot (tracker, slot, infoId, modelInfo, modelInstanceId)) {
+                            writeRun();
+                            continue;
+                        }
+
+                        const InstanceDataSSBO* src = &meta.instances[modelInstanceId];
+                        if (runSlotsCount != 0 && src != runSrc + runSlotsCount)
+                            writeRun();
+                        if (runSlotsCount == 0) {
+                            runFirstSlot = slot;
+                            runSrc       = src;
+                        }
+                        runSlotsCount++;
+                    }
+                    writeRun();
+                }
+                return bytes;
+            }
+
+            /* Write the static data of the instances of the given models that has changed to mapped (the mapped
+             * staging buffer, laid out like the static instance data buffer), and add a region to copy from it to the
+             * static instance data buffer for every run of consecutive changed instances. Returns the number of bytes
+             * written
+            */
+            uint64_t writeStaticInstances (const std::vector <uint32_t>& modelInfoIds,
+                                           void* mapped,
+                                           std::vector <VkBufferCopy>& copyRegions) {
+
+                auto dstStaticInstances = static_cast <StaticInstanceDataSSBO*> (mapped);
+                uint64_t bytes          = 0;
+                for (auto const& infoId: modelInfoIds) {
+                    auto modelInfo = getModelInfo (infoId);
+                    auto& meta     = modelInfo->meta;
+                    if (meta.firstArenaInstance == UINT32_MAX) {
+                        LOG_ERROR (m_VKModelMgrLog) << "Model has no instance arena slice "
+                                                    << "[" << infoId << "]"
+                                                    << std::endl;
+                        throw std::runtime_error ("Model has no instance arena slice");
+                    }
+
+                    auto& flags = meta.staticInstanceDirtyFlags;
+                    if (flags.size() < meta.staticInstances.size())
+                        flags.resize (meta.staticInstances.size(), 1);
+                    for (uint32_t firstInstanceId = 0; firstInstanceId < meta.instancesCount;) {
+                        if (flags[firstInstanceId] == 0) {
+                            firstInstanceId++;
+                            continue;
+                        }
+                        uint32_t lastInstanceId = firstInstanceId;
+                        while (lastInstanceId < meta.instancesCount && flags[lastInstanceId] != 0)
+                            flags[lastInstanceId++] = 0;
+
+                        size_t firstSlot = meta.firstArenaInstance + firstInstanceId;
+                        size_t size      = (lastInstanceId - firstInstanceId) * sizeof (StaticInstanceDataSSBO);
+                        memcpy (dstStaticInstances + firstSlot, &meta.staticInstances[firstInstanceId], size);
+
+                        VkBufferCopy copyRegion;
+                        copyRegion.srcOffset = firstSlot * sizeof (StaticInstanceDataSSBO);
+                        copyRegion.dstOffset = firstSlot * sizeof (StaticInstanceDataSSBO);
+                        copyRegion.size      = size;
+                        copyRegions.push_back (copyRegion);
+
+                        bytes          += size;
+                        firstInstanceId = lastInstanceId;
+                    }
+                }
+                return bytes;
+            }
+
+#if ENABLE_MESH_LOD
+            /* Order the instances of every given model by the level of detail they are drawn at, into the model's draw
+             * order. The level of an instance is picked from the distance of the camera to the center of its bounding
+             * box, against the radius of its bounding sphere (scaled with the instance)
+            */
+            void orderInstancesByLOD (const std::vector <uint32_t>& modelInfoIds, const glm::vec3& cameraPosition) {
+                std::vector <uint32_t> instanceLevels;
+                std::vector <uint32_t> levelOffsets;
+                for (auto const& infoId: modelInfoIds) {
+                    auto modelInfo    = getModelInfo (infoId);
+                    auto& meta        = modelInfo->meta;
+                    glm::vec3 center  = (meta.bounds.min + meta.bounds.max) * 0.5f;
+                    float radius      = glm::length (meta.bounds.max - meta.bounds.min) * 0.5f;
+                    /* A model that has not been imported has no levels, its instances are all put at level 0
+                    */
+                    uint32_t maxLevel = meta.lods.empty() ? 0: static_cast <uint32_t> (meta.lods.size()) - 1;
+
+                    meta.lodInstancesCounts.assign (maxLevel + 1, 0);
+                    instanceLevels.resize (meta.instancesCount);
+                    for (uint32_t i = 0; i < meta.instancesCount; i++) {
+                        auto const& modelMatrix = meta.modelMatrices[i];
+                        float scale             = std::max ({glm::length (glm::vec3 (modelMatrix[0])),
+                                                             glm::length (glm::vec3 (modelMatrix[1])),
+                                                             glm::length (glm::vec3 (modelMatrix[2]))});
+                        float distance          = glm::distance (glm::vec3 (modelMatrix * glm::vec4 (center, 1.0f)),
+                                                                 cameraPosition);
+                        float threshold         = g_coreSettings.lodDistanceFactor * radius * scale;
+                        uint32_t level          = 0;
+                        while (level < maxLevel && distance > threshold) {
+                            level++;
+                            threshold *= 2.0f;
+                        }
+                        instanceLevels[i] = level;
+                        meta.lodInstancesCounts[level]++;
+                    }
+
+                    levelOffsets.assign (maxLevel + 1, 0);
+                    for (uint32_t level = 1; level <= maxLevel; level++)
+                        levelOffsets[level] = levelOffsets[level - 1] + meta.lodInstancesCounts[level - 1];
+                    meta.drawOrder.resize (meta.instancesCount);
+                    for (uint32_t i = 0; i < meta.instancesCount; i++)
+                        meta.drawOrder[levelOffsets[instanceLevels[i]]++] = i;
+                }
+            }
+#endif  // ENABLE_MESH_LOD
+
+#if ENABLE_MESHLET_CULLING
+            /* Draws of the clusters of every instance that are visible, for the first instancesCount instances in the
+             * model's draw order (the ones drawn at full detail). An instance outside the view frustum draws nothing,
+             * consecutive instances that draw the same single range share one draw
+             *
+             * The normal cones are tested against the camera position in the model space of the instance, which holds
+             * for rotations, translations and uniform scales
+            */
+            void cullMeshlets (uint32_t modelInfoId,
+                               uint32_t instancesCount,
+                               const VKMeshlet::Frustum& frustum,
+                               const glm::vec3& cameraPosition,
+                               std::vector <MeshletDraw>& draws) {
+
+                auto modelInfo      = getModelInfo (modelInfoId);
+                auto const& meta    = modelInfo->meta;
+                glm::vec3 center    = (meta.bounds.min + meta.bounds.max) * 0.5f;
+                float radius        = glm::length (meta.bounds.max - meta.bounds.min) * 0.5f;
+                bool isBackFaceCull = (g_pipelineSettings.rasterization.cullMode & VK_CULL_MODE_BACK_BIT) != 0;
+                size_t firstCallDrawIdx = draws.size();
+                uint32_t firstInstance  = meta.firstArenaInstance;
+
+                for (uint32_t i = 0; i < instancesCount; i++) {
+                    auto const& modelMatrix = meta.modelMatrices[meta.drawOrder[i]];
+                    float scale             = std::max ({glm::length (glm::vec3 (modelMatrix[0])),
+                                                         glm::length (glm::vec3 (modelMatrix[1])),
+                                                         glm::length (glm::vec3 (modelMatrix[2]))});
+                    if (!VKMeshlet::isSphereVisible (frustum,
+                                                     glm::vec3 (modelMatrix * glm::vec4 (center, 1.0f)),
+                                                     radius * scale))
+                        continue;
+
+                    size_t firstDrawIdx = draws.size();
+                    if (meta.meshlets.size() <= 1)
+                        draws.push_back ({0, meta.indicesCount, firstInstance + i, 1});
+                    else {
+                        glm::vec3 modelCameraPosition = glm::vec3 (glm::inverse (modelMatrix) *
+                                                                   glm::vec4 (cameraPosition, 1.0f));
+                        for (auto const& meshlet: meta.meshlets) {
+                            if (!VKMeshlet::isSphereVisible (frustum,
+                                                             glm::vec3 (modelMatrix * glm::vec4 (meshlet.center, 1.0f)),
+                                                             meshlet.radius * scale))
+                                continue;
+                            if (isBackFaceCull && VKMeshlet::isBackFacing (meshlet, modelCameraPosition))
+                                continue;
+                            /* Clusters next to each other in the index data are drawn as one range
+                            */
+                            if (draws.size() > firstDrawIdx &&
+                                draws.back().firstIndex + draws.back().indicesCount == meshlet.firstIndex)
+                                draws.back().indicesCount += meshlet.indicesCount;
+                            else
+                                draws.push_back ({meshlet.firstIndex, meshlet.indicesCount, firstInstance + i, 1});
+                        }
+                    }
+                    /* Same single range as the instance before it
+                    */
+                    if (draws.size() == firstDrawIdx + 1 && firstDrawIdx > firstCallDrawIdx) {
+                        auto& previous = draws[firstDrawIdx - 1];
+                        auto& current  = draws[firstDrawIdx];
+                        if (previous.firstIndex    == current.firstIndex   &&
+                            previous.indicesCount  == current.indicesCount &&
+                            previous.firstInstance + previous.instancesCount == current.firstInstance) {
+                            previous.instancesCount++;
+                            draws.pop_back();
+                        }
+                    }
+                }
+            }
+#endif  // ENABLE_MESHLET_CULLING
+
+            /* Lookup only (no operator[]), model infos are fetched concurrently during import
+            */
             ModelInfo* getModelInfo (uint32_t modelInfoId) {
-                if (m_modelInfoPool.find (modelInfoId) != m_modelInfoPool.end())
-                    return &m_modelInfoPool[modelInfoId];
+                auto it = m_modelInfoPool.find (modelInfoId);
+                if (it != m_modelInfoPool.end())
+                    return &it->second;
 
                 LOG_ERROR (m_VKModelMgrLog) << "Failed to find model info "
                                             << "[" << modelInfoId << "]"
@@ -459,7 +1218,7 @@ namespace Core {
                                                << std::endl;
 
                     uint32_t modelInstanceId = 0;
-                    for (auto const& instance: val.meta.instances) {
+                    for (auto const& modelMatrix: val.meta.modelMatrices) {
                         LOG_INFO (m_VKModelMgrLog) << "Model instance id "
                                                    << "[" << modelInstanceId << "]"
                                                    << std::endl;
@@ -469,10 +1228,10 @@ namespace Core {
                         uint32_t rowIdx = 0;
                         while (rowIdx < 4) {
                             LOG_INFO (m_VKModelMgrLog) << "["
-                                                       << instance.modelMatrix[rowIdx][0] << " "
-                                                       << instance.modelMatrix[rowIdx][1] << " "
-                                                       << instance.modelMatrix[rowIdx][2] << " "
-                                                       << instance.modelMatrix[rowIdx][3]
+                                                       << modelMatrix[rowIdx][0] << " "
+                                                       << modelMatrix[rowIdx][1] << " "
+                                                       << modelMatrix[rowIdx][2] << " "
+                                                       << modelMatrix[rowIdx][3]
                                                        << "]"
                                                        << std::endl;
                             rowIdx++;
@@ -548,6 +1307,40 @@ namespace Core {
                                                << "[" << val.meta.indicesCount << "]"
                                                << std::endl;
 
+                    LOG_INFO (m_VKModelMgrLog) << "Bounds "
+                                               << "[" << val.meta.bounds.min.x << ", "
+                                                      << val.meta.bounds.min.y << ", "
+                                                      << val.meta.bounds.min.z
+                                               << "]"
+                                               << "->"
+                                               << "[" << val.meta.bounds.max.x << ", "
+                                                      << val.meta.bounds.max.y << ", "
+                                                      << val.meta.bounds.max.z
+                                               << "]"
+                                               << std::endl;
+                    LOG_INFO (m_VKModelMgrLog) << "Vertex offset "
+                                               << "[" << val.meta.vertexOffset << "]"
+                                               << std::endl;
+
+                    LOG_INFO (m_VKModelMgrLog) << "Index segment "
+                                               << "[" << (val.meta.indexSegment.indexType == VK_INDEX_TYPE_UINT16 ?
+                                                          "UINT16": "UINT32") << "]"
+                                               << " "
+                                               << "[" << val.meta.indexSegment.offset << "]"
+                                               << std::endl;
+
+                    LOG_INFO (m_VKModelMgrLog) << "Meshlets count "
+                                               << "[" << val.meta.meshlets.size() << "]"
+                                               << std::endl;
+
+                    LOG_INFO (m_VKModelMgrLog) << "LODs"
+                                               << std::endl;
+                    for (auto const& lod: val.meta.lods)
+                    LOG_INFO (m_VKModelMgrLog) << "[" << lod.firstIndex << "]"
+                                               << " "
+                                               << "[" << lod.indicesCount << "]"
+                                               << std::endl;
+
                     LOG_INFO (m_VKModelMgrLog) << "Instances count "
                                                << "[" << val.meta.instancesCount << "]"
                                                << std::endl;
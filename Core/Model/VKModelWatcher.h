@@ -0,0 +1,165 @@
+#ifndef VK_MODEL_WATCHER_H
+#define VK_MODEL_WATCHER_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+#if defined (__linux__)
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif  // __linux__
+#include "../VKConfig.h"
+#include "../../Collection/Log/Log.h"
+
+using namespace Collection;
+
+namespace Core {
+    /* Watches the model and .mtl files under a directory from a thread of its own, and collects the paths of the files
+     * that were written to. Files are reported once they are closed after writing or moved into place, which is how
+     * most tools save them
+     * (1) Linux, inotify watches on the directory and its sub directories at the time the watcher is started
+     * (2) Elsewhere, the last write times of the files are polled at the same interval
+    */
+    class VKModelWatcher {
+        private:
+            std::thread m_watchThread;
+            std::atomic <bool> m_isWatching;
+            std::mutex m_changedPathsMutex;
+            std::vector <std::string> m_changedPaths;
+
+            Log::Record* m_VKModelWatcherLog;
+            const uint32_t m_instanceId = g_collectionSettings.instanceId++;
+
+            static bool isWatchedFile (const std::filesystem::path& path) {
+                return path.extension() == ".obj" || path.extension() == ".mtl";
+            }
+
+            void addChangedPath (const std::filesystem::path& path) {
+                std::lock_guard <std::mutex> lock (m_changedPathsMutex);
+                auto normalPath = path.lexically_normal().string();
+                if (std::find (m_changedPaths.begin(), m_changedPaths.end(), normalPath) == m_changedPaths.end())
+                    m_changedPaths.push_back (normalPath);
+            }
+
+#if defined (__linux__)
+            void watchDirectory (std::string dirPath) {
+                int fd = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+                if (fd < 0) {
+                    LOG_WARNING (m_VKModelWatcherLog) << "Failed to init inotify "
+                                                      << "[" << dirPath << "]"
+                                                      << std::endl;
+                    return;
+                }
+                /* Watch descriptors and the directories they were added for, inotify events only carry the name of the
+                 * file within the directory
+                */
+                std::unordered_map <int, std::filesystem::path> watchedDirPaths;
+                auto addWatch = [&](const std::filesystem::path& path) {
+                    int wd = inotify_add_watch (fd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+                    if (wd >= 0)
+                        watchedDirPaths[wd] = path;
+                };
+                std::error_code errorCode;
+                addWatch (dirPath);
+                for (auto const& entry: std::filesystem::recursive_directory_iterator (dirPath, errorCode)) {
+                    if (entry.is_directory())
+                        addWatch (entry.path());
+                }
+                /* The events are aligned to the inotify_event struct, and a single read returns as many as fit
+                */
+                alignas (inotify_event) char events[4096];
+                pollfd pollFd = {fd, POLLIN, 0};
+
+                while (m_isWatching) {
+                    if (poll (&pollFd, 1, static_cast <int> (g_coreSettings.modelWatchIntervalMs)) <= 0)
+                        continue;
+
+                    ssize_t length;
+                    while ((length = read (fd, events, sizeof (events))) > 0) {
+                        for (char* ptr = events; ptr < events + length;) {
+                            auto event = reinterpret_cast <const inotify_event*> (ptr);
+                            ptr       += sizeof (inotify_event) + event->len;
+
+                            if (event->len == 0 || watchedDirPaths.find (event->wd) == watchedDirPaths.end())
+                                continue;
+                            auto path  = watchedDirPaths[event->wd] / event->name;
+                            if (isWatchedFile (path))
+                                addChangedPath (path);
+                        }
+                    }
+                }
+                close (fd);
+            }
+#else
+            void watchDirectory (std::string dirPath) {
+                std::unordered_map <std::string, std::filesystem::file_time_type> writeTimes;
+                auto scan = [&](bool isFirstScan) {
+                    std::error_code errorCode;
+                    for (auto const& entry: std::filesystem::recursive_directory_iterator (dirPath, errorCode)) {
+                        if (!entry.is_regular_file() || !isWatchedFile (entry.path()))
+                            continue;
+
+                        auto writeTime = entry.last_write_time (errorCode);
+                        auto& lastTime = writeTimes[entry.path().string()];
+                        if (!isFirstScan && lastTime != writeTime)
+                            addChangedPath (entry.path());
+                        lastTime = writeTime;
+                    }
+                };
+
+                scan (true);
+                while (m_isWatching) {
+                    std::this_thread::sleep_for (std::chrono::milliseconds (g_coreSettings.modelWatchIntervalMs));
+                    scan (false);
+                }
+            }
+#endif  // __linux__
+
+        public:
+            VKModelWatcher (void) {
+                m_isWatching        = false;
+                m_VKModelWatcherLog = LOG_INIT (m_instanceId, g_collectionSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_IMMEDIATE);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+            }
+
+            ~VKModelWatcher (void) {
+                stopModelWatcher();
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            void startModelWatcher (const char* dirPath) {
+                if (m_isWatching)
+                    return;
+
+                m_isWatching  = true;
+                m_watchThread = std::thread (&VKModelWatcher::watchDirectory, this, std::string (dirPath));
+                LOG_INFO (m_VKModelWatcherLog) << "Started model watcher "
+                                               << "[" << dirPath << "]"
+                                               << std::endl;
+            }
+
+            void stopModelWatcher (void) {
+                m_isWatching = false;
+                if (m_watchThread.joinable())
+                    m_watchThread.join();
+            }
+
+            /* Paths (lexically normal) of the files written to since the last call
+            */
+            std::vector <std::string> getChangedModelFiles (void) {
+                std::lock_guard <std::mutex> lock (m_changedPathsMutex);
+                return std::exchange (m_changedPaths, {});
+            }
+    };
+}   // namespace Core
+#endif  // VK_MODEL_WATCHER_H
\ No newline at end of file
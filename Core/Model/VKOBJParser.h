@@ -0,0 +1,737 @@
+#ifndef VK_OBJ_PARSER_H
+#define VK_OBJ_PARSER_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <charconv>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../../Collection/Worker/WorkerPool.h"
+
+namespace Core {
+    struct OBJMaterial {
+        std::string name;
+        std::string diffuseTexturePath;
+    };
+
+    /* Attribute indices of a face corner, resolved to 0 based indices into the attribute arrays. The texture coordinate
+     * and normal indices are -1 if the face does not reference them
+    */
+    struct OBJCorner {
+        int32_t positionIdx;
+        int32_t texCoordIdx;
+        int32_t normalIdx;
+    };
+
+    struct OBJParsedData {
+        std::vector <float> positions;
+        std::vector <float> texCoords;
+        std::vector <float> normals;
+        /* Every face is triangulated, so there are 3 corners and 1 material id per triangle. The material id indexes
+         * into the materials vector and is -1 for faces without a (known) material
+        */
+        std::vector <OBJCorner> corners;
+        std::vector <int32_t>   materialIds;
+        /* Index of the first triangle of every object/group ('o' and 'g' lines) after the first one
+        */
+        std::vector <size_t>    shapeFirstTriangles;
+        std::vector <OBJMaterial> materials;
+    };
+
+    /* Engine side OBJ reader. The model file is mapped and split into line aligned chunks which are parsed on the worker
+     * pool, every chunk collects its own attributes and faces. The face indices of a chunk can only be resolved once the
+     * number of attributes in the chunks before it is known, so a second (also parallel) pass resolves and triangulates
+     * the faces into one triangle list
+     *
+     * The output follows what LoadObj (with triangulation enabled) would give,
+     * (1) Triangles are kept as is, quads are split along their shorter diagonal and larger polygons are ear clipped
+     *     (see clipEars)
+     * (2) Faces with less than 3 corners are dropped
+     * (3) The material of a face is the one named by the last usemtl line before it, materials are looked up among all
+     *     the .mtl files of the model (the first file that can be read on an mtllib line)
+    */
+    class VKOBJParser {
+        private:
+            /* Chunks smaller than this are not worth handing to another thread
+            */
+            static constexpr size_t  MIN_CHUNK_SIZE        = 64 * 1024;
+            static constexpr size_t  MAX_CHUNKS_PER_THREAD = 4;
+            static constexpr int32_t MISSING_IDX           = INT32_MIN;
+            /* Bits of RawCorner::relative, set if the index was negative (relative to the end of the attribute array at
+             * that line) in which case it was stored relative to the start of the chunk
+            */
+            static constexpr uint8_t RELATIVE_POSITION     = 1 << 0;
+            static constexpr uint8_t RELATIVE_TEXCOORD     = 1 << 1;
+            static constexpr uint8_t RELATIVE_NORMAL       = 1 << 2;
+
+            struct RawCorner {
+                int32_t positionIdx;
+                int32_t texCoordIdx;
+                int32_t normalIdx;
+                uint8_t relative;
+            };
+
+            struct Chunk {
+                const char* begin;
+                const char* end;
+
+                std::vector <float> positions;
+                std::vector <float> texCoords;
+                std::vector <float> normals;
+
+                std::vector <RawCorner> corners;
+                std::vector <uint32_t>  faceSizes;
+                /* Index into usemtlNames for every face, -1 if the face uses the material carried over from the chunks
+                 * before this one
+                */
+                std::vector <int32_t>   faceMaterialRefs;
+                /* Number of triangles in the chunk ahead of every 'o'/'g' line, counting faces as corners - 2 triangles
+                 * until the chunk is resolved (see resolveChunk)
+                */
+                std::vector <size_t>    shapeFirstTriangles;
+                std::vector <std::string> usemtlNames;
+                std::vector <std::vector <std::string>> mtllibNames;
+                size_t trianglesCount;
+                /* Triangles written by resolveChunk, fewer than trianglesCount if a face could not be ear clipped
+                */
+                size_t resolvedTrianglesCount;
+                /* Filled in between the two passes
+                */
+                size_t positionsBase;
+                size_t texCoordsBase;
+                size_t normalsBase;
+                size_t trianglesBase;
+                int32_t startMaterialId;
+                std::vector <int32_t> usemtlIds;
+
+                std::string error;
+            };
+
+            static bool isSpace (char c) {
+                return c == ' ' || c == '\t';
+            }
+
+            static const char* skipSpaces (const char* p, const char* end) {
+                while (p < end && isSpace (*p))
+                    p++;
+                return p;
+            }
+
+            static const char* skipToken (const char* p, const char* end) {
+                while (p < end && !isSpace (*p))
+                    p++;
+                return p;
+            }
+
+            /* Values are parsed as double and narrowed to float, which is what LoadObj does too. A missing value is read
+             * as 0
+            */
+            static const char* parseFloat (const char* p, const char* end, float& value) {
+                p = skipSpaces (p, end);
+                if (p < end && *p == '+')
+                    p++;
+
+                double parsed = 0.0;
+                auto result   = std::from_chars (p, end, parsed);
+                if (result.ec != std::errc()) {
+                    value = 0.0f;
+                    return skipToken (p, end);
+                }
+                value = static_cast <float> (parsed);
+                return result.ptr;
+            }
+
+            static const char* parseIndex (const char* p, const char* end, int32_t& value) {
+                auto result = std::from_chars (p, end, value);
+                if (result.ec != std::errc()) {
+                    value = 0;
+                    return p;
+                }
+                return result.ptr;
+            }
+
+            /* An OBJ index is 1 based if positive and relative to the number of attributes read so far if negative, 0
+             * is not a valid index
+            */
+            static bool getRawIndex (int32_t index,
+                                     size_t localCount,
+                                     uint8_t relativeBit,
+                                     int32_t& rawIdx,
+                                     uint8_t& relative) {
+                if (index > 0) {
+                    rawIdx = index - 1;
+                    return true;
+                }
+                if (index < 0) {
+                    rawIdx    = static_cast <int32_t> (localCount) + index;
+                    relative |= relativeBit;
+                    return true;
+                }
+                return false;
+            }
+
+            static std::string getName (const char* p, const char* end) {
+                p = skipSpaces (p, end);
+                while (end > p && isSpace (end[-1]))
+                    end--;
+                return std::string (p, end);
+            }
+
+            static bool parseFace (const char* p, const char* end, Chunk& chunk) {
+                uint32_t faceSize = 0;
+                while (true) {
+                    p = skipSpaces (p, end);
+                    if (p == end)
+                        break;
+
+                    RawCorner corner {MISSING_IDX, MISSING_IDX, MISSING_IDX, 0};
+                    int32_t index;
+                    p = parseIndex (p, end, index);
+                    if (!getRawIndex (index, chunk.positions.size() / 3, RELATIVE_POSITION,
+                                      corner.positionIdx, corner.relative))
+                        return false;
+
+                    if (p < end && *p == '/') {
+                        p++;
+                        if (p < end && *p != '/') {
+                            p = parseIndex (p, end, index);
+                            if (!getRawIndex (index, chunk.texCoords.size() / 2, RELATIVE_TEXCOORD,
+                                              corner.texCoordIdx, corner.relative))
+                                return false;
+                        }
+                        if (p < end && *p == '/') {
+                            p++;
+                            p = parseIndex (p, end, index);
+                            if (!getRawIndex (index, chunk.normals.size() / 3, RELATIVE_NORMAL,
+                                              corner.normalIdx, corner.relative))
+                                return false;
+                        }
+                    }
+                    if (p < end && !isSpace (*p))
+                        return false;
+
+                    chunk.corners.push_back (corner);
+                    faceSize++;
+                }
+
+                if (faceSize < 3) {
+                    chunk.corners.resize (chunk.corners.size() - faceSize);
+                    return true;
+                }
+                chunk.faceSizes.push_back        (faceSize);
+                chunk.faceMaterialRefs.push_back (chunk.usemtlNames.empty() ? -1:
+                                                  static_cast <int32_t> (chunk.usemtlNames.size() - 1));
+                chunk.trianglesCount += faceSize - 2;
+                return true;
+            }
+
+            static bool parseLine (const char* p, const char* end, Chunk& chunk) {
+                if (end > p && end[-1] == '\r')
+                    end--;
+                p = skipSpaces (p, end);
+                if (p == end || *p == '#')
+                    return true;
+
+                const char* tokenEnd = skipToken (p, end);
+                size_t tokenSize     = static_cast <size_t> (tokenEnd - p);
+
+                if (tokenSize == 1 && p[0] == 'v') {
+                    float x, y, z;
+                    tokenEnd = parseFloat (tokenEnd, end, x);
+                    tokenEnd = parseFloat (tokenEnd, end, y);
+                    parseFloat (tokenEnd, end, z);
+                    chunk.positions.insert (chunk.positions.end(), {x, y, z});
+                }
+                else if (tokenSize == 2 && p[0] == 'v' && p[1] == 't') {
+                    float u, v;
+                    tokenEnd = parseFloat (tokenEnd, end, u);
+                    parseFloat (tokenEnd, end, v);
+                    chunk.texCoords.insert (chunk.texCoords.end(), {u, v});
+                }
+                else if (tokenSize == 2 && p[0] == 'v' && p[1] == 'n') {
+                    float x, y, z;
+                    tokenEnd = parseFloat (tokenEnd, end, x);
+                    tokenEnd = parseFloat (tokenEnd, end, y);
+                    parseFloat (tokenEnd, end, z);
+                    chunk.normals.insert (chunk.normals.end(), {x, y, z});
+                }
+                else if (tokenSize == 1 && p[0] == 'f')
+                    return parseFace (tokenEnd, end, chunk);
+
+                else if (tokenSize == 1 && (p[0] == 'o' || p[0] == 'g'))
+                    chunk.shapeFirstTriangles.push_back (chunk.trianglesCount);
+
+                else if (tokenSize == 6 && memcmp (p, "usemtl", 6) == 0)
+                    chunk.usemtlNames.push_back (getName (tokenEnd, end));
+
+                else if (tokenSize == 6 && memcmp (p, "mtllib", 6) == 0) {
+                    std::vector <std::string> names;
+                    while (true) {
+                        tokenEnd = skipSpaces (tokenEnd, end);
+                        if (tokenEnd == end)
+                            break;
+                        const char* nameEnd = skipToken (tokenEnd, end);
+                        names.emplace_back (tokenEnd, nameEnd);
+                        tokenEnd = nameEnd;
+                    }
+                    chunk.mtllibNames.push_back (names);
+                }
+                return true;
+            }
+
+            static void parseChunk (Chunk& chunk) {
+                chunk.trianglesCount = 0;
+                const char* p        = chunk.begin;
+                while (p < chunk.end) {
+                    auto lineEnd = static_cast <const char*> (memchr (p, '\n', static_cast <size_t> (chunk.end - p)));
+                    if (lineEnd == nullptr)
+                        lineEnd = chunk.end;
+
+                    if (!parseLine (p, lineEnd, chunk)) {
+                        chunk.error = std::string (p, lineEnd);
+                        return;
+                    }
+                    p = lineEnd + 1;
+                }
+            }
+
+            /* Only newmtl and map_Kd are read, which is all the import uses
+            */
+            static bool loadMTL (const std::string& filePath,
+                                 std::vector <OBJMaterial>& materials,
+                                 std::unordered_map <std::string, int32_t>& materialMap) {
+
+                std::ifstream file (filePath);
+                if (!file.is_open())
+                    return false;
+
+                std::string line;
+                OBJMaterial* material = nullptr;
+                while (std::getline (file, line)) {
+                    const char* p   = line.data();
+                    const char* end = p + line.size();
+                    if (end > p && end[-1] == '\r')
+                        end--;
+                    p = skipSpaces (p, end);
+
+                    const char* tokenEnd = skipToken (p, end);
+                    std::string token (p, tokenEnd);
+                    if (token == "newmtl") {
+                        materials.push_back ({getName (tokenEnd, end), ""});
+                        material = &materials.back();
+                        /* A name that is defined twice keeps pointing at its first definition
+                        */
+                        materialMap.insert ({material->name, static_cast <int32_t> (materials.size() - 1)});
+                    }
+                    /* Texture options may come before the file name, which is the last token on the line
+                    */
+                    else if (token == "map_Kd" && material != nullptr) {
+                        while (end > tokenEnd && isSpace (end[-1]))
+                            end--;
+                        const char* nameBegin = end;
+                        while (nameBegin > tokenEnd && !isSpace (nameBegin[-1]))
+                            nameBegin--;
+                        material->diffuseTexturePath = std::string (nameBegin, end);
+                    }
+                }
+                return true;
+            }
+
+            static bool resolveIndex (int32_t rawIdx,
+                                      uint8_t relative,
+                                      uint8_t relativeBit,
+                                      size_t base,
+                                      size_t count,
+                                      int32_t& index) {
+                if (rawIdx == MISSING_IDX) {
+                    index = -1;
+                    return true;
+                }
+                int64_t resolved = rawIdx;
+                if (relative & relativeBit)
+                    resolved += static_cast <int64_t> (base);
+
+                if (resolved < 0 || resolved >= static_cast <int64_t> (count))
+                    return false;
+                index = static_cast <int32_t> (resolved);
+                return true;
+            }
+
+            /* Point in polygon test (crossing number) of LoadObj, on the triangle (x, y)
+            */
+            static bool isInsideTriangle (const float x[3], const float y[3], float testX, float testY) {
+                bool isInside = false;
+                for (size_t i = 0, j = 2; i < 3; j = i++) {
+                    if (((y[i] > testY) != (y[j] > testY)) &&
+                        (testX < (x[j] - x[i]) * (testY - y[i]) / (y[j] - y[i]) + x[i]))
+                        isInside = !isInside;
+                }
+                return isInside;
+            }
+
+            /* Port of the ear clipping LoadObj triangulates faces with more than 4 corners with, so that both give the
+             * same triangles. The face is projected onto two coordinate axes, dropping the axis that the first non
+             * degenerate corner's normal points along the most. Ears are then cut off starting from a guessed corner,
+             * which moves on past corners that turn against the winding of the face (the sign of its area) or whose
+             * triangle holds another corner. A face that runs out of ears (a degenerate one) keeps the triangles cut
+             * off so far, as in LoadObj
+            */
+            static void clipEars (const std::vector <OBJCorner>& face,
+                                  const std::vector <float>& positions,
+                                  int32_t materialId,
+                                  std::vector <OBJCorner>& remaining,
+                                  OBJCorner*& corners,
+                                  int32_t*& materialIds) {
+
+                size_t cornersCount = face.size();
+                size_t axes[2]      = {1, 2};
+                for (size_t k = 0; k < cornersCount; k++) {
+                    const float* v0 = &positions[face[(k + 0) % cornersCount].positionIdx * 3];
+                    const float* v1 = &positions[face[(k + 1) % cornersCount].positionIdx * 3];
+                    const float* v2 = &positions[face[(k + 2) % cornersCount].positionIdx * 3];
+                    float e0x = v1[0] - v0[0], e0y = v1[1] - v0[1], e0z = v1[2] - v0[2];
+                    float e1x = v2[0] - v1[0], e1y = v2[1] - v1[1], e1z = v2[2] - v1[2];
+                    float cx  = std::fabs (e0y * e1z - e0z * e1y);
+                    float cy  = std::fabs (e0z * e1x - e0x * e1z);
+                    float cz  = std::fabs (e0x * e1y - e0y * e1x);
+
+                    const float epsilon = std::numeric_limits <float>::epsilon();
+                    if (cx > epsilon || cy > epsilon || cz > epsilon) {
+                        if (!(cx > cy && cx > cz)) {
+                            axes[0] = 0;
+                            if (cz > cx && cz > cy)
+                                axes[1] = 1;
+                        }
+                        break;
+                    }
+                }
+                auto getX = [&](const OBJCorner& corner) {
+                    return positions[corner.positionIdx * 3 + axes[0]];
+                };
+                auto getY = [&](const OBJCorner& corner) {
+                    return positions[corner.positionIdx * 3 + axes[1]];
+                };
+
+                float area = 0.0f;
+                for (size_t k = 0; k < cornersCount; k++) {
+                    auto const& c0 = face[(k + 0) % cornersCount];
+                    auto const& c1 = face[(k + 1) % cornersCount];
+                    area += (getX (c0) * getY (c1) - getY (c0) * getX (c1)) * 0.5f;
+                }
+
+                remaining                   = face;
+                size_t guessCorner          = 0;
+                size_t remainingIterations  = remaining.size();
+                size_t previousCornersCount = remaining.size();
+                while (remaining.size() > 3 && remainingIterations > 0) {
+                    cornersCount = remaining.size();
+                    if (guessCorner >= cornersCount)
+                        guessCorner -= cornersCount;
+                    /* Give every corner one try as the guess since an ear was last cut off
+                    */
+                    if (previousCornersCount != cornersCount) {
+                        previousCornersCount = cornersCount;
+                        remainingIterations  = cornersCount;
+                    }
+                    else
+                        remainingIterations--;
+
+                    OBJCorner ear[3];
+                    float x[3], y[3];
+                    for (size_t k = 0; k < 3; k++) {
+                        ear[k] = remaining[(guessCorner + k) % cornersCount];
+                        x[k]   = getX (ear[k]);
+                        y[k]   = getY (ear[k]);
+                    }
+                    float e0x   = x[1] - x[0], e0y = y[1] - y[0];
+                    float e1x   = x[2] - x[1], e1y = y[2] - y[1];
+                    float cross = e0x * e1y - e0y * e1x;
+                    if (cross * area < 0.0f) {
+                        guessCorner++;
+                        continue;
+                    }
+
+                    bool isOverlapping = false;
+                    for (size_t k = 3; k < cornersCount; k++) {
+                        auto const& other = remaining[(guessCorner + k) % cornersCount];
+                        if (isInsideTriangle (x, y, getX (other), getY (other))) {
+                            isOverlapping = true;
+                            break;
+                        }
+                    }
+                    if (isOverlapping) {
+                        guessCorner++;
+                        continue;
+                    }
+
+                    for (auto const& corner: ear)
+                        *corners++ = corner;
+                    *materialIds++ = materialId;
+                    remaining.erase (remaining.begin() + static_cast <ptrdiff_t> ((guessCorner + 1) % cornersCount));
+                }
+
+                if (remaining.size() == 3) {
+                    for (auto const& corner: remaining)
+                        *corners++ = corner;
+                    *materialIds++ = materialId;
+                }
+            }
+
+            static void resolveChunk (Chunk& chunk, OBJParsedData& parsedData) {
+                size_t positionsCount = parsedData.positions.size() / 3;
+                size_t texCoordsCount = parsedData.texCoords.size() / 2;
+                size_t normalsCount   = parsedData.normals.size()   / 3;
+
+                OBJCorner* corners    = parsedData.corners.data()     + chunk.trianglesBase * 3;
+                int32_t* materialIds  = parsedData.materialIds.data() + chunk.trianglesBase;
+                std::vector <OBJCorner> face, remaining;
+                size_t cornerIdx      = 0;
+                /* The shapes are moved to the triangles actually written, which is fewer than counted for faces that
+                 * could not be ear clipped
+                */
+                size_t countedTriangles = 0;
+                size_t shapeIdx         = 0;
+                auto getResolvedTrianglesCount = [&]() {
+                    return static_cast <size_t> (materialIds - parsedData.materialIds.data()) - chunk.trianglesBase;
+                };
+
+                for (size_t faceIdx = 0; faceIdx < chunk.faceSizes.size(); faceIdx++) {
+                    while (shapeIdx < chunk.shapeFirstTriangles.size() &&
+                           chunk.shapeFirstTriangles[shapeIdx] <= countedTriangles)
+                        chunk.shapeFirstTriangles[shapeIdx++] = getResolvedTrianglesCount();
+                    countedTriangles += chunk.faceSizes[faceIdx] - 2;
+
+                    face.resize (chunk.faceSizes[faceIdx]);
+                    for (auto& corner: face) {
+                        auto const& raw = chunk.corners[cornerIdx++];
+                        if (!resolveIndex (raw.positionIdx, raw.relative, RELATIVE_POSITION, chunk.positionsBase,
+                                           positionsCount, corner.positionIdx) ||
+                            !resolveIndex (raw.texCoordIdx, raw.relative, RELATIVE_TEXCOORD, chunk.texCoordsBase,
+                                           texCoordsCount, corner.texCoordIdx) ||
+                            !resolveIndex (raw.normalIdx,   raw.relative, RELATIVE_NORMAL,   chunk.normalsBase,
+                                           normalsCount,   corner.normalIdx)) {
+                            chunk.error = "Invalid face index [" + std::to_string (faceIdx) + "]";
+                            return;
+                        }
+                    }
+
+                    int32_t materialRef = chunk.faceMaterialRefs[faceIdx];
+                    int32_t materialId  = materialRef < 0 ? chunk.startMaterialId: chunk.usemtlIds[materialRef];
+                    /* Quads are split along their shorter diagonal
+                    */
+                    size_t splitCorner  = 0;
+                    if (face.size() == 4) {
+                        auto getSquaredDistance = [&](size_t a, size_t b) {
+                            const float* pa = &parsedData.positions[face[a].positionIdx * 3];
+                            const float* pb = &parsedData.positions[face[b].positionIdx * 3];
+                            float dx = pb[0] - pa[0], dy = pb[1] - pa[1], dz = pb[2] - pa[2];
+                            return dx * dx + dy * dy + dz * dz;
+                        };
+                        if (!(getSquaredDistance (0, 2) < getSquaredDistance (1, 3)))
+                            splitCorner = 1;
+                    }
+
+                    if (face.size() > 4)
+                        clipEars (face, parsedData.positions, materialId, remaining, corners, materialIds);
+
+                    else if (splitCorner == 1) {
+                        const size_t order[6] = {0, 1, 3, 1, 2, 3};
+                        for (auto const& i: order)
+                            *corners++ = face[i];
+                        *materialIds++ = materialId;
+                        *materialIds++ = materialId;
+                    }
+                    else {
+                        for (size_t i = 1; i + 1 < face.size(); i++) {
+                            *corners++     = face[0];
+                            *corners++     = face[i];
+                            *corners++     = face[i + 1];
+                            *materialIds++ = materialId;
+                        }
+                    }
+                }
+                while (shapeIdx < chunk.shapeFirstTriangles.size())
+                    chunk.shapeFirstTriangles[shapeIdx++] = getResolvedTrianglesCount();
+                chunk.resolvedTrianglesCount = getResolvedTrianglesCount();
+            }
+
+        public:
+            /* Returns false (with the reason in err) if the model file could not be read or has an invalid face, missing
+             * .mtl files and materials are reported in warn
+            */
+            static bool loadOBJ (const char* modelPath,
+                                 const char* mtlFileDirPath,
+                                 OBJParsedData& parsedData,
+                                 std::string& warn,
+                                 std::string& err) {
+
+                parsedData = OBJParsedData();
+                int fd     = ::open (modelPath, O_RDONLY);
+                if (fd < 0) {
+                    err = "Cannot open file [" + std::string (modelPath) + "]";
+                    return false;
+                }
+                struct stat fileStat;
+                if (fstat (fd, &fileStat) != 0) {
+                    ::close (fd);
+                    err = "Cannot stat file [" + std::string (modelPath) + "]";
+                    return false;
+                }
+
+                size_t fileSize = static_cast <size_t> (fileStat.st_size);
+                const char* data = nullptr;
+                if (fileSize != 0) {
+                    void* mapping = mmap (nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (mapping == MAP_FAILED) {
+                        ::close (fd);
+                        err = "Cannot map file [" + std::string (modelPath) + "]";
+                        return false;
+                    }
+                    madvise (mapping, fileSize, MADV_SEQUENTIAL);
+                    data = static_cast <const char*> (mapping);
+                }
+                ::close (fd);
+                /* |----------------------------------------------------------------------------------------------------|
+                 * | PARSE                                                                                              |
+                 * |----------------------------------------------------------------------------------------------------|
+                */
+                size_t chunksCount = std::min (std::max (fileSize / MIN_CHUNK_SIZE, size_t (1)),
+                                               Collection::Worker::WorkerPool::getThreadCount() * MAX_CHUNKS_PER_THREAD);
+                std::vector <Chunk> chunks (chunksCount);
+                const char* dataEnd = data + fileSize;
+                const char* begin   = data;
+                for (size_t i = 0; i < chunksCount; i++) {
+                    const char* end = i + 1 == chunksCount ? dataEnd: data + (i + 1) * (fileSize / chunksCount);
+                    /* Move the split to the start of the next line
+                    */
+                    if (end < begin)
+                        end = begin;
+                    if (end < dataEnd) {
+                        auto newLine = static_cast <const char*> (memchr (end, '\n', static_cast <size_t> (dataEnd - end)));
+                        end          = newLine == nullptr ? dataEnd: newLine + 1;
+                    }
+                    chunks[i].begin = begin;
+                    chunks[i].end   = end;
+                    begin           = end;
+                }
+
+                Collection::Worker::g_workerPool.parallelFor (chunksCount, [&](size_t i) {
+                    parseChunk (chunks[i]);
+                });
+                if (fileSize != 0)
+                    munmap (const_cast <char*> (data), fileSize);
+
+                for (auto const& chunk: chunks) {
+                    if (!chunk.error.empty()) {
+                        err = "Failed to parse line [" + chunk.error + "]";
+                        return false;
+                    }
+                }
+                /* |----------------------------------------------------------------------------------------------------|
+                 * | MATERIALS                                                                                          |
+                 * |----------------------------------------------------------------------------------------------------|
+                */
+                std::unordered_map <std::string, int32_t> materialMap;
+                for (auto const& chunk: chunks) {
+                    for (auto const& names: chunk.mtllibNames) {
+                        bool isLoaded = false;
+                        for (auto const& name: names) {
+                            if (loadMTL (std::string (mtlFileDirPath) + name, parsedData.materials, materialMap)) {
+                                isLoaded = true;
+                                break;
+                            }
+                        }
+                        if (!isLoaded)
+                            warn += "Failed to load material file(s)\n";
+                    }
+                }
+
+                int32_t materialId = -1;
+                for (auto& chunk: chunks) {
+                    chunk.startMaterialId = materialId;
+                    for (auto const& name: chunk.usemtlNames) {
+                        auto it    = materialMap.find (name);
+                        materialId = it == materialMap.end() ? -1: it->second;
+                        if (it == materialMap.end())
+                            warn += "Material [" + name + "] not found\n";
+                        chunk.usemtlIds.push_back (materialId);
+                    }
+                }
+                /* |----------------------------------------------------------------------------------------------------|
+                 * | RESOLVE                                                                                            |
+                 * |----------------------------------------------------------------------------------------------------|
+                */
+                size_t positionsSize = 0, texCoordsSize = 0, normalsSize = 0, trianglesCount = 0;
+                for (auto& chunk: chunks) {
+                    chunk.positionsBase = positionsSize / 3;
+                    chunk.texCoordsBase = texCoordsSize / 2;
+                    chunk.normalsBase   = normalsSize   / 3;
+                    chunk.trianglesBase = trianglesCount;
+                    positionsSize  += chunk.positions.size();
+                    texCoordsSize  += chunk.texCoords.size();
+                    normalsSize    += chunk.normals.size();
+                    trianglesCount += chunk.trianglesCount;
+                }
+
+                parsedData.positions.resize   (positionsSize);
+                parsedData.texCoords.resize   (texCoordsSize);
+                parsedData.normals.resize     (normalsSize);
+                parsedData.corners.resize     (trianglesCount * 3);
+                parsedData.materialIds.resize (trianglesCount);
+
+                Collection::Worker::g_workerPool.parallelFor (chunksCount, [&](size_t i) {
+                    auto& chunk = chunks[i];
+                    std::copy (chunk.positions.begin(), chunk.positions.end(),
+                               parsedData.positions.begin() + chunk.positionsBase * 3);
+                    std::copy (chunk.texCoords.begin(), chunk.texCoords.end(),
+                               parsedData.texCoords.begin() + chunk.texCoordsBase * 2);
+                    std::copy (chunk.normals.begin(),   chunk.normals.end(),
+                               parsedData.normals.begin()   + chunk.normalsBase   * 3);
+                });
+                Collection::Worker::g_workerPool.parallelFor (chunksCount, [&](size_t i) {
+                    resolveChunk (chunks[i], parsedData);
+                });
+
+                for (auto const& chunk: chunks) {
+                    if (!chunk.error.empty()) {
+                        err = chunk.error;
+                        return false;
+                    }
+                }
+                /* Close the gaps left by faces that could not be ear clipped
+                */
+                size_t resolvedTrianglesCount = 0;
+                for (auto const& chunk: chunks) {
+                    if (chunk.trianglesBase != resolvedTrianglesCount) {
+                        auto cornersBegin = parsedData.corners.begin() + chunk.trianglesBase * 3;
+                        std::copy (cornersBegin, cornersBegin + chunk.resolvedTrianglesCount * 3,
+                                   parsedData.corners.begin() + resolvedTrianglesCount * 3);
+                        auto materialIdsBegin = parsedData.materialIds.begin() + chunk.trianglesBase;
+                        std::copy (materialIdsBegin, materialIdsBegin + chunk.resolvedTrianglesCount,
+                                   parsedData.materialIds.begin() + resolvedTrianglesCount);
+                    }
+                    for (auto const& firstTriangle: chunk.shapeFirstTriangles) {
+                        size_t triangleIdx = resolvedTrianglesCount + firstTriangle;
+                        /* Consecutive 'o'/'g' lines without faces in between start the same shape
+                        */
+                        if (triangleIdx != 0 && (parsedData.shapeFirstTriangles.empty() ||
+                                                 parsedData.shapeFirstTriangles.back() != triangleIdx))
+                            parsedData.shapeFirstTriangles.push_back (triangleIdx);
+                    }
+                    resolvedTrianglesCount += chunk.resolvedTrianglesCount;
+                }
+                parsedData.corners.resize     (resolvedTrianglesCount * 3);
+                parsedData.materialIds.resize (resolvedTrianglesCount);
+                return true;
+            }
+    };
+}   // namespace Core
+#endif  // VK_OBJ_PARSER_
\ No newline at end of file
@@ -0,0 +1,168 @@
+#ifndef VK_VERTEX_COMPACT_H
+#define VK_VERTEX_COMPACT_H
+
+#include <vector>
+#include <span>
+#include <initializer_list>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <glm/gtc/packing.hpp>
+#include "VKVertexData.h"
+
+namespace Core {
+    struct BoundingBox {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    /* 16 byte vertex that is uploaded in place of the 36 byte Vertex when the compact vertex format is enabled, the
+     * vertex shader decodes it back (see defaultShader.vert)
+     * (1) Position, quantized to 16 bit unsigned normalized values within the model's bounding box. A 4th component is
+     *     stored since 3 component 16 bit formats are not required to be supported for vertex buffers
+     * (2) Texture coordinates, half floats
+     * (3) Normal, octahedral encoded into two 8 bit signed normalized values (the unit sphere is projected onto an
+     *     octahedron and the octahedron unfolded onto a square)
+     * (4) Texture id, 8 bits. It only indexes into the texture id look up table which holds UINT8_MAX + 1 entries
+    */
+    struct CompactVertex {
+        uint16_t pos[4];
+        uint16_t texCoord[2];
+        uint8_t  normal[2];
+        uint8_t  texId;
+        uint8_t  padding;
+    };
+    static_assert (sizeof (CompactVertex) == 16, "Compact vertex is expected to be 16 bytes");
+
+    class VKVertexCompact {
+        public:
+            /* Index data of a model within the combined index buffer, the index buffer is bound at the offset before
+             * drawing the model
+            */
+            struct IndexSegment {
+                VkIndexType indexType;
+                VkDeviceSize offset;
+            };
+
+            static BoundingBox getBoundingBox (std::span <const Vertex> vertices) {
+                if (vertices.empty())
+                    return {glm::vec3 (0.0f), glm::vec3 (0.0f)};
+
+                BoundingBox bounds = {vertices[0].pos, vertices[0].pos};
+                for (auto const& vertex: vertices) {
+                    bounds.min = glm::min (bounds.min, vertex.pos);
+                    bounds.max = glm::max (bounds.max, vertex.pos);
+                }
+                return bounds;
+            }
+
+            /* The shader decodes a position as offset + quantized * scale, the offset and scale of a model are written
+             * to each of its instances
+            */
+            static glm::vec3 getPositionScale (const BoundingBox& bounds) {
+                return bounds.max - bounds.min;
+            }
+
+            static CompactVertex encodeVertex (const Vertex& vertex, const BoundingBox& bounds) {
+                CompactVertex compactVertex;
+                glm::vec3 scale = getPositionScale (bounds);
+                for (int i = 0; i < 3; i++) {
+                    /* A flat axis of the bounding box is decoded from the offset alone
+                    */
+                    float normalized       = scale[i] == 0.0f ? 0.0f: (vertex.pos[i] - bounds.min[i]) / scale[i];
+                    compactVertex.pos[i]   = glm::packUnorm1x16 (normalized);
+                }
+                compactVertex.pos[3]        = 0;
+                compactVertex.texCoord[0]   = glm::packHalf1x16 (vertex.texCoord.x);
+                compactVertex.texCoord[1]   = glm::packHalf1x16 (vertex.texCoord.y);
+                /* Project onto the octahedron |x| + |y| + |z| = 1, the lower half (z < 0) is folded over the diagonals
+                 * onto the corners of the square
+                */
+                float l1Norm = std::fabs (vertex.normal.x) + std::fabs (vertex.normal.y) + std::fabs (vertex.normal.z);
+                float octX   = l1Norm == 0.0f ? 0.0f: vertex.normal.x / l1Norm;
+                float octY   = l1Norm == 0.0f ? 0.0f: vertex.normal.y / l1Norm;
+                if (vertex.normal.z < 0.0f) {
+                    float foldedX = (1.0f - std::fabs (octY)) * (octX >= 0.0f ? 1.0f: -1.0f);
+                    float foldedY = (1.0f - std::fabs (octX)) * (octY >= 0.0f ? 1.0f: -1.0f);
+                    octX = foldedX;
+                    octY = foldedY;
+                }
+                compactVertex.normal[0]     = glm::packSnorm1x8 (octX);
+                compactVertex.normal[1]     = glm::packSnorm1x8 (octY);
+                compactVertex.texId         = static_cast <uint8_t> (vertex.texId);
+                compactVertex.padding       = 0;
+                return compactVertex;
+            }
+
+            /* Inverse of encodeVertex, same as the decode in the vertex shader
+            */
+            static Vertex decodeVertex (const CompactVertex& compactVertex, const BoundingBox& bounds) {
+                Vertex vertex;
+                glm::vec3 scale = getPositionScale (bounds);
+                for (int i = 0; i < 3; i++)
+                    vertex.pos[i]   = bounds.min[i] + glm::unpackUnorm1x16 (compactVertex.pos[i]) * scale[i];
+
+                vertex.texCoord     = {
+                                        glm::unpackHalf1x16 (compactVertex.texCoord[0]),
+                                        glm::unpackHalf1x16 (compactVertex.texCoord[1])
+                                      };
+                float octX          = glm::unpackSnorm1x8 (compactVertex.normal[0]);
+                float octY          = glm::unpackSnorm1x8 (compactVertex.normal[1]);
+                glm::vec3 normal    = {octX, octY, 1.0f - std::fabs (octX) - std::fabs (octY)};
+                float fold          = std::fmax (-normal.z, 0.0f);
+                normal.x           += normal.x >= 0.0f ? -fold: fold;
+                normal.y           += normal.y >= 0.0f ? -fold: fold;
+                vertex.normal       = glm::normalize (normal);
+                vertex.texId        = compactVertex.texId;
+                return vertex;
+            }
+
+            static void appendVertices (std::span <const Vertex> vertices,
+                                        const BoundingBox& bounds,
+                                        std::vector <CompactVertex>& compactVertices) {
+                compactVertices.reserve (compactVertices.size() + vertices.size());
+                for (auto const& vertex: vertices)
+                    compactVertices.push_back (encodeVertex (vertex, bounds));
+            }
+
+            /* The indices of a model are local to the model (the vertex offset is added when drawing), so a model with
+             * fewer vertices than UINT16_MAX gets 16 bit indices no matter how large the combined vertex buffer is. The
+             * value UINT16_MAX itself is left out as it is the primitive restart index
+             *
+             * The index ranges of a model (its levels of detail) are appended one after the other into one segment
+            */
+            static IndexSegment appendIndices (std::initializer_list <std::span <const uint32_t>> indexRanges,
+                                               size_t verticesCount,
+                                               std::vector <uint8_t>& indexBytes) {
+                IndexSegment segment;
+                segment.indexType    = verticesCount < UINT16_MAX ? VK_INDEX_TYPE_UINT16: VK_INDEX_TYPE_UINT32;
+                /* The offset an index buffer is bound at has to be a multiple of the index size
+                */
+                size_t indexSize     = segment.indexType == VK_INDEX_TYPE_UINT16 ? sizeof (uint16_t):
+                                                                                    sizeof (uint32_t);
+                segment.offset       = (indexBytes.size() + sizeof (uint32_t) - 1) & ~(sizeof (uint32_t) - 1);
+
+                size_t indicesCount  = 0;
+                for (auto const& indices: indexRanges)
+                    indicesCount += indices.size();
+
+                indexBytes.resize (segment.offset + indicesCount * indexSize, 0);
+                uint8_t* dst = indexBytes.data() + segment.offset;
+                for (auto const& indices: indexRanges) {
+                    if (segment.indexType == VK_INDEX_TYPE_UINT16) {
+                        for (auto const& index: indices) {
+                            uint16_t narrowIndex = static_cast <uint16_t> (index);
+                            std::memcpy (dst, &narrowIndex, sizeof (uint16_t));
+                            dst += sizeof (uint16_t);
+                        }
+                    }
+                    else if (!indices.empty()) {
+                        std::memcpy (dst, indices.data(), indices.size_bytes());
+                        dst += indices.size_bytes();
+                    }
+                }
+                return segment;
+            }
+    };
+}   // namespace Core
+#endif  // VK_VERTEX_COMPACT_H
\ No newline at end of file
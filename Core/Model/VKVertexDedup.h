@@ -0,0 +1,145 @@
+#ifndef VK_VERTEX_DEDUP_H
+#define VK_VERTEX_DEDUP_H
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include "VKVertexData.h"
+
+namespace Core {
+    /* Open addressing (linear probing) table used to keep only the unique vertices of a model while building its index
+     * data. Compared to a std::unordered_map <Vertex, uint32_t>, there is no node allocation per vertex and a lookup
+     * walks a flat array of slots instead of a bucket list, the vertices themselves are not copied into the table since
+     * a slot only records the index of the vertex in the vertices vector and a part of its hash
+     *
+     * A vertex is hashed over its bits, with -0.0 folded into 0.0 so that vertices which compare equal with operator ==
+     * always land on the same hash. Equality is still decided by operator ==, which keeps the output identical to the map
+    */
+    class VKVertexDedup {
+        private:
+            struct Slot {
+                /* Upper bits of the hash, to skip most of the vertex compares on a collision
+                */
+                uint32_t hashTag;
+                uint32_t index;
+            };
+
+            static constexpr uint32_t EMPTY_INDEX = UINT32_MAX;
+            /* The table is grown once it is more than 1/2 full, linear probing degrades quickly past that
+            */
+            static constexpr size_t   MAX_LOAD_NUMERATOR   = 1;
+            static constexpr size_t   MAX_LOAD_DENOMINATOR = 2;
+
+            std::vector <Slot> m_slots;
+            size_t m_mask;
+            size_t m_count;
+
+            static uint32_t getBits (float value) {
+                /* Adding 0.0f turns -0.0 into 0.0 and leaves every other value as is
+                */
+                value += 0.0f;
+                uint32_t bits;
+                memcpy (&bits, &value, sizeof (bits));
+                return bits;
+            }
+
+            static uint64_t getMixed (uint64_t hash, uint64_t word) {
+                hash ^= word;
+                hash *= 0x9E3779B97F4A7C15ULL;
+                return hash ^ (hash >> 32);
+            }
+
+            void resize (size_t capacity, const std::vector <Vertex>& vertices) {
+                m_slots.assign (capacity, {0, EMPTY_INDEX});
+                m_mask = capacity - 1;
+                /* Every vertex in the vertices vector was inserted through this table, so re-inserting them in order
+                 * rebuilds it as is
+                */
+                for (uint32_t i = 0; i < m_count; i++) {
+                    uint64_t hash = getHash (vertices[i]);
+                    size_t slotIdx = static_cast <size_t> (hash) & m_mask;
+                    while (m_slots[slotIdx].index != EMPTY_INDEX)
+                        slotIdx = (slotIdx + 1) & m_mask;
+                    m_slots[slotIdx] = {static_cast <uint32_t> (hash >> 32), i};
+                }
+            }
+
+        public:
+            VKVertexDedup (void) {
+                m_mask  = 0;
+                m_count = 0;
+            }
+
+            ~VKVertexDedup (void) {
+            }
+
+            static uint64_t getHash (const Vertex& vertex) {
+                uint64_t words[5] = {
+                    getBits (vertex.pos.x)      | static_cast <uint64_t> (getBits (vertex.pos.y))      << 32,
+                    getBits (vertex.pos.z)      | static_cast <uint64_t> (getBits (vertex.texCoord.x)) << 32,
+                    getBits (vertex.texCoord.y) | static_cast <uint64_t> (getBits (vertex.normal.x))   << 32,
+                    getBits (vertex.normal.y)   | static_cast <uint64_t> (getBits (vertex.normal.z))   << 32,
+                    vertex.texId
+                };
+                uint64_t hash = 0xCBF29CE484222325ULL;
+                for (auto const& word: words)
+                    hash = getMixed (hash, word);
+                /* Final avalanche (murmur3 fmix64), both the low bits (slot index) and the high bits (tag) are used
+                */
+                hash ^= hash >> 33;
+                hash *= 0xFF51AFD7ED558CCDULL;
+                hash ^= hash >> 33;
+                hash *= 0xC4CEB9FE1A85EC53ULL;
+                hash ^= hash >> 33;
+                return hash;
+            }
+
+            /* Size the table for the number of vertices about to be looked up (for a model, that is the number of indices
+             * in its faces), so that it never needs to grow. The vertices vector is expected to be empty at this point
+            */
+            void reset (size_t expectedCount) {
+                size_t capacity = 16;
+                while (capacity * MAX_LOAD_NUMERATOR < expectedCount * MAX_LOAD_DENOMINATOR)
+                    capacity <<= 1;
+
+                m_count = 0;
+                m_slots.assign (capacity, {0, EMPTY_INDEX});
+                m_mask  = capacity - 1;
+            }
+
+            /* Single lookup-or-insert, returns the index of the vertex in the vertices vector, appending it if it has not
+             * been seen before
+            */
+            uint32_t getIndex (const Vertex& vertex, std::vector <Vertex>& vertices) {
+                if (m_slots.empty())
+                    reset (0);
+
+                uint64_t hash    = getHash (vertex);
+                uint32_t hashTag = static_cast <uint32_t> (hash >> 32);
+                size_t slotIdx   = static_cast <size_t> (hash) & m_mask;
+
+                while (true) {
+                    Slot& slot = m_slots[slotIdx];
+                    if (slot.index == EMPTY_INDEX)
+                        break;
+                    if (slot.hashTag == hashTag && vertices[slot.index] == vertex)
+                        return slot.index;
+                    slotIdx = (slotIdx + 1) & m_mask;
+                }
+
+                uint32_t index = static_cast <uint32_t> (vertices.size());
+                vertices.push_back (vertex);
+                m_slots[slotIdx] = {hashTag, index};
+                m_count++;
+
+                if (m_count * MAX_LOAD_DENOMINATOR > m_slots.size() * MAX_LOAD_NUMERATOR)
+                    resize (m_slots.size() * 2, vertices);
+                return index;
+            }
+
+            size_t getCount (void) {
+                return m_count;
+            }
+    };
+}   // namespace Core
+#endif  // VK_VERTEX_DEDUP_H
\ No newline at end of file
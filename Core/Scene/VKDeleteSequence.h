@@ -14,6 +14,7 @@
 #include "VKTextureSampler.h"
 #include "VKDescriptor.h"
 #include "VKSyncObject.h"
+#include "VKModelReload.h"
 
 namespace Core {
     class VKDeleteSequence: protected virtual VKWindow,
@@ -28,7 +29,8 @@ namespace Core {
                             protected virtual VKCameraMgr,
                             protected virtual VKTextureSampler,
                             protected virtual VKDescriptor,
-                            protected virtual VKSyncObject {
+                            protected virtual VKSyncObject,
+                            protected virtual VKModelReload {
         private:
             Log::Record* m_VKDeleteSequenceLog;
             const uint32_t m_instanceId = g_collectionSettings.instanceId++;
@@ -59,6 +61,16 @@ namespace Core {
                  * |------------------------------------------------------------------------------------------------|
                 */
                 extensions();
+#if ENABLE_MODEL_HOT_RELOAD
+                /* |------------------------------------------------------------------------------------------------|
+                 * | DESTROY MODEL RELOAD                                                                           |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                cleanUpModelReload (deviceInfoId);
+                LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Model reload "
+                                                 << "[" << deviceInfoId << "]"
+                                                 << std::endl;
+#endif  // ENABLE_MODEL_HOT_RELOAD
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY DRAW OPS - FENCE AND SEMAPHORES                                                        |
                  * |------------------------------------------------------------------------------------------------|
@@ -190,6 +202,17 @@ namespace Core {
                                                              << std::endl;
                         }
                     }
+
+                    if (sceneInfo->id.staticStorageBufferInfo != UINT32_MAX) {
+                        VKBufferMgr::cleanUp (deviceInfoId, sceneInfo->id.staticStorageBufferInfo, STORAGE_BUFFER);
+                        for (uint32_t i = 0; i < g_coreSettings.maxFramesInFlight; i++)
+                            VKBufferMgr::cleanUp (deviceInfoId,
+                                                  sceneInfo->id.staticStagingBufferInfoBase + i,
+                                                  STAGING_BUFFER);
+                        LOG_INFO (m_VKDeleteSequenceLog) << "[DELETE] Static storage buffer "
+                                                         << "[" << sceneInfo->id.staticStorageBufferInfo << "]"
+                                                         << std::endl;
+                    }
                 }
                 /* |------------------------------------------------------------------------------------------------|
                  * | DESTROY UNIFORM BUFFERS                                                                        |
@@ -9,6 +9,7 @@
 #include "VKCameraMgr.h"
 #include "VKSyncObject.h"
 #include "VKResizing.h"
+#include "VKModelReload.h"
 
 namespace Core {
     class VKDrawSequence: protected virtual VKWindow,
@@ -18,6 +19,7 @@ namespace Core {
                           protected virtual VKCmd,
                           protected virtual VKCameraMgr,
                           protected virtual VKSyncObject,
+                          protected virtual VKModelReload,
                           protected VKResizing {
         private:
             Log::Record* m_VKDrawSequenceLog;
@@ -166,24 +168,44 @@ namespace Core {
                 */
                 cameraInfo->meta.updateViewMatrix       = false;
                 cameraInfo->meta.updateProjectionMatrix = false;
+#if ENABLE_MODEL_HOT_RELOAD
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG DRAW OPS - MODEL RELOAD                                                                 |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                /* A reloaded model is swapped in here, before any of the model data is read for this frame
+                */
+                updateModelReloads (deviceInfoId, modelInfoIds);
+#endif  // ENABLE_MODEL_HOT_RELOAD
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG DRAW OPS - UPDATE UNIFORMS                                                              |
                  * |------------------------------------------------------------------------------------------------|
                 */
-                std::vector <InstanceDataSSBO> combinedInstances;
-                size_t combinedInstancesCount = 0;
-
-                for (auto const& infoId: modelInfoIds) {
-                    auto modelInfo          = getModelInfo (infoId);
-                    combinedInstancesCount += modelInfo->meta.instancesCount;
-
-                    combinedInstances.reserve (combinedInstancesCount);
-                    combinedInstances.insert  (combinedInstances.end(), modelInfo->meta.instances.begin(),
-                                                                        modelInfo->meta.instances.end());
-                }
-                updateStorageBuffer (sceneInfo->id.storageBufferInfoBase + currentFrameInFlight,
-                                     sceneInfo->meta.totalInstancesCount * sizeof (InstanceDataSSBO),
-                                     combinedInstances.data());
+                /* Instances are written from the instance arena straight into this frame's mapped storage buffer,
+                 * only the slots of the buffer that have changed since it was last written (see writeInstances)
+                */
+#if ENABLE_MESH_LOD
+                orderInstancesByLOD (modelInfoIds, cameraInfo->meta.position);
+#endif  // ENABLE_MESH_LOD
+                InstanceSlotTracker instanceSlotTracker;
+                instanceSlotTracker.frameInFlight   = currentFrameInFlight;
+                instanceSlotTracker.slotKeys        = &sceneInfo->meta.instanceSlotKeys[currentFrameInFlight];
+                void* storageBufferMapped           = getStorageBufferMapped (sceneInfo->id.storageBufferInfoBase +
+                                                                              currentFrameInFlight);
+                sceneInfo->meta.instanceUploadBytes = writeInstances (modelInfoIds,
+                                                                      storageBufferMapped,
+                                                                      &instanceSlotTracker);
+                /* The static instance data that has changed is written to this frame's staging buffer, and copied to
+                 * the static storage buffer in the command buffer below
+                */
+                uint32_t staticStagingBufferInfoId        = sceneInfo->id.staticStagingBufferInfoBase +
+                                                            currentFrameInFlight;
+                std::vector <VkBufferCopy> staticCopyRegions;
+                sceneInfo->meta.staticInstanceUploadBytes = writeStaticInstances (modelInfoIds,
+                                                                                  getStorageBufferMapped (
+                                                                                  staticStagingBufferInfoId,
+                                                                                  STAGING_BUFFER),
+                                                                                  staticCopyRegions);
 
                 SceneDataVertPC sceneDataVert;
                 sceneDataVert.viewMatrix       = cameraInfo->transform.viewMatrix;
@@ -196,6 +218,33 @@ namespace Core {
                 */
                 vkResetCommandBuffer (sceneInfo->resource.commandBuffers[currentFrameInFlight], 0);
                 beginRecording       (sceneInfo->resource.commandBuffers[currentFrameInFlight], 0, VK_NULL_HANDLE);
+                /* Copies are not allowed inside a render pass, so the static instance data is copied ahead of it. The
+                 * static storage buffer is shared by the frames in flight, the first barrier keeps the copy from writing
+                 * to it while the vertex shaders of the frames submitted before this one may still be reading from it
+                 * (write after read, an execution dependency is enough). The second one makes the written data visible
+                 * to this frame's vertex shader
+                */
+                if (!staticCopyRegions.empty()) {
+                    bufferMemoryBarrier       (sceneInfo->id.staticStorageBufferInfo, STORAGE_BUFFER,
+                                               VK_ACCESS_NONE,
+                                               VK_ACCESS_TRANSFER_WRITE_BIT,
+                                               VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                                               VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                               sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+
+                    copyBufferRegionsToBuffer (staticStagingBufferInfoId,
+                                               sceneInfo->id.staticStorageBufferInfo,
+                                               STAGING_BUFFER, STORAGE_BUFFER,
+                                               staticCopyRegions,
+                                               sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+
+                    bufferMemoryBarrier       (sceneInfo->id.staticStorageBufferInfo, STORAGE_BUFFER,
+                                               VK_ACCESS_TRANSFER_WRITE_BIT,
+                                               VK_ACCESS_SHADER_READ_BIT,
+                                               VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                               VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                                               sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+                }
                 /* Define the clear values to use for VK_ATTACHMENT_LOAD_OP_CLEAR. Note that, the order of clear values
                  * should be identical to the order of your attachments
                  *
@@ -255,10 +304,12 @@ namespace Core {
                                       vertexBufferOffsets,
                                       sceneInfo->resource.commandBuffers[currentFrameInFlight]);
 
+#if !ENABLE_COMPACT_VERTEX_FORMAT
                 bindIndexBuffer      (modelInfoBase->id.indexBufferInfo,
                                       0,
                                       VK_INDEX_TYPE_UINT32,
                                       sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
 
                 auto descriptorSetsToBind = std::vector {
                     sceneInfo->resource.perFrameDescriptorSets[currentFrameInFlight],   /* Set #0 */
@@ -286,21 +337,83 @@ namespace Core {
                  *              |
                  *              firstIndex
                 */
-                uint32_t firstIndex    = 0;
-                int32_t  vertexOffset  = 0;
-                uint32_t firstInstance = 0;
+#if ENABLE_MESHLET_CULLING
+                auto frustum = VKMeshlet::getFrustum (cameraInfo->transform.projectionMatrix *
+                                                      cameraInfo->transform.viewMatrix);
+                std::vector <MeshletDraw> meshletDraws;
+#endif  // ENABLE_MESHLET_CULLING
 
                 for (auto const& infoId: modelInfoIds) {
                     auto modelInfo = getModelInfo (infoId);
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                    /* Index segments may differ in index type, so the index buffer is bound at the start of each model's
+                     * segment and indexing starts from 0 within it
+                    */
+                    bindIndexBuffer (modelInfoBase->id.indexBufferInfo,
+                                     modelInfo->meta.indexSegment.offset,
+                                     modelInfo->meta.indexSegment.indexType,
+                                     sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+                    uint32_t modelFirstIndex = 0;
+#else
+                    uint32_t modelFirstIndex = static_cast <uint32_t> (modelInfo->meta.indexSegment.offset /
+                                                                       sizeof (uint32_t));
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+                    /* The offsets are kept per model rather than summed up over the models, since a reloaded model
+                     * moves to wherever there was room for it
+                    */
+                    int32_t  vertexOffset    = modelInfo->meta.vertexOffset;
+                    /* Instances are drawn from the model's slice of the storage buffer, in its draw order
+                    */
+                    uint32_t levelFirstInstance = modelInfo->meta.firstArenaInstance;
+                    size_t   firstLevel         = 0;
+#if ENABLE_MESHLET_CULLING
+                    /* Instances at full detail only draw their clusters that passed culling (see cullMeshlets)
+                    */
+#if ENABLE_MESH_LOD
+                    uint32_t fullInstancesCount = modelInfo->meta.lodInstancesCounts[0];
+#else
+                    uint32_t fullInstancesCount = modelInfo->meta.instancesCount;
+#endif  // ENABLE_MESH_LOD
+                    meshletDraws.clear();
+                    cullMeshlets (infoId,
+                                  fullInstancesCount,
+                                  frustum,
+                                  cameraInfo->meta.position,
+                                  meshletDraws);
 
-                    drawIndexed (modelInfo->meta.indicesCount,
-                                 modelInfo->meta.instancesCount,
-                                 firstIndex, vertexOffset, firstInstance,
-                                 sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+                    for (auto const& draw: meshletDraws)
+                        drawIndexed (draw.indicesCount,
+                                     draw.instancesCount,
+                                     modelFirstIndex + draw.firstIndex,
+                                     vertexOffset, draw.firstInstance,
+                                     sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+                    levelFirstInstance += fullInstancesCount;
+                    firstLevel          = 1;
+#endif  // ENABLE_MESHLET_CULLING
 
-                    firstIndex    += modelInfo->meta.indicesCount;
-                    vertexOffset  += modelInfo->meta.verticesCount;
-                    firstInstance += modelInfo->meta.instancesCount;
+#if ENABLE_MESH_LOD
+                    /* The model's instances are ordered by level of detail (see orderInstancesByLOD), each level is
+                     * drawn with its own range of indices
+                    */
+                    for (size_t level = firstLevel; level < modelInfo->meta.lods.size(); level++) {
+                        uint32_t levelInstancesCount = modelInfo->meta.lodInstancesCounts[level];
+                        if (levelInstancesCount == 0)
+                            continue;
+
+                        drawIndexed (modelInfo->meta.lods[level].indicesCount,
+                                     levelInstancesCount,
+                                     modelFirstIndex + modelInfo->meta.lods[level].firstIndex,
+                                     vertexOffset, levelFirstInstance,
+                                     sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+                        levelFirstInstance += levelInstancesCount;
+                    }
+#else
+                    if (firstLevel == 0)
+                        drawIndexed (modelInfo->meta.indicesCount,
+                                     modelInfo->meta.instancesCount,
+                                     modelFirstIndex, vertexOffset, levelFirstInstance,
+                                     sceneInfo->resource.commandBuffers[currentFrameInFlight]);
+#endif  // ENABLE_MESH_LOD
                 }
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG PRIMARY EXTENSIONS                                                                      |
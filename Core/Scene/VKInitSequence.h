@@ -33,6 +33,7 @@
 #include "VKTextureSampler.h"
 #include "VKDescriptor.h"
 #include "VKSyncObject.h"
+#include "VKModelReload.h"
 
 namespace Core {
     class VKInitSequence: protected virtual VKWindow,
@@ -66,7 +67,8 @@ namespace Core {
                           protected virtual VKCmd,
                           protected virtual VKTextureSampler,
                           protected virtual VKDescriptor,
-                          protected virtual VKSyncObject {
+                          protected virtual VKSyncObject,
+                          protected virtual VKModelReload {
         private:
             Log::Record* m_VKInitSequenceLog;
             const uint32_t m_instanceId = g_collectionSettings.instanceId++;
@@ -154,8 +156,11 @@ namespace Core {
                  * | IMPORT MODEL                                                                                   |
                  * |------------------------------------------------------------------------------------------------|
                 */
+                /* Models are imported concurrently on the worker pool, the look up tables are populated afterwards on
+                 * this thread
+                */
+                importOBJModels (modelInfoIds);
                 for (auto const& infoId: modelInfoIds) {
-                    importOBJModel (infoId);
                     /* Populate texture image info id look up table for all model instances
                     */
                     auto modelInfo = getModelInfo (infoId);
@@ -218,7 +223,11 @@ namespace Core {
                  * | CONFIG VERTEX BUFFERS                                                                          |
                  * |------------------------------------------------------------------------------------------------|
                 */
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                std::vector <CompactVertex> combinedVertices;
+#else
                 std::vector <Vertex> combinedVertices;
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
                 size_t combinedVerticesCount = 0;
                 uint32_t vertexBufferInfoId  = getNextInfoIdFromBufferType (STAGING_BUFFER);
                 /* Combine all vertex buffers to a single buffer. Note that, only the first model will have access to
@@ -227,19 +236,35 @@ namespace Core {
                 */
                 for (auto const& infoId: modelInfoIds) {
                     auto modelInfo         = getModelInfo (infoId);
+                    modelInfo->meta.vertexOffset = static_cast <int32_t> (combinedVerticesCount);
                     combinedVerticesCount += modelInfo->meta.verticesCount;
 
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                    VKVertexCompact::appendVertices (modelInfo->meta.vertices,
+                                                     modelInfo->meta.bounds,
+                                                     combinedVertices);
+#else
                     combinedVertices.reserve (combinedVerticesCount);
                     combinedVertices.insert  (combinedVertices.end(), modelInfo->meta.vertices.begin(),
                                                                       modelInfo->meta.vertices.end());
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
 
                     infoId == modelInfoIds[0] ? modelInfo->id.vertexBufferInfos.push_back (vertexBufferInfoId):
                                                 modelInfo->id.vertexBufferInfos.push_back (UINT32_MAX);
                 }
 
+#if ENABLE_MODEL_HOT_RELOAD
+                /* Free space for reloaded models at the end of the buffer
+                */
+                VkDeviceSize usedVertexBufferSize = combinedVerticesCount * sizeof (combinedVertices[0]);
+                combinedVerticesCount += static_cast <size_t> (combinedVerticesCount *
+                                                               g_coreSettings.modelReloadReserveRatio);
+                combinedVertices.resize (combinedVerticesCount);
+#endif  // ENABLE_MODEL_HOT_RELOAD
+
                 createVertexBuffer (deviceInfoId,
                                     vertexBufferInfoId,
-                                    combinedVerticesCount * sizeof (Vertex),
+                                    combinedVerticesCount * sizeof (combinedVertices[0]),
                                     combinedVertices.data());
 
                 LOG_INFO (m_VKInitSequenceLog) << "[OK] Vertex buffer "
@@ -249,30 +274,86 @@ namespace Core {
                  * | CONFIG INDEX BUFFER                                                                            |
                  * |------------------------------------------------------------------------------------------------|
                 */
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                /* Each model's indices are a segment of their own in the index buffer, 16 bit wide where the model has
+                 * few enough vertices. The index buffer is bound at the segment's offset before the model is drawn
+                */
+                std::vector <uint8_t> combinedIndexBytes;
+                uint32_t indexBufferInfoId  = getNextInfoIdFromBufferType (STAGING_BUFFER);
+
+                for (auto const& infoId: modelInfoIds) {
+                    auto modelInfo = getModelInfo (infoId);
+                    modelInfo->meta.indexSegment = VKVertexCompact::appendIndices ({modelInfo->meta.indices,
+                                                                                    modelInfo->meta.lodIndices},
+                                                                                   modelInfo->meta.verticesCount,
+                                                                                   combinedIndexBytes);
+
+                    infoId == modelInfoIds[0] ? modelInfo->id.indexBufferInfo = indexBufferInfoId:
+                                                modelInfo->id.indexBufferInfo = UINT32_MAX;
+                }
+
+#if ENABLE_MODEL_HOT_RELOAD
+                VkDeviceSize usedIndexBufferSize = combinedIndexBytes.size();
+                combinedIndexBytes.resize ((combinedIndexBytes.size() +
+                                            static_cast <size_t> (combinedIndexBytes.size() *
+                                                                  g_coreSettings.modelReloadReserveRatio) +
+                                            sizeof (uint32_t) - 1) & ~(sizeof (uint32_t) - 1), 0);
+#endif  // ENABLE_MODEL_HOT_RELOAD
+
+                createIndexBuffer (deviceInfoId,
+                                   indexBufferInfoId,
+                                   combinedIndexBytes.size(),
+                                   combinedIndexBytes.data());
+#else
                 std::vector <uint32_t> combinedIndices;
                 size_t combinedIndicesCount = 0;
                 uint32_t indexBufferInfoId  = getNextInfoIdFromBufferType (STAGING_BUFFER);
 
                 for (auto const& infoId: modelInfoIds) {
                     auto modelInfo        = getModelInfo (infoId);
-                    combinedIndicesCount += modelInfo->meta.indicesCount;
+                    modelInfo->meta.indexSegment = {VK_INDEX_TYPE_UINT32, combinedIndicesCount * sizeof (uint32_t)};
+                    /* The indices of the model's levels of detail follow its own indices
+                    */
+                    combinedIndicesCount += modelInfo->meta.indicesCount + modelInfo->meta.lodIndices.size();
 
                     combinedIndices.reserve (combinedIndicesCount);
                     combinedIndices.insert  (combinedIndices.end(), modelInfo->meta.indices.begin(),
                                                                     modelInfo->meta.indices.end());
+                    combinedIndices.insert  (combinedIndices.end(), modelInfo->meta.lodIndices.begin(),
+                                                                    modelInfo->meta.lodIndices.end());
 
                     infoId == modelInfoIds[0] ? modelInfo->id.indexBufferInfo = indexBufferInfoId:
                                                 modelInfo->id.indexBufferInfo = UINT32_MAX;
                 }
 
+#if ENABLE_MODEL_HOT_RELOAD
+                VkDeviceSize usedIndexBufferSize = combinedIndicesCount * sizeof (uint32_t);
+                combinedIndicesCount += static_cast <size_t> (combinedIndicesCount *
+                                                              g_coreSettings.modelReloadReserveRatio);
+                combinedIndices.resize (combinedIndicesCount, 0);
+#endif  // ENABLE_MODEL_HOT_RELOAD
+
                 createIndexBuffer (deviceInfoId,
                                    indexBufferInfoId,
                                    combinedIndicesCount * sizeof (uint32_t),
                                    combinedIndices.data());
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
 
                 LOG_INFO (m_VKInitSequenceLog) << "[OK] Index buffer "
                                                << "[" << indexBufferInfoId << "]"
                                                << std::endl;
+#if ENABLE_MODEL_HOT_RELOAD
+                /* |------------------------------------------------------------------------------------------------|
+                 * | CONFIG MODEL RELOAD                                                                            |
+                 * |------------------------------------------------------------------------------------------------|
+                */
+                readyModelReload (deviceInfoId,
+                                  vertexBufferInfoId, usedVertexBufferSize,
+                                  indexBufferInfoId,  usedIndexBufferSize);
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Model reload "
+                                               << "[" << g_coreSettings.modelWatchDirPath << "]"
+                                               << std::endl;
+#endif  // ENABLE_MODEL_HOT_RELOAD
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG STORAGE BUFFERS                                                                         |
                  * |------------------------------------------------------------------------------------------------|
@@ -290,7 +371,19 @@ namespace Core {
                  * don't want to update the buffer in preparation of the next frame while a previous one is still reading
                  * from it. Thus, we need to have as many buffers as we have frames in flight, and write to a buffer that
                  * is not currently being read by the GPU
-                */
+                 *
+                 * Every model's instances are given a fixed slice of the instance arena, which is laid out like the
+                 * storage buffers, so that they can be written to the mapped buffers from where they live
+                */
+                readyInstanceArena (modelInfoIds);
+                if (getInstanceArenaSize() != sceneInfo->meta.totalInstancesCount) {
+                    LOG_ERROR (m_VKInitSequenceLog) << "Instance arena size mismatch "
+                                                    << "[" << getInstanceArenaSize() << "]"
+                                                    << "->"
+                                                    << "[" << sceneInfo->meta.totalInstancesCount << "]"
+                                                    << std::endl;
+                    throw std::runtime_error ("Instance arena size mismatch");
+                }
                 for (uint32_t i = 0; i < g_coreSettings.maxFramesInFlight; i++) {
                     uint32_t storageBufferInfoId = sceneInfo->id.storageBufferInfoBase + i;
                     createStorageBuffer (deviceInfoId,
@@ -301,6 +394,26 @@ namespace Core {
                                                    << "[" << storageBufferInfoId << "]"
                                                    << std::endl;
                 }
+                /* The static data of the instances (texture image info id look up tables, see StaticInstanceDataSSBO)
+                 * rarely changes, so instead of being written to every frame's storage buffer it is kept in a single
+                 * device local storage buffer. Changes are written to the frame's staging buffer and copied over in the
+                 * frame's command buffer (see VKDrawSequence), the first frame uploads all of it
+                */
+                sceneInfo->id.staticStorageBufferInfo     = getNextInfoIdFromBufferType (STORAGE_BUFFER);
+                sceneInfo->id.staticStagingBufferInfoBase = getNextInfoIdFromBufferType (STAGING_BUFFER);
+                createDeviceStorageBuffer (deviceInfoId,
+                                           sceneInfo->id.staticStorageBufferInfo,
+                                           sceneInfo->meta.totalInstancesCount * sizeof (StaticInstanceDataSSBO));
+                for (uint32_t i = 0; i < g_coreSettings.maxFramesInFlight; i++)
+                    createStorageStagingBuffer (deviceInfoId,
+                                                sceneInfo->id.staticStagingBufferInfoBase + i,
+                                                sceneInfo->meta.totalInstancesCount * sizeof (StaticInstanceDataSSBO));
+
+                LOG_INFO (m_VKInitSequenceLog) << "[OK] Static storage buffer "
+                                               << "[" << sceneInfo->id.staticStorageBufferInfo << "]"
+                                               << " "
+                                               << "[" << sceneInfo->id.staticStagingBufferInfoBase << "]"
+                                               << std::endl;
                 /* |------------------------------------------------------------------------------------------------|
                  * | READY RENDER PASS INFO                                                                         |
                  * |------------------------------------------------------------------------------------------------|
@@ -490,6 +603,32 @@ namespace Core {
                  * | CONFIG PIPELINE STATE - VERTEX INPUT                                                           |
                  * |------------------------------------------------------------------------------------------------|
                 */
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                /* The unsigned/signed normalized formats are read as floats in [0, 1]/[-1, 1] by the vertex shader, and
+                 * the half floats as floats
+                */
+                auto bindingDescriptions   = std::vector {
+                    getBindingDescription (0, sizeof (CompactVertex), VK_VERTEX_INPUT_RATE_VERTEX)
+                };
+                auto attributeDescriptions = std::vector {
+                    getAttributeDescription (0,
+                                             0,
+                                             offsetof (CompactVertex, pos),
+                                             VK_FORMAT_R16G16B16A16_UNORM),
+                    getAttributeDescription (0,
+                                             1,
+                                             offsetof (CompactVertex, texCoord),
+                                             VK_FORMAT_R16G16_SFLOAT),
+                    getAttributeDescription (0,
+                                             2,
+                                             offsetof (CompactVertex, normal),
+                                             VK_FORMAT_R8G8_SNORM),
+                    getAttributeDescription (0,
+                                             3,
+                                             offsetof (CompactVertex, texId),
+                                             VK_FORMAT_R8_UINT)
+                };
+#else
                 auto bindingDescriptions   = std::vector {
                     getBindingDescription (0, sizeof (Vertex), VK_VERTEX_INPUT_RATE_VERTEX)
                 };
@@ -511,6 +650,7 @@ namespace Core {
                                              offsetof (Vertex, texId),
                                              VK_FORMAT_R32_UINT)
                 };
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
                 createVertexInputState (pipelineInfoId, bindingDescriptions, attributeDescriptions);
                 /* |------------------------------------------------------------------------------------------------|
                  * | CONFIG PIPELINE STATE - INPUT ASSEMBLY                                                         |
@@ -604,6 +744,13 @@ namespace Core {
                 */
                 auto perFrameLayoutBindings = std::vector {
                     getLayoutBinding (0,
+                                      1,
+                                      VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                      VK_SHADER_STAGE_VERTEX_BIT,
+                                      VK_NULL_HANDLE),
+                    /* Static instance data, the same buffer in every frame's set
+                    */
+                    getLayoutBinding (1,
                                       1,
                                       VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
                                       VK_SHADER_STAGE_VERTEX_BIT,
@@ -639,6 +786,7 @@ namespace Core {
                  * it will not index into the unbound slots in the array
                 */
                 auto perFrameBindingFlags = std::vector <VkDescriptorBindingFlags> {
+                    g_pipelineSettings.descriptorSetLayout.bindingFlagsSSBO,
                     g_pipelineSettings.descriptorSetLayout.bindingFlagsSSBO
                 };
                 createDescriptorSetLayout (deviceInfoId,
@@ -734,7 +882,7 @@ namespace Core {
                 */
                 auto poolSizes = std::vector {
                     getPoolSize (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                 g_coreSettings.maxFramesInFlight),
+                                 g_coreSettings.maxFramesInFlight * 2),
 
                     getPoolSize (VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
                                  static_cast <uint32_t> (getTextureImagePool().size()))
@@ -774,13 +922,20 @@ namespace Core {
                  * |------------------------------------------------------------------------------------------------|
                 */
                 for (uint32_t i = 0; i < g_coreSettings.maxFramesInFlight; i++) {
-                    uint32_t storageBufferInfoId = sceneInfo->id.storageBufferInfoBase + i;
-                    auto bufferInfo              = getBufferInfo (storageBufferInfoId, STORAGE_BUFFER);
-                    auto descriptorBufferInfos   = std::vector {
+                    uint32_t storageBufferInfoId     = sceneInfo->id.storageBufferInfoBase + i;
+                    auto bufferInfo                  = getBufferInfo (storageBufferInfoId, STORAGE_BUFFER);
+                    auto descriptorBufferInfos       = std::vector {
                         getDescriptorBufferInfo (bufferInfo->resource.buffer,
                                                  0,
                                                  sceneInfo->meta.totalInstancesCount * sizeof (InstanceDataSSBO))
                     };
+                    auto staticBufferInfo            = getBufferInfo (sceneInfo->id.staticStorageBufferInfo,
+                                                                      STORAGE_BUFFER);
+                    auto staticDescriptorBufferInfos = std::vector {
+                        getDescriptorBufferInfo (staticBufferInfo->resource.buffer,
+                                                 0,
+                                                 sceneInfo->meta.totalInstancesCount * sizeof (StaticInstanceDataSSBO))
+                    };
 
                     /* The configuration of descriptors is updated using the vkUpdateDescriptorSets function, which takes
                      * an array of VkWriteDescriptorSet structs as parameter
@@ -789,7 +944,11 @@ namespace Core {
                         getWriteBufferDescriptorSetInfo (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
                                                          sceneInfo->resource.perFrameDescriptorSets[i],
                                                          descriptorBufferInfos,
-                                                         0, 0, 1)
+                                                         0, 0, 1),
+                        getWriteBufferDescriptorSetInfo (VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                                         sceneInfo->resource.perFrameDescriptorSets[i],
+                                                         staticDescriptorBufferInfos,
+                                                         1, 0, 1)
                     };
 
                     updateDescriptorSets (deviceInfoId, writeDescriptorSets);
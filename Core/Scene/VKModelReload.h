@@ -0,0 +1,497 @@
+#ifndef VK_MODEL_RELOAD_H
+#define VK_MODEL_RELOAD_H
+
+#include <future>
+#include <deque>
+#include "../Model/VKInstanceData.h"
+#include "../Model/VKModelWatcher.h"
+#include "../Buffer/VKBufferMgr.h"
+#include "../Cmd/VKCmdBuffer.h"
+#include "../Cmd/VKCmd.h"
+#include "VKSyncObject.h"
+
+namespace Core {
+    /* Models are reloaded one at a time, a reload goes through the stages in order
+     * (1) Import, the model files are imported into a model info of their own on a background thread
+     * (2) Upload, the new vertices and indices are copied from staging buffers into free ranges of the combined vertex
+     *     and index buffers on the transfer queue
+     * (3) Swap, once the copy is done the model's data and its offsets into the buffers are replaced at the start of a
+     *     frame, so every frame recorded from then on draws the new data
+     *
+     * The ranges the model was drawn from before are only freed once the frames in flight that may still read them are
+     * done, which is why the new data never overwrites the old in place. A model that grows or shrinks is simply given
+     * a range of its new size
+    */
+    class VKModelReload: protected virtual VKInstanceData,
+                         protected virtual VKBufferMgr,
+                         protected virtual VKCmdBuffer,
+                         protected virtual VKCmd,
+                         protected virtual VKSyncObject,
+                         protected VKModelWatcher {
+        private:
+            enum ReloadStage {
+                IDLE,
+                IMPORT,
+                UPLOAD
+            };
+
+            /* Range of bytes in a buffer
+            */
+            struct BufferRange {
+                VkDeviceSize offset;
+                VkDeviceSize size;
+            };
+
+            struct RetiredRange {
+                BufferRange range;
+                bool isVertexRange;
+                uint64_t freeFrameId;
+            };
+#if ENABLE_COMPACT_VERTEX_FORMAT
+            static constexpr VkDeviceSize VERTEX_SIZE = sizeof (CompactVertex);
+#else
+            static constexpr VkDeviceSize VERTEX_SIZE = sizeof (Vertex);
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+            /* The reloaded model is imported into a model info under this id, and the fence id is free since the
+             * transfer ops fences of the init sequence and the extensions are deleted once their transfers are done
+            */
+            static constexpr uint32_t RELOAD_MODEL_INFO_ID      = UINT32_MAX - 1;
+            static constexpr uint32_t TRANSFER_OPS_FENCE_INFO_ID = 1;
+
+            ReloadStage m_reloadStage;
+            uint32_t m_reloadTargetInfoId;
+            std::deque <uint32_t> m_pendingModelInfoIds;
+            std::future <void> m_importResult;
+
+            uint32_t m_vertexBufferInfoId;
+            uint32_t m_indexBufferInfoId;
+            std::vector <BufferRange> m_freeVertexRanges;
+            std::vector <BufferRange> m_freeIndexRanges;
+            std::vector <RetiredRange> m_retiredRanges;
+            /* Ranges of the upload in flight and the type of its indices
+            */
+            BufferRange m_vertexRange;
+            BufferRange m_indexRange;
+            VkIndexType m_indexType;
+            uint32_t m_vertexStagingBufferInfoId;
+            uint32_t m_indexStagingBufferInfoId;
+
+            VkCommandPool m_transferOpsCommandPool;
+            VkCommandBuffer m_transferOpsCommandBuffer;
+            uint64_t m_frameId;
+
+            Log::Record* m_VKModelReloadLog;
+            const uint32_t m_instanceId = g_collectionSettings.instanceId++;
+
+            /* First fit, the range is carved out of the first free range it fits into
+            */
+            static bool allocateRange (std::vector <BufferRange>& freeRanges,
+                                       VkDeviceSize size,
+                                       VkDeviceSize alignment,
+                                       BufferRange& range) {
+
+                for (auto it = freeRanges.begin(); it != freeRanges.end(); it++) {
+                    VkDeviceSize offset = (it->offset + alignment - 1) / alignment * alignment;
+                    VkDeviceSize end    = it->offset + it->size;
+                    if (offset + size > end)
+                        continue;
+
+                    BufferRange before = {it->offset,    offset - it->offset};
+                    BufferRange after  = {offset + size, end - offset - size};
+                    it = freeRanges.erase (it);
+                    if (after.size  != 0) it = freeRanges.insert (it, after);
+                    if (before.size != 0) it = freeRanges.insert (it, before);
+
+                    range = {offset, size};
+                    return true;
+                }
+                return false;
+            }
+
+            /* The free ranges are kept sorted by offset, and merged with the ranges next to them
+            */
+            static void freeRange (std::vector <BufferRange>& freeRanges, BufferRange range) {
+                if (range.size == 0)
+                    return;
+
+                auto it = std::lower_bound (freeRanges.begin(), freeRanges.end(), range,
+                                            [](const BufferRange& a, const BufferRange& b) {
+                                                return a.offset < b.offset;
+                                            });
+                it = freeRanges.insert (it, range);
+                if (it + 1 != freeRanges.end() && it->offset + it->size == (it + 1)->offset) {
+                    it->size += (it + 1)->size;
+                    freeRanges.erase (it + 1);
+                }
+                if (it != freeRanges.begin() && (it - 1)->offset + (it - 1)->size == it->offset) {
+                    (it - 1)->size += it->size;
+                    freeRanges.erase (it);
+                }
+            }
+
+            static VkDeviceSize getIndexBytesSize (uint32_t indicesCount, VkIndexType indexType) {
+                return indicesCount * (indexType == VK_INDEX_TYPE_UINT16 ? sizeof (uint16_t): sizeof (uint32_t));
+            }
+
+            /* Same as the staging buffer created along with the vertex and index buffers, see VKVertexBuffer
+            */
+            void createStagingBuffer (uint32_t deviceInfoId,
+                                      uint32_t bufferInfoId,
+                                      VkDeviceSize size,
+                                      const void* data) {
+
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto stagingBufferShareQueueFamilyIndices = std::vector {
+                    deviceInfo->meta.transferFamilyIndex.value()
+                };
+                createBuffer (deviceInfoId,
+                              bufferInfoId,
+                              STAGING_BUFFER,
+                              size,
+                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                              VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                              stagingBufferShareQueueFamilyIndices);
+
+                auto bufferInfo = getBufferInfo (bufferInfoId, STAGING_BUFFER);
+                vkMapMemory (deviceInfo->resource.logDevice,
+                             bufferInfo->resource.bufferMemory,
+                             0,
+                             size,
+                             0,
+                             &bufferInfo->meta.bufferMapped);
+                memcpy (bufferInfo->meta.bufferMapped, data, static_cast <size_t> (size));
+                vkUnmapMemory (deviceInfo->resource.logDevice, bufferInfo->resource.bufferMemory);
+            }
+
+            /* A changed model file reloads the model, and a changed .mtl file reloads every model that reads its .mtl
+             * files from the same directory
+            */
+            void queueChangedModels (const std::vector <uint32_t>& modelInfoIds) {
+                for (auto const& changedPath: getChangedModelFiles()) {
+                    std::filesystem::path path = changedPath;
+                    bool isMtlFile             = path.extension() == ".mtl";
+
+                    for (auto const& infoId: modelInfoIds) {
+                        auto modelInfo = getModelInfo (infoId);
+                        bool isChanged = isMtlFile ?
+                                         (std::filesystem::path (modelInfo->path.mtlFileDir) / "").lexically_normal() ==
+                                         (path.parent_path() / "").lexically_normal():
+                                         std::filesystem::path (modelInfo->path.model).lexically_normal() == path;
+                        if (!isChanged)
+                            continue;
+
+                        if (std::find (m_pendingModelInfoIds.begin(), m_pendingModelInfoIds.end(), infoId) ==
+                            m_pendingModelInfoIds.end())
+                            m_pendingModelInfoIds.push_back (infoId);
+                    }
+                }
+            }
+
+            void beginImport (void) {
+                m_reloadTargetInfoId = m_pendingModelInfoIds.front();
+                m_pendingModelInfoIds.pop_front();
+
+                auto modelInfo = getModelInfo (m_reloadTargetInfoId);
+                readyModelInfo (RELOAD_MODEL_INFO_ID, modelInfo->path.model, modelInfo->path.mtlFileDir);
+                /* No model info is added or deleted until the import is done, so the model info pool can be read from
+                 * both threads
+                */
+                m_importResult = std::async (std::launch::async, [this](void) {
+                    reimportOBJModel (RELOAD_MODEL_INFO_ID);
+                });
+                m_reloadStage  = IMPORT;
+
+                LOG_INFO (m_VKModelReloadLog) << "Reloading model "
+                                              << "[" << m_reloadTargetInfoId << "]"
+                                              << " "
+                                              << "[" << modelInfo->path.model << "]"
+                                              << std::endl;
+            }
+
+            void cancelReload (const char* reason) {
+                LOG_WARNING (m_VKModelReloadLog) << "Failed to reload model "
+                                                 << "[" << m_reloadTargetInfoId << "]"
+                                                 << " "
+                                                 << "[" << reason << "]"
+                                                 << std::endl;
+                VKModelMgr::cleanUp (RELOAD_MODEL_INFO_ID);
+                m_reloadStage = IDLE;
+            }
+
+            void beginUpload (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                auto modelInfo  = getModelInfo  (RELOAD_MODEL_INFO_ID);
+                if (modelInfo->meta.verticesCount == 0 || modelInfo->meta.indicesCount == 0) {
+                    cancelReload ("Empty model");
+                    return;
+                }
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                std::vector <CompactVertex> vertices;
+                VKVertexCompact::appendVertices (modelInfo->meta.vertices, modelInfo->meta.bounds, vertices);
+                size_t indexTypeVerticesCount = modelInfo->meta.verticesCount;
+#else
+                std::span <const Vertex> vertices = modelInfo->meta.vertices;
+                /* The index buffer is bound once for all the models, with 32 bit indices
+                */
+                size_t indexTypeVerticesCount = UINT32_MAX;
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+                std::vector <uint8_t> indexBytes;
+                m_indexType = VKVertexCompact::appendIndices ({modelInfo->meta.indices, modelInfo->meta.lodIndices},
+                                                              indexTypeVerticesCount,
+                                                              indexBytes).indexType;
+
+                if (!allocateRange (m_freeVertexRanges, vertices.size() * VERTEX_SIZE, VERTEX_SIZE, m_vertexRange)) {
+                    cancelReload ("Failed to find free range in vertex buffer");
+                    return;
+                }
+                /* The offset an index buffer is bound at has to be a multiple of the index size
+                */
+                if (!allocateRange (m_freeIndexRanges,  indexBytes.size(), sizeof (uint32_t), m_indexRange)) {
+                    freeRange (m_freeVertexRanges, m_vertexRange);
+                    cancelReload ("Failed to find free range in index buffer");
+                    return;
+                }
+
+                m_vertexStagingBufferInfoId = getNextInfoIdFromBufferType (STAGING_BUFFER);
+                createStagingBuffer (deviceInfoId, m_vertexStagingBufferInfoId, m_vertexRange.size, vertices.data());
+                m_indexStagingBufferInfoId  = getNextInfoIdFromBufferType (STAGING_BUFFER);
+                createStagingBuffer (deviceInfoId, m_indexStagingBufferInfoId,  m_indexRange.size,  indexBytes.data());
+                /* The copies only write to ranges that no frame reads from, so they run alongside the frames in flight
+                 * without a barrier. The vertex and index buffers are shared between the graphics and transfer queue
+                 * families, and the frames recorded after the fence is signaled see the written data
+                */
+                vkResetCommandBuffer (m_transferOpsCommandBuffer, 0);
+                beginRecording       (m_transferOpsCommandBuffer,
+                                      VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                                      VK_NULL_HANDLE);
+
+                copyBufferToBuffer   (m_vertexStagingBufferInfoId, m_vertexBufferInfoId,
+                                      STAGING_BUFFER, VERTEX_BUFFER,
+                                      0, m_vertexRange.offset,
+                                      m_transferOpsCommandBuffer);
+
+                copyBufferToBuffer   (m_indexStagingBufferInfoId,  m_indexBufferInfoId,
+                                      STAGING_BUFFER, INDEX_BUFFER,
+                                      0, m_indexRange.offset,
+                                      m_transferOpsCommandBuffer);
+
+                endRecording         (m_transferOpsCommandBuffer);
+
+                VkSubmitInfo transferOpsSubmitInfo{};
+                transferOpsSubmitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                transferOpsSubmitInfo.commandBufferCount = 1;
+                transferOpsSubmitInfo.pCommandBuffers    = &m_transferOpsCommandBuffer;
+                VkResult result = vkQueueSubmit (deviceInfo->resource.transferQueue,
+                                                 1,
+                                                 &transferOpsSubmitInfo,
+                                                 getFenceInfo (TRANSFER_OPS_FENCE_INFO_ID,
+                                                               FEN_TRANSFER_DONE)->resource.fence);
+                if (result != VK_SUCCESS) {
+                    LOG_ERROR (m_VKModelReloadLog) << "Failed to submit transfer ops command buffer "
+                                                   << "[" << deviceInfoId << "]"
+                                                   << " "
+                                                   << "[" << string_VkResult (result) << "]"
+                                                   << std::endl;
+                    throw std::runtime_error ("Failed to submit transfer ops command buffer");
+                }
+                m_reloadStage = UPLOAD;
+            }
+
+            void swapModel (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                vkResetFences (deviceInfo->resource.logDevice,
+                               1,
+                               &getFenceInfo (TRANSFER_OPS_FENCE_INFO_ID, FEN_TRANSFER_DONE)->resource.fence);
+                VKBufferMgr::cleanUp (deviceInfoId, m_vertexStagingBufferInfoId, STAGING_BUFFER);
+                VKBufferMgr::cleanUp (deviceInfoId, m_indexStagingBufferInfoId,  STAGING_BUFFER);
+
+                auto modelInfo  = getModelInfo (m_reloadTargetInfoId);
+                auto reloadInfo = getModelInfo (RELOAD_MODEL_INFO_ID);
+                auto& meta      = modelInfo->meta;
+                /* The frames recorded before this one may still be drawing from the old ranges
+                */
+                uint64_t freeFrameId = m_frameId + g_coreSettings.maxFramesInFlight;
+                m_retiredRanges.push_back ({{meta.vertexOffset * VERTEX_SIZE, meta.verticesCount * VERTEX_SIZE},
+                                            true,
+                                            freeFrameId});
+                m_retiredRanges.push_back ({{meta.indexSegment.offset,
+                                             getIndexBytesSize (meta.indicesCount +
+                                                                static_cast <uint32_t> (meta.lodIndices.size()),
+                                                                meta.indexSegment.indexType)},
+                                            false,
+                                            freeFrameId});
+                /* Moving the storage keeps the spans into it valid
+                */
+                auto& reloadMeta          = reloadInfo->meta;
+                meta.verticesStorage      = std::move (reloadMeta.verticesStorage);
+                meta.indicesStorage       = std::move (reloadMeta.indicesStorage);
+                meta.lodIndicesStorage    = std::move (reloadMeta.lodIndicesStorage);
+                meta.cacheMapping         = std::move (reloadMeta.cacheMapping);
+                meta.vertices             = reloadMeta.vertices;
+                meta.indices              = reloadMeta.indices;
+                meta.lodIndices           = reloadMeta.lodIndices;
+                meta.lods                 = std::move (reloadMeta.lods);
+                meta.meshlets             = std::move (reloadMeta.meshlets);
+                meta.bounds               = reloadMeta.bounds;
+                meta.verticesCount        = reloadMeta.verticesCount;
+                meta.indicesCount         = reloadMeta.indicesCount;
+                meta.vertexOffset         = static_cast <int32_t> (m_vertexRange.offset / VERTEX_SIZE);
+                meta.indexSegment         = {m_indexType, m_indexRange.offset};
+                /* Textures the model did not have before are looked up as themselves, the look up table entries of the
+                 * textures it already had are left as they are
+                */
+                for (auto const& texId: reloadInfo->id.diffuseTextureImageInfos) {
+                    auto const& texIds = modelInfo->id.diffuseTextureImageInfos;
+                    if (std::find (texIds.begin(), texIds.end(), texId) != texIds.end())
+                        continue;
+                    for (uint32_t i = 0; i < meta.instancesCount; i++)
+                        updateTexIdLUT (m_reloadTargetInfoId, i, texId, texId);
+                }
+                modelInfo->path.diffuseTextureImages     = std::move (reloadInfo->path.diffuseTextureImages);
+                modelInfo->id.diffuseTextureImageInfos   = std::move (reloadInfo->id.diffuseTextureImageInfos);
+#if ENABLE_COMPACT_VERTEX_FORMAT
+                for (uint32_t i = 0; i < meta.instancesCount; i++)
+                    createPositionDequant (m_reloadTargetInfoId, i);
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+                VKModelMgr::cleanUp (RELOAD_MODEL_INFO_ID);
+                m_reloadStage = IDLE;
+
+                LOG_INFO (m_VKModelReloadLog) << "Reloaded model "
+                                              << "[" << m_reloadTargetInfoId << "]"
+                                              << " "
+                                              << "[" << meta.verticesCount << "]"
+                                              << " "
+                                              << "[" << meta.indicesCount  << "]"
+                                              << " "
+                                              << "[" << meta.vertexOffset  << "]"
+                                              << " "
+                                              << "[" << meta.indexSegment.offset << "]"
+                                              << std::endl;
+            }
+
+        public:
+            VKModelReload (void) {
+                m_reloadStage              = IDLE;
+                m_reloadTargetInfoId       = UINT32_MAX;
+                m_vertexBufferInfoId       = UINT32_MAX;
+                m_indexBufferInfoId        = UINT32_MAX;
+                m_transferOpsCommandPool   = VK_NULL_HANDLE;
+                m_transferOpsCommandBuffer = VK_NULL_HANDLE;
+                m_frameId                  = 0;
+
+                m_VKModelReloadLog = LOG_INIT (m_instanceId, g_collectionSettings.logSaveDirPath);
+                LOG_ADD_CONFIG (m_instanceId, Log::INFO,    Log::TO_FILE_IMMEDIATE);
+                LOG_ADD_CONFIG (m_instanceId, Log::WARNING, Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+                LOG_ADD_CONFIG (m_instanceId, Log::ERROR,   Log::TO_FILE_IMMEDIATE | Log::TO_CONSOLE);
+            }
+
+            ~VKModelReload (void) {
+                LOG_CLOSE (m_instanceId);
+            }
+
+        protected:
+            /* The space after the used sizes of the vertex and index buffers is free for reloaded models
+            */
+            void readyModelReload (uint32_t deviceInfoId,
+                                   uint32_t vertexBufferInfoId,
+                                   VkDeviceSize usedVertexBufferSize,
+                                   uint32_t indexBufferInfoId,
+                                   VkDeviceSize usedIndexBufferSize) {
+
+                auto deviceInfo      = getDeviceInfo (deviceInfoId);
+                m_vertexBufferInfoId = vertexBufferInfoId;
+                m_indexBufferInfoId  = indexBufferInfoId;
+                m_freeVertexRanges.clear();
+                m_freeIndexRanges.clear();
+                freeRange (m_freeVertexRanges, {usedVertexBufferSize,
+                                                getBufferInfo (vertexBufferInfoId, VERTEX_BUFFER)->meta.size -
+                                                usedVertexBufferSize});
+                freeRange (m_freeIndexRanges,  {usedIndexBufferSize,
+                                                getBufferInfo (indexBufferInfoId,  INDEX_BUFFER)->meta.size -
+                                                usedIndexBufferSize});
+                /* The command buffer is recorded again for every reload, so it has to be resettable on its own
+                */
+                m_transferOpsCommandPool   = getCommandPool    (deviceInfoId,
+                                                                VK_COMMAND_POOL_CREATE_TRANSIENT_BIT |
+                                                                VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+                                                                deviceInfo->meta.transferFamilyIndex.value());
+                m_transferOpsCommandBuffer = getCommandBuffers (deviceInfoId,
+                                                                m_transferOpsCommandPool,
+                                                                1,
+                                                                VK_COMMAND_BUFFER_LEVEL_PRIMARY)[0];
+                createFence (deviceInfoId, TRANSFER_OPS_FENCE_INFO_ID, FEN_TRANSFER_DONE, 0);
+                startModelWatcher (g_coreSettings.modelWatchDirPath);
+            }
+
+            /* Run at the start of every frame that is going to be submitted, after its in flight fence was waited on.
+             * Nothing here waits on the device, a stage that is not done yet is checked again the next frame
+            */
+            void updateModelReloads (uint32_t deviceInfoId, const std::vector <uint32_t>& modelInfoIds) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                m_frameId++;
+                for (auto it = m_retiredRanges.begin(); it != m_retiredRanges.end();) {
+                    if (it->freeFrameId > m_frameId) {
+                        it++;
+                        continue;
+                    }
+                    freeRange (it->isVertexRange ? m_freeVertexRanges: m_freeIndexRanges, it->range);
+                    it = m_retiredRanges.erase (it);
+                }
+                queueChangedModels (modelInfoIds);
+
+                if (m_reloadStage == UPLOAD) {
+                    VkResult result = vkGetFenceStatus (deviceInfo->resource.logDevice,
+                                                        getFenceInfo (TRANSFER_OPS_FENCE_INFO_ID,
+                                                                      FEN_TRANSFER_DONE)->resource.fence);
+                    if (result != VK_SUCCESS)
+                        return;
+                    swapModel (deviceInfoId);
+                }
+
+                if (m_reloadStage == IMPORT) {
+                    if (m_importResult.wait_for (std::chrono::seconds (0)) != std::future_status::ready)
+                        return;
+                    /* A model file that fails to import (saved half way, for example) leaves the model as it is
+                    */
+                    try {
+                        m_importResult.get();
+                    }
+                    catch (const std::exception& e) {
+                        cancelReload (e.what());
+                        return;
+                    }
+                    beginUpload (deviceInfoId);
+                    return;
+                }
+
+                if (m_reloadStage == IDLE && !m_pendingModelInfoIds.empty())
+                    beginImport();
+            }
+
+            void cleanUpModelReload (uint32_t deviceInfoId) {
+                auto deviceInfo = getDeviceInfo (deviceInfoId);
+                stopModelWatcher();
+
+                if (m_reloadStage == IMPORT) {
+                    m_importResult.wait();
+                    VKModelMgr::cleanUp (RELOAD_MODEL_INFO_ID);
+                }
+                if (m_reloadStage == UPLOAD) {
+                    vkWaitForFences (deviceInfo->resource.logDevice,
+                                     1,
+                                     &getFenceInfo (TRANSFER_OPS_FENCE_INFO_ID, FEN_TRANSFER_DONE)->resource.fence,
+                                     VK_TRUE,
+                                     UINT64_MAX);
+                    VKBufferMgr::cleanUp (deviceInfoId, m_vertexStagingBufferInfoId, STAGING_BUFFER);
+                    VKBufferMgr::cleanUp (deviceInfoId, m_indexStagingBufferInfoId,  STAGING_BUFFER);
+                    VKModelMgr::cleanUp  (RELOAD_MODEL_INFO_ID);
+                }
+                m_reloadStage = IDLE;
+
+                cleanUpFence         (deviceInfoId, TRANSFER_OPS_FENCE_INFO_ID, FEN_TRANSFER_DONE);
+                VKCmdBuffer::cleanUp (deviceInfoId, m_transferOpsCommandPool);
+            }
+    };
+}   // namespace Core
+#endif  // VK_MODEL_RELOAD_H
\ No newline at end of file
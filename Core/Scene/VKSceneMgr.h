@@ -12,6 +12,14 @@ namespace Core {
             struct SceneInfo {
                 struct Meta {
                     uint32_t totalInstancesCount;
+                    /* Instance held in every slot of each frame in flight's copy of the instances in the storage buffer
+                     * (see InstanceSlotTracker), and the bytes written to the storage buffer in the last frame
+                    */
+                    std::vector <std::vector <uint64_t>> instanceSlotKeys;
+                    uint64_t instanceUploadBytes;
+                    /* Bytes of static instance data uploaded in the last frame
+                    */
+                    uint64_t staticInstanceUploadBytes;
                 } meta;
 
                 struct Id {
@@ -20,6 +28,11 @@ namespace Core {
                     uint32_t multiSampleImageInfo;
                     uint32_t uniformBufferInfoBase;
                     uint32_t storageBufferInfoBase;
+                    /* Device local storage buffer holding the static instance data, and its staging buffers (one per
+                     * frame in flight). Picked when the buffers are created
+                    */
+                    uint32_t staticStorageBufferInfo;
+                    uint32_t staticStagingBufferInfoBase;
                     uint32_t inFlightFenceInfoBase;
                     uint32_t imageAvailableSemaphoreInfoBase;
                     uint32_t renderDoneSemaphoreInfoBase;
@@ -84,11 +97,16 @@ namespace Core {
 
                 SceneInfo info{};
                 info.meta.totalInstancesCount           = totalInstancesCount;
+                info.meta.instanceUploadBytes           = 0;
+                info.meta.staticInstanceUploadBytes     = 0;
+                info.meta.instanceSlotKeys.resize (g_coreSettings.maxFramesInFlight);
                 info.id.swapChainImageInfoBase          = swapChainImageInfoBase;
                 info.id.depthImageInfo                  = depthImageInfo;
                 info.id.multiSampleImageInfo            = multiSampleImageInfo;
                 info.id.uniformBufferInfoBase           = uniformBufferInfoBase;
                 info.id.storageBufferInfoBase           = storageBufferInfoBase;
+                info.id.staticStorageBufferInfo         = UINT32_MAX;
+                info.id.staticStagingBufferInfoBase     = UINT32_MAX;
                 info.id.inFlightFenceInfoBase           = inFlightFenceInfoBase;
                 info.id.imageAvailableSemaphoreInfoBase = imageAvailableSemaphoreInfoBase;
                 info.id.renderDoneSemaphoreInfoBase     = renderDoneSemaphoreInfoBase;
@@ -138,6 +156,14 @@ namespace Core {
                                                << "[" << val.id.storageBufferInfoBase << "]"
                                                << std::endl;
 
+                    LOG_INFO (m_VKSceneMgrLog) << "Static storage buffer info id "
+                                               << "[" << val.id.staticStorageBufferInfo << "]"
+                                               << std::endl;
+
+                    LOG_INFO (m_VKSceneMgrLog) << "Static staging buffer info id base "
+                                               << "[" << val.id.staticStagingBufferInfoBase << "]"
+                                               << std::endl;
+
                     LOG_INFO (m_VKSceneMgrLog) << "In flight fence info id base "
                                                << "[" << val.id.inFlightFenceInfoBase << "]"
                                                << std::endl;
@@ -2,6 +2,7 @@
 #define VK_UNIFORM_H
 
 #include <glm/glm.hpp>
+#include "../VKConfig.h"
 
 namespace Core {
     /* Alignment requirements specifies how exactly the data in the C++ structure should match with the uniform definition
@@ -99,8 +100,50 @@ namespace Core {
      * For example, a mat3 may be padded internally to take 12 floats of space arranged as
      * [x0, y0, z0, pad][x1, y1, z1, pad][x2, y2, z2, pad]
     */
+    /* Instance data written to the storage buffer of a frame in flight, kept to what may change every frame. The rest
+     * of the instance's data is in its static data (see StaticInstanceDataSSBO), which is only uploaded when it changes
+     *
+     * The struct is padded to its 16 byte alignment, the stride of an array of it in std430. The transform is laid out
+     * as picked by INSTANCE_TRANSFORM_FORMAT (see VKInstanceTransform)
+    */
     struct InstanceDataSSBO {
+#if INSTANCE_TRANSFORM_FORMAT == INSTANCE_TRANSFORM_AFFINE_3X4
+        /* Rows of the model matrix, the 4th row is always (0, 0, 0, 1)
+        */
+        glm::vec4 modelRows[3];
+#elif INSTANCE_TRANSFORM_FORMAT == INSTANCE_TRANSFORM_QUATERNION
+        /* Unit quaternion (x, y, z, w). The model matrix is translate * rotate * scale. Note that, a vec3 followed by a
+         * scalar is laid out the same in std430 and in C++ (the scalar takes the 4th component), the w component of
+         * the scale is unused
+        */
+        glm::vec4 rotation;
+        glm::vec3 translation;
+        /* Index of the instance's static data in the static instance data buffer
+        */
+        uint32_t staticDataIdx;
+        glm::vec4 scale;
+#else
         glm::mat4 modelMatrix;
+#endif  // INSTANCE_TRANSFORM_FORMAT
+#if INSTANCE_TRANSFORM_FORMAT != INSTANCE_TRANSFORM_QUATERNION
+        /* Index of the instance's static data in the static instance data buffer
+        */
+        uint32_t staticDataIdx;
+        uint32_t padding[3];
+#endif  // INSTANCE_TRANSFORM_FORMAT
+    };
+
+    /* Instance data that only changes on request, kept in one device local buffer shared by the frames in flight and
+     * uploaded to it through a staging buffer when it does
+    */
+    struct StaticInstanceDataSSBO {
+#if ENABLE_COMPACT_VERTEX_FORMAT
+        /* Model space position of a compact vertex is positionOffset + quantized position * positionScale, the same for
+         * every instance of a model (the w components are unused)
+        */
+        glm::vec4 positionOffset;
+        glm::vec4 positionScale;
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
         /* The texture image info id look up table is an array of 32 bit unsigned integers as shown below. We can pack 4
          * info ids into 32 bits (a packet) if we assume a maximum id value of UINT8_MAX
          * |--------|--------|--------|--------|
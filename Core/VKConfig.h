@@ -8,6 +8,59 @@
 namespace Core {
     #define ENABLE_LOGGING                                           (true)
     #define ENABLE_AUTO_PICK_QUEUE_FAMILY_INDICES                    (true)
+    /* Deduplicated vertex and index data of imported models is cached on disk (see VKModelCache), a model whose file,
+     * .mtl files and texture image info ids are unchanged since the last import is mapped from its cache file instead
+     * of being parsed
+    */
+    #define ENABLE_MODEL_CACHE                                       (true)
+    /* Model files are read with the engine's own parser (see VKOBJParser), which splits the file across the worker pool
+     * and skips the intermediate shapes built by tinyobjloader
+    */
+    #define ENABLE_NATIVE_OBJ_PARSER                                 (true)
+    /* Triangles and vertices of imported models are reordered for the post transform vertex cache and for vertex fetch
+     * locality (see VKMeshOptimizer), the cache miss ratios before and after are logged per model
+    */
+    #define ENABLE_MESH_OPTIMIZATION                                 (true)
+    /* Levels of detail are generated for every model at import (see VKMeshSimplifier), and every instance is drawn at
+     * the level picked for its distance to the camera
+    */
+    #define ENABLE_MESH_LOD                                          (true)
+    /* Models are split into clusters of triangles at import (see VKMeshlet), and every instance drawn at full detail
+     * only draws the clusters that are inside the view frustum (and facing the camera, when back faces are culled)
+    */
+    #define ENABLE_MESHLET_CULLING                                   (true)
+    /* Model and .mtl files under the model watch directory are watched for changes (see VKModelWatcher), a changed
+     * model is imported again in the background and its data re-uploaded to the vertex and index buffers between two
+     * frames (see VKModelReload)
+    */
+    #define ENABLE_MODEL_HOT_RELOAD                                  (true)
+    /* Vertices are uploaded as 16 byte compact vertices (see VKVertexCompact) instead of the 36 byte Vertex, and models
+     * with fewer than UINT16_MAX vertices get 16 bit indices. The shaders are compiled with the same define (see the
+     * Makefile), so the flag is set from there. Off by default, build with COMPACT_VERTEX_FORMAT=1 to opt in
+    */
+#ifndef ENABLE_COMPACT_VERTEX_FORMAT
+    #define ENABLE_COMPACT_VERTEX_FORMAT                             (false)
+#endif  // ENABLE_COMPACT_VERTEX_FORMAT
+    /* Layout of the instance transforms in the storage buffer (see InstanceDataSSBO), the model matrices on the host
+     * stay 4x4 matrices whichever is picked
+     * (0) 4x4 model matrix, 80 byte instances
+     * (1) Top three rows of the model matrix (3x4 row major affine), 64 byte instances
+     * (2) Rotation quaternion, translation and scale, 48 byte instances
+     * Like the vertex format, the shaders are compiled with the same define (see the Makefile). The 4x4 model matrix is
+     * the default, the other two are opt in
+    */
+    #define INSTANCE_TRANSFORM_MAT4                                  (0)
+    #define INSTANCE_TRANSFORM_AFFINE_3X4                            (1)
+    #define INSTANCE_TRANSFORM_QUATERNION                            (2)
+#ifndef INSTANCE_TRANSFORM_FORMAT
+    #define INSTANCE_TRANSFORM_FORMAT                                INSTANCE_TRANSFORM_MAT4
+#endif  // INSTANCE_TRANSFORM_FORMAT
+    /* With logging disabled, log statements are stripped at compile time instead of only having their configs cleared
+     * at run time
+    */
+#if !ENABLE_LOGGING && !defined (LOG_MIN_LEVEL)
+    #define LOG_MIN_LEVEL                                            (8)
+#endif  // ENABLE_LOGGING
 
     struct CollectionSettings {
         /* Collection instance id range assignments
@@ -129,6 +182,31 @@ namespace Core {
         */
         const uint32_t maxFramesInFlight                             = 2;
         const char* defaultDiffuseTexturePath                        = "Asset/Texture/tex_16x16_empty.png";
+        const char* modelCacheDirPath                                = "Build/Cache/Model/";
+        /* Every level of detail aims for lodIndicesRatio of the indices of the level before it, without moving the
+         * surface by more than lodMaxError (relative to the model size). Levels that would not get below 90% of the
+         * level before them are not generated. An instance is drawn at level n once its distance to the camera is more
+         * than lodDistanceFactor * 2^(n - 1) times the radius of its bounding sphere
+        */
+        const uint32_t maxLODsCount                                  = 4;
+        const float lodIndicesRatio                                  = 0.5f;
+        const float lodMaxError                                      = 0.02f;
+        const float lodDistanceFactor                                = 8.0f;
+        /* Limits of a cluster of triangles, small enough that a model breaks up into clusters that can be culled on
+         * their own but not so small that drawing the clusters takes a lot of draw calls
+        */
+        const uint32_t maxMeshletVerticesCount                       = 64;
+        const uint32_t maxMeshletTrianglesCount                      = 124;
+        /* Reloaded models are uploaded to free space in the vertex and index buffers, and the space they were drawn
+         * from is freed once the frames in flight are done with it. The free space left at the end of the buffers is
+         * modelReloadReserveRatio times the size of the data uploaded at init
+        */
+        const char* modelWatchDirPath                                = "Asset/Model/";
+        const uint32_t modelWatchIntervalMs                          = 250;
+        const float modelReloadReserveRatio                          = 0.5f;
+        /* Number of instances a worker creates the model matrices of in one go when importing instance data
+        */
+        const uint32_t instanceBatchSize                             = 1024;
     } g_coreSettings;
 }   // namespace Core
 #endif  // VK_CONFIG_H
\ No newline at end of file
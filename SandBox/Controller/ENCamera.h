@@ -419,7 +419,7 @@ namespace SandBox {
                     throw std::runtime_error ("Invalid model instance id");
                 }
 
-                glm::mat4 modelMatrix = modelInfo->meta.instances[modelInstanceId].modelMatrix;
+                glm::mat4 modelMatrix = modelInfo->meta.modelMatrices[modelInstanceId];
                 /* Why do we need to remove the model transformation that was done to the camera vectors before using
                  * them in drone follow mode? The reason is, when we switch to drone follow mode, we use the camera
                  * vectors from the previous mode, which have already been multiplied by the model matrix. But, what
@@ -660,7 +660,7 @@ namespace SandBox {
 
                 updateUniformBuffer (skyBoxSceneInfo->id.uniformBufferInfoBase + currentFrameInFlight,
                                      skyBoxSceneInfo->meta.totalInstancesCount * sizeof (glm::mat4),
-                                     &skyBoxModelInfo->meta.instances[0].modelMatrix);
+                                     skyBoxModelInfo->meta.modelMatrices.data());
 
                 Core::SceneDataVertPC sceneDataVert;
                 sceneDataVert.viewMatrix       = cameraInfo->transform.viewMatrix;
@@ -79,6 +79,19 @@
 /* The #version directive must appear before anything else in a shader, save for whitespace and comments
 */
 #version 450
+/* Set by the Makefile to match the C++ sources, see ENABLE_COMPACT_VERTEX_FORMAT in VKConfig.h
+*/
+#ifndef ENABLE_COMPACT_VERTEX_FORMAT
+#define ENABLE_COMPACT_VERTEX_FORMAT 0
+#endif
+/* Set by the Makefile to match the C++ sources, see INSTANCE_TRANSFORM_FORMAT in VKConfig.h
+*/
+#define INSTANCE_TRANSFORM_MAT4         0
+#define INSTANCE_TRANSFORM_AFFINE_3X4   1
+#define INSTANCE_TRANSFORM_QUATERNION   2
+#ifndef INSTANCE_TRANSFORM_FORMAT
+#define INSTANCE_TRANSFORM_FORMAT INSTANCE_TRANSFORM_MAT4
+#endif
 /* The vertex shader takes input from a vertex buffer using the in keyword. The input variables are the vertex attributes.
  * They're properties that are specified per-vertex in the vertex buffer
  *
@@ -88,10 +101,20 @@
  * Whereas, the fragment shader outputs can specify the 'buffer index' that a particular output writes to. For example,
  * layout (location = output index) out vec4 outColor;
 */
+#if ENABLE_COMPACT_VERTEX_FORMAT
+/* Compact vertex (see VKVertexCompact.h), the normalized formats arrive as floats in [0, 1] (position) and [-1, 1]
+ * (normal) and the half float texture coordinates as floats
+*/
+layout (location = 0) in vec4 inPosition;
+layout (location = 1) in vec2 inTexCoord;
+layout (location = 2) in vec2 inNormal;
+layout (location = 3) in uint inTexId;
+#else
 layout (location = 0) in vec3 inPosition;
 layout (location = 1) in vec2 inTexCoord;
 layout (location = 2) in vec3 inNormal;
 layout (location = 3) in uint inTexId;
+#endif
 /* Add outputs from the vertex shader
 */
 layout (location = 0) out vec2 fragTexCoord;
@@ -100,7 +123,27 @@ layout (location = 1) out uint fragTexId;
  * location directive for attributes. We're going to reference this binding in the descriptor layout
 */
 struct InstanceDataSSBO {
+#if INSTANCE_TRANSFORM_FORMAT == INSTANCE_TRANSFORM_AFFINE_3X4
+    vec4 modelRows[3];
+#elif INSTANCE_TRANSFORM_FORMAT == INSTANCE_TRANSFORM_QUATERNION
+    vec4 rotation;
+    vec3 translation;
+#else
     mat4 modelMatrix;
+#endif
+    uint staticDataIdx;
+#if INSTANCE_TRANSFORM_FORMAT == INSTANCE_TRANSFORM_QUATERNION
+    vec4 scale;
+#endif
+};
+/* Instance data that only changes on request is held in a buffer of its own (see StaticInstanceDataSSBO in VKUniform.h),
+ * indexed by the instance's static data index
+*/
+struct StaticInstanceDataSSBO {
+#if ENABLE_COMPACT_VERTEX_FORMAT
+    vec4 positionOffset;
+    vec4 positionScale;
+#endif
     uint texIdLUT[64];
 };
 
@@ -108,11 +151,68 @@ layout (set = 0, binding = 0) readonly buffer InstanceData {
     InstanceDataSSBO instances[];
 } instanceData;
 
+layout (set = 0, binding = 1) readonly buffer StaticInstanceData {
+    StaticInstanceDataSSBO staticInstances[];
+} staticInstanceData;
+
 layout (push_constant) uniform SceneDataVertPC {
     mat4 viewMatrix;
     mat4 projectionMatrix;
 } sceneDataVert;
 
+#if ENABLE_COMPACT_VERTEX_FORMAT
+/* The position is dequantized with the bounding box of the model it belongs to
+*/
+vec3 decodePosition (uint staticDataIdx) {
+    return staticInstanceData.staticInstances[staticDataIdx].positionOffset.xyz +
+           staticInstanceData.staticInstances[staticDataIdx].positionScale.xyz * inPosition.xyz;
+}
+
+/* The octahedral encoded normal is unfolded back onto the unit sphere, the lower half (z < 0) was folded over the
+ * diagonals onto the corners of the square
+*/
+vec3 decodeNormal (void) {
+    vec3 normal = vec3 (inNormal, 1.0 - abs (inNormal.x) - abs (inNormal.y));
+    float fold  = max (-normal.z, 0.0);
+    normal.x   += normal.x >= 0.0 ? -fold: fold;
+    normal.y   += normal.y >= 0.0 ? -fold: fold;
+    return normalize (normal);
+}
+#else
+vec3 decodePosition (uint staticDataIdx) {
+    return inPosition;
+}
+
+vec3 decodeNormal (void) {
+    return inNormal;
+}
+#endif
+
+/* Model space to world space, with the instance transform laid out as picked by INSTANCE_TRANSFORM_FORMAT (see
+ * VKInstanceTransform.h)
+*/
+#if INSTANCE_TRANSFORM_FORMAT == INSTANCE_TRANSFORM_AFFINE_3X4
+vec4 transformPosition (vec3 position) {
+    vec4 modelPosition = vec4 (position, 1.0);
+    return vec4 (dot (instanceData.instances[gl_InstanceIndex].modelRows[0], modelPosition),
+                 dot (instanceData.instances[gl_InstanceIndex].modelRows[1], modelPosition),
+                 dot (instanceData.instances[gl_InstanceIndex].modelRows[2], modelPosition), 1.0);
+}
+#elif INSTANCE_TRANSFORM_FORMAT == INSTANCE_TRANSFORM_QUATERNION
+/* Scale, then rotate by the unit quaternion q (v' = v + 2 * cross (q.xyz, cross (q.xyz, v) + q.w * v)), then translate
+*/
+vec4 transformPosition (vec3 position) {
+    vec4 rotation = instanceData.instances[gl_InstanceIndex].rotation;
+    vec3 scaled   = position * instanceData.instances[gl_InstanceIndex].scale.xyz;
+    vec3 rotated  = scaled + 2.0 * cross (rotation.xyz, cross (rotation.xyz, scaled) + rotation.w * scaled);
+    return vec4 (rotated + instanceData.instances[gl_InstanceIndex].translation, 1.0);
+}
+#else
+vec4 transformPosition (vec3 position) {
+    return instanceData.instances[gl_InstanceIndex].modelMatrix * vec4 (position, 1.0);
+}
+#endif
+
 /* The main function is invoked for every vertex, the built-in gl_VertexIndex variable contains the index of the current
  * vertex. This is usually an index into the vertex buffer
 */
@@ -123,10 +223,11 @@ void main (void) {
      * coordinates may not be 1 after model transform calculations, which will result in a division when converted to
      * the final normalized device coordinates on the screen
     */
+    uint staticDataIdx = instanceData.instances[gl_InstanceIndex].staticDataIdx;
+
     gl_Position    = sceneDataVert.projectionMatrix *
                      sceneDataVert.viewMatrix       *
-                     instanceData.instances[gl_InstanceIndex].modelMatrix *
-                     vec4 (inPosition, 1.0);
+                     transformPosition (decodePosition (staticDataIdx));
 
     fragTexCoord   = inTexCoord;
     /* Decode packet
@@ -134,7 +235,7 @@ void main (void) {
     uint readIdx   = inTexId / 4;
     uint offsetIdx = inTexId % 4;
     uint mask      = 255 << offsetIdx * 8;
-    uint packet    = instanceData.instances[gl_InstanceIndex].texIdLUT[readIdx];
+    uint packet    = staticInstanceData.staticInstances[staticDataIdx].texIdLUT[readIdx];
     uint newTexId  = (packet & mask) >> offsetIdx * 8;
 
     fragTexId      = newTexId;
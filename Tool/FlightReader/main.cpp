@@ -0,0 +1,113 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include "../../Collection/Log/MappedRing.h"
+
+/* Reassembles the entries held in a mapped circular sink file (TO_FILE_MAPPED_CIRCULAR) in the order they were logged.
+ * The file can be read while the process is still running or after it has crashed, slots that were being written at
+ * the time are skipped
+ *
+ * Usage: flight_reader_exe <input .ring file> [output file]
+ * If the output file is not specified, the entries are written to stdout
+*/
+namespace Tool {
+    using namespace Collection::Log;
+
+    class FlightReader {
+        private:
+            struct Entry {
+                uint64_t sequence;
+                std::string text;
+            };
+
+            MappedRingFormat::FileHeader m_fileHeader;
+            std::vector <Entry> m_entries;
+
+        public:
+            FlightReader (const char* filePath) {
+                std::ifstream file (filePath, std::ios_base::in | std::ios_base::binary);
+                if (!file.is_open())
+                    throw std::runtime_error ("Failed to open input file");
+
+                std::vector <char> contents ((std::istreambuf_iterator <char> (file)),
+                                              std::istreambuf_iterator <char>());
+                if (contents.size() < MappedRingFormat::FILE_HEADER_SIZE)
+                    throw std::runtime_error ("Input file is too small");
+
+                memcpy (&m_fileHeader, contents.data(), sizeof (m_fileHeader));
+                if (memcmp (m_fileHeader.magic, MappedRingFormat::MAGIC, sizeof (MappedRingFormat::MAGIC)) != 0)
+                    throw std::runtime_error ("Input file is not a mapped ring");
+                if (m_fileHeader.version != MappedRingFormat::VERSION)
+                    throw std::runtime_error ("Unsupported mapped ring version");
+
+                size_t slotSize    = m_fileHeader.slotSize;
+                size_t textSize    = slotSize - sizeof (MappedRingFormat::SlotHeader);
+                size_t expectedEnd = MappedRingFormat::FILE_HEADER_SIZE + slotSize * m_fileHeader.slotCount;
+                if (slotSize <= sizeof (MappedRingFormat::SlotHeader) || contents.size() < expectedEnd)
+                    throw std::runtime_error ("Input file is truncated");
+
+                for (uint32_t i = 0; i < m_fileHeader.slotCount; i++) {
+                    const char* slot = contents.data() + MappedRingFormat::FILE_HEADER_SIZE + i * slotSize;
+                    uint64_t sequence;
+                    uint32_t length;
+                    memcpy (&sequence, slot,                    sizeof (sequence));
+                    memcpy (&length,   slot + sizeof (sequence), sizeof (length));
+                    /* Empty slot, or slot that was being written when the process went down
+                    */
+                    if (sequence == 0 || length > textSize)
+                        continue;
+
+                    m_entries.push_back ({sequence,
+                                          std::string (slot + sizeof (MappedRingFormat::SlotHeader), length)});
+                }
+
+                std::sort (m_entries.begin(), m_entries.end(), [](const Entry& a, const Entry& b) {
+                    return a.sequence < b.sequence;
+                });
+            }
+
+            void dump (std::ostream& ost) {
+                uint64_t skippedCount = 0;
+                for (size_t i = 0; i < m_entries.size(); i++) {
+                    /* A gap in the middle of the ring is an entry which was being overwritten
+                    */
+                    if (i != 0 && m_entries[i].sequence != m_entries[i - 1].sequence + 1)
+                        skippedCount += m_entries[i].sequence - m_entries[i - 1].sequence - 1;
+                    ost << m_entries[i].text << "\n";
+                }
+
+                std::cerr << "[OK] instance "  << m_fileHeader.instanceId
+                          << ", "              << m_entries.size() << " entries";
+                if (!m_entries.empty())
+                    std::cerr << " [" << m_entries.front().sequence << ", " << m_entries.back().sequence << "]";
+                if (skippedCount != 0)
+                    std::cerr << ", " << skippedCount << " incomplete";
+                std::cerr << std::endl;
+            }
+    };
+}   // namespace Tool
+
+int main (int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <input .ring file> [output file]" << std::endl;
+        return 1;
+    }
+
+    try {
+        Tool::FlightReader reader (argv[1]);
+        if (argc > 2) {
+            std::ofstream outputFile (argv[2]);
+            if (!outputFile.is_open())
+                throw std::runtime_error ("Failed to open output file");
+            reader.dump (outputFile);
+        }
+        else
+            reader.dump (std::cout);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
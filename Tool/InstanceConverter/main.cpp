@@ -0,0 +1,169 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <limits>
+#include <iomanip>
+#include <cstring>
+#include <filesystem>
+#include "../../Core/Model/VKInstanceFormat.h"
+
+/* Converts an instance data file (*_Instances.json) to the binary instance data format (*_Instances.bin) read by
+ * importInstanceData, or a binary file back to json. The direction is picked from the extension of the input file
+ *
+ * Usage: instance_converter_exe <input file> [output file]
+ * If the output file is not specified, it is written next to the input file with the other extension
+*/
+namespace Tool {
+    using namespace Core;
+
+    class InstanceConverter {
+        private:
+            std::vector <InstanceDataFormat::Record> m_records;
+            bool m_isBinaryInput;
+
+            void readJson (const char* filePath) {
+                std::ifstream file (filePath, std::ios_base::in | std::ios_base::binary);
+                if (!file.is_open())
+                    throw std::runtime_error ("Failed to open input file");
+                /* Instances that are not in the file are left with the defaults
+                */
+                InstanceDataJsonReader reader (
+                    [&](uint32_t instancesCount) {
+                        m_records.assign (instancesCount, {{0.0f, 0.0f, 0.0f},
+                                                           {0.0f, 1.0f, 0.0f},
+                                                           {1.0f, 1.0f, 1.0f}, 0.0f});
+                        return true;
+                    },
+                    [&](uint32_t modelInstanceId, const InstanceDataFormat::Record& record) {
+                        if (modelInstanceId >= m_records.size())
+                            return false;
+                        m_records[modelInstanceId] = record;
+                        return true;
+                    }
+                );
+                if (!nlohmann::json::sax_parse (file, &reader))
+                    throw std::runtime_error (reader.getErrorMessage().empty() ? "Failed to parse input file":
+                                                                                 reader.getErrorMessage());
+            }
+
+            void readBinary (const char* filePath) {
+                std::ifstream file (filePath, std::ios_base::in | std::ios_base::binary);
+                if (!file.is_open())
+                    throw std::runtime_error ("Failed to open input file");
+
+                std::vector <char> contents ((std::istreambuf_iterator <char> (file)),
+                                              std::istreambuf_iterator <char>());
+                if (contents.size() < InstanceDataFormat::FILE_HEADER_SIZE)
+                    throw std::runtime_error ("Input file is too small");
+
+                InstanceDataFormat::FileHeader fileHeader;
+                memcpy (&fileHeader, contents.data(), sizeof (fileHeader));
+                if (memcmp (fileHeader.magic, InstanceDataFormat::MAGIC, sizeof (InstanceDataFormat::MAGIC)) != 0)
+                    throw std::runtime_error ("Input file is not an instance data file");
+                if (fileHeader.version    != InstanceDataFormat::VERSION ||
+                    fileHeader.recordSize != sizeof (InstanceDataFormat::Record))
+                    throw std::runtime_error ("Unsupported instance data version");
+
+                uint64_t recordsSize = static_cast <uint64_t> (fileHeader.instancesCount) * fileHeader.recordSize;
+                /* Compared against the size left after the offset, so that a huge offset can not wrap the sum around
+                */
+                if (fileHeader.fileSize      != contents.size() ||
+                    fileHeader.recordsOffset  > contents.size() ||
+                    recordsSize               > contents.size() - fileHeader.recordsOffset)
+                    throw std::runtime_error ("Input file is truncated");
+
+                m_records.resize (fileHeader.instancesCount);
+                memcpy (m_records.data(), contents.data() + fileHeader.recordsOffset, recordsSize);
+            }
+
+            void writeJson (std::ostream& ost) {
+                /* Enough digits for the floats to read back the same
+                */
+                ost << std::setprecision (std::numeric_limits <float>::max_digits10);
+                auto writeVector = [&](const char* key, const float* vector) {
+                    ost << "            \"" << key << "\": "
+                        << "[" << vector[0] << ", " << vector[1] << ", " << vector[2] << "],\n";
+                };
+
+                ost << "{\n    \"instancesCount\": " << m_records.size() << ",\n    \"instances\": [\n";
+                for (size_t i = 0; i < m_records.size(); i++) {
+                    ost << "        {\n"
+                        << "            \"id\": " << i << ",\n";
+                    writeVector ("position",   m_records[i].position);
+                    writeVector ("rotateAxis", m_records[i].rotateAxis);
+                    writeVector ("scale",      m_records[i].scale);
+                    ost << "            \"rotateAngleDeg\": " << m_records[i].rotateAngleDeg << "\n"
+                        << "        }" << (i + 1 == m_records.size() ? "\n": ",\n");
+                }
+                ost << "    ]\n}\n";
+            }
+
+            void writeBinary (std::ostream& ost) {
+                uint64_t recordsSize = m_records.size() * sizeof (InstanceDataFormat::Record);
+
+                InstanceDataFormat::FileHeader fileHeader {};
+                memcpy (fileHeader.magic, InstanceDataFormat::MAGIC, sizeof (InstanceDataFormat::MAGIC));
+                fileHeader.version        = InstanceDataFormat::VERSION;
+                fileHeader.recordSize     = sizeof (InstanceDataFormat::Record);
+                fileHeader.instancesCount = static_cast <uint32_t> (m_records.size());
+                fileHeader.recordsOffset  = InstanceDataFormat::FILE_HEADER_SIZE;
+                fileHeader.fileSize       = InstanceDataFormat::FILE_HEADER_SIZE + recordsSize;
+
+                char header[InstanceDataFormat::FILE_HEADER_SIZE] = {};
+                memcpy (header, &fileHeader, sizeof (fileHeader));
+                ost.write (header, sizeof (header));
+                ost.write (reinterpret_cast <const char*> (m_records.data()), static_cast <std::streamsize> (recordsSize));
+            }
+
+        public:
+            InstanceConverter (const char* filePath) {
+                m_isBinaryInput = std::filesystem::path (filePath).extension() == InstanceDataFormat::FILE_EXTENSION;
+                if (m_isBinaryInput)
+                    readBinary (filePath);
+                else
+                    readJson   (filePath);
+            }
+
+            bool isBinaryInput (void) {
+                return m_isBinaryInput;
+            }
+
+            void convert (const std::string& filePath) {
+                std::ofstream file (filePath, std::ios_base::out | std::ios_base::binary);
+                if (!file.is_open())
+                    throw std::runtime_error ("Failed to open output file");
+
+                if (m_isBinaryInput)
+                    writeJson   (file);
+                else
+                    writeBinary (file);
+                if (!file)
+                    throw std::runtime_error ("Failed to write output file");
+
+                std::cerr << "[OK] " << m_records.size() << " instances"
+                          << " -> "  << filePath
+                          << std::endl;
+            }
+    };
+}   // namespace Tool
+
+int main (int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <input file> [output file]" << std::endl;
+        return 1;
+    }
+
+    try {
+        Tool::InstanceConverter converter (argv[1]);
+        std::string outputFilePath = argc > 2 ? std::string (argv[2]):
+                                     std::filesystem::path (argv[1]).replace_extension (
+                                        converter.isBinaryInput() ? ".json":
+                                                                    Core::InstanceDataFormat::FILE_EXTENSION).string();
+        converter.convert (outputFilePath);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
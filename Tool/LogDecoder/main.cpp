@@ -0,0 +1,235 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cstring>
+#include <unordered_map>
+#include <chrono>
+#include <ctime>
+#include "../../Collection/Log/BinaryFormat.h"
+
+/* Reconstructs the text log from a file written by the binary sink (TO_FILE_BINARY). The output matches what the text
+ * sinks would have written for the same statements
+ *
+ * Usage: log_decoder_exe <input .bin file> [output file]
+ * If the output file is not specified, the decoded log is written to stdout
+*/
+namespace Tool {
+    using namespace Collection::Log;
+
+    class LogDecoder {
+        private:
+            struct CallSite {
+                uint8_t level;
+                uint32_t line;
+                std::string file;
+                std::string function;
+            };
+
+            std::ifstream m_file;
+            uint32_t m_instanceId;
+            std::unordered_map <uint32_t, CallSite> m_callSites;
+            std::unordered_map <uint32_t, std::string> m_shapes;
+            std::unordered_map <uint32_t, std::string> m_strings;
+            uint64_t m_lastTimestamp;
+
+            template <typename T>
+            T read (void) {
+                T value;
+                if (!m_file.read (reinterpret_cast <char*> (&value), sizeof (T)))
+                    throw std::runtime_error ("Unexpected end of file");
+                return value;
+            }
+
+            uint64_t readVarint (void) {
+                uint64_t value = 0;
+                uint32_t shift = 0;
+                while (true) {
+                    uint8_t byte = read <uint8_t>();
+                    value       |= static_cast <uint64_t> (byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                        return value;
+
+                    shift += 7;
+                    if (shift >= 64)
+                        throw std::runtime_error ("Invalid varint");
+                }
+            }
+
+            /* Varint read from a shape string, advancing the read position
+            */
+            static uint64_t readVarint (const std::string& shape, size_t& pos) {
+                uint64_t value = 0;
+                uint32_t shift = 0;
+                while (pos < shape.size()) {
+                    uint8_t byte = static_cast <uint8_t> (shape[pos++]);
+                    value       |= static_cast <uint64_t> (byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                        return value;
+                    shift += 7;
+                }
+                throw std::runtime_error ("Invalid varint in shape");
+            }
+
+            std::string readString (void) {
+                uint64_t length = readVarint();
+                std::string value (length, '\0');
+                if (length != 0 && !m_file.read (value.data(), length))
+                    throw std::runtime_error ("Unexpected end of file");
+                return value;
+            }
+
+            /* Level values as defined by e_level in Record.h
+            */
+            const char* getLevelString (uint8_t level) {
+                switch (level) {
+                    case 1:         return "INFO";
+                    case 2:         return "WARN";
+                    case 4:         return "ERRO";
+                    default:        return "UNDF";
+                }
+            }
+
+            void writeHeader (std::ostream& ost, const CallSite& callSite, uint64_t timestamp) {
+                time_t second     = static_cast <time_t> (timestamp / 1000000000);
+                uint32_t milliSec = static_cast <uint32_t> ((timestamp / 1000000) % 1000);
+                struct tm localTime;
+                localtime_r (&second, &localTime);
+
+                char timestampString[32];
+                strftime (timestampString, sizeof (timestampString), "%F %T", &localTime);
+
+                ost << "[" << (m_instanceId < 10 ? "0": "") << m_instanceId << "]"
+                    << " "
+                    << timestampString << "." << std::setw (3) << std::setfill ('0') << milliSec
+                    << std::setfill (' ')
+                    << " "
+                    << "[" << getLevelString (callSite.level) << "]"
+                    << " "
+                    << callSite.function
+                    << " "
+                    << callSite.line
+                    << " ";
+            }
+
+            void decodeEntry (std::ostream& ost) {
+                uint32_t callSiteId = static_cast <uint32_t> (readVarint());
+                m_lastTimestamp    += static_cast <uint64_t> (BinaryFormat::decodeZigZag (readVarint()));
+
+                if (m_callSites.find (callSiteId) == m_callSites.end() || m_shapes.find (callSiteId) == m_shapes.end())
+                    throw std::runtime_error ("Entry refers to undefined call site");
+
+                auto const& shape = m_shapes[callSiteId];
+                if (shape.empty())
+                    throw std::runtime_error ("Invalid shape");
+                if (shape[0] != 0)
+                    writeHeader (ost, m_callSites[callSiteId], m_lastTimestamp);
+
+                size_t pos = 1;
+                while (pos < shape.size()) {
+                    auto argTag = static_cast <BinaryFormat::e_argTag> (shape[pos++]);
+                    switch (argTag) {
+                        case BinaryFormat::ARG_BOOL:        ost << (read <uint8_t>() != 0);                     break;
+                        case BinaryFormat::ARG_CHAR:        ost << read <char>();                               break;
+                        case BinaryFormat::ARG_INT64:       ost << BinaryFormat::decodeZigZag (readVarint());   break;
+                        case BinaryFormat::ARG_UINT64:      ost << readVarint();                                break;
+                        case BinaryFormat::ARG_FLOAT:       ost << read <float>();                              break;
+                        case BinaryFormat::ARG_DOUBLE:      ost << read <double>();                             break;
+                        case BinaryFormat::ARG_STRING:      ost << readString();                                break;
+                        case BinaryFormat::ARG_STRING_REF: {
+                            uint32_t stringId = static_cast <uint32_t> (readVarint (shape, pos));
+                            if (m_strings.find (stringId) == m_strings.end())
+                                throw std::runtime_error ("Entry refers to undefined string");
+                            ost << m_strings[stringId];
+                            break;
+                        }
+                        default:
+                            throw std::runtime_error ("Invalid arg tag");
+                    }
+                }
+                ost << "\n";
+            }
+
+        public:
+            LogDecoder (const char* filePath) {
+                m_file.open (filePath, std::ios_base::in | std::ios_base::binary);
+                if (!m_file.is_open())
+                    throw std::runtime_error ("Failed to open input file");
+
+                char magic[4];
+                if (!m_file.read (magic, sizeof (magic)) ||
+                    memcmp (magic, BinaryFormat::MAGIC, sizeof (magic)) != 0)
+                    throw std::runtime_error ("Input file is not a binary log");
+
+                if (read <uint32_t>() != BinaryFormat::VERSION)
+                    throw std::runtime_error ("Unsupported binary log version");
+                m_instanceId    = read <uint32_t>();
+                m_lastTimestamp = 0;
+            }
+
+            /* Returns the number of entries decoded
+            */
+            size_t decode (std::ostream& ost) {
+                size_t entryCount = 0;
+                uint8_t blockTag;
+                while (m_file.read (reinterpret_cast <char*> (&blockTag), sizeof (blockTag))) {
+                    switch (blockTag) {
+                        case BinaryFormat::BLOCK_CALL_SITE: {
+                            uint32_t callSiteId = static_cast <uint32_t> (readVarint());
+                            CallSite callSite;
+                            callSite.level      = read <uint8_t>();
+                            callSite.line       = static_cast <uint32_t> (readVarint());
+                            callSite.file       = readString();
+                            callSite.function   = readString();
+                            m_callSites[callSiteId] = callSite;
+                            break;
+                        }
+                        case BinaryFormat::BLOCK_STRING: {
+                            uint32_t stringId   = static_cast <uint32_t> (readVarint());
+                            m_strings[stringId] = readString();
+                            break;
+                        }
+                        case BinaryFormat::BLOCK_SHAPE: {
+                            uint32_t callSiteId  = static_cast <uint32_t> (readVarint());
+                            m_shapes[callSiteId] = readString();
+                            break;
+                        }
+                        case BinaryFormat::BLOCK_ENTRY:
+                            decodeEntry (ost);
+                            entryCount++;
+                            break;
+
+                        default:
+                            throw std::runtime_error ("Invalid block tag");
+                    }
+                }
+                return entryCount;
+            }
+    };
+}   // namespace Tool
+
+int main (int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <input .bin file> [output file]" << std::endl;
+        return 1;
+    }
+
+    try {
+        Tool::LogDecoder decoder (argv[1]);
+        size_t entryCount;
+        if (argc > 2) {
+            std::ofstream outputFile (argv[2]);
+            if (!outputFile.is_open())
+                throw std::runtime_error ("Failed to open output file");
+            entryCount = decoder.decode (outputFile);
+        }
+        else
+            entryCount = decoder.decode (std::cout);
+
+        std::cerr << "[OK] decoded " << entryCount << " entries" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file